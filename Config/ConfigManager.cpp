@@ -1,4 +1,5 @@
 #include "ConfigManager.h"
+#include "../Core/ThreadPlacement.h"
 
 namespace Config {
 
@@ -55,6 +56,27 @@ bool ConfigManager::loadConfig(const QString& filePath)
         m_synchronizationIntervalMs = Core::DEFAULT_SYNC_INTERVAL_MS;
     }
 
+    // 解析显示配置
+    if (rootObj.contains("display") && rootObj["display"].isObject()) {
+        m_displayConfig = parseDisplayConfig(rootObj["display"].toObject());
+    } else {
+        m_displayConfig = Core::DisplayConfig();
+    }
+
+    // 解析时间对齐配置
+    if (rootObj.contains("alignment") && rootObj["alignment"].isObject()) {
+        m_alignmentConfig = parseAlignmentConfig(rootObj["alignment"].toObject());
+    } else {
+        m_alignmentConfig = Core::AlignmentConfig();
+    }
+
+    // 解析线程配置
+    if (rootObj.contains("threading") && rootObj["threading"].isObject()) {
+        m_threadingConfig = parseThreadingConfig(rootObj["threading"].toObject());
+    } else {
+        m_threadingConfig = Core::ThreadingConfig();
+    }
+
     // 解析虚拟设备（目前只关注这部分）
     if (rootObj.contains("virtual_devices") && rootObj["virtual_devices"].isArray()) {
         parseVirtualDevices(rootObj["virtual_devices"].toArray());
@@ -150,6 +172,21 @@ int ConfigManager::getSynchronizationIntervalMs() const
     return m_synchronizationIntervalMs;
 }
 
+Core::DisplayConfig ConfigManager::getDisplayConfig() const
+{
+    return m_displayConfig;
+}
+
+Core::AlignmentConfig ConfigManager::getAlignmentConfig() const
+{
+    return m_alignmentConfig;
+}
+
+Core::ThreadingConfig ConfigManager::getThreadingConfig() const
+{
+    return m_threadingConfig;
+}
+
 QString ConfigManager::getConfigFilePath() const
 {
     return m_configFilePath;
@@ -163,6 +200,40 @@ bool ConfigManager::saveConfig(const QString& filePath) const
     // 添加同步间隔
     rootObj["synchronization_interval_ms"] = m_synchronizationIntervalMs;
 
+    // 添加显示配置
+    QJsonObject displayObj;
+    displayObj["plot_renderer"] = m_displayConfig.plotRenderer;
+    displayObj["opengl_samples"] = m_displayConfig.openGlSamples;
+    displayObj["software_opengl"] = m_displayConfig.softwareOpenGl;
+    displayObj["plot_time_window_s"] = m_displayConfig.plotTimeWindowSec;
+    rootObj["display"] = displayObj;
+
+    // 添加时间对齐配置
+    QJsonObject alignmentObj;
+    alignmentObj["enabled"] = m_alignmentConfig.enabled;
+    alignmentObj["method"] = m_alignmentConfig.method;
+    alignmentObj["output_interval_ms"] = m_alignmentConfig.outputIntervalMs;
+    alignmentObj["latency_ms"] = m_alignmentConfig.latencyMs;
+    alignmentObj["stale_ms"] = m_alignmentConfig.staleMs;
+    alignmentObj["history_size"] = m_alignmentConfig.historySize;
+    rootObj["alignment"] = alignmentObj;
+
+    // 添加线程配置
+    QJsonObject threadingObj;
+    threadingObj["gui"] = threadPlacementToJson(m_threadingConfig.gui);
+    threadingObj["processor"] = threadPlacementToJson(m_threadingConfig.processor);
+    threadingObj["devices"] = threadPlacementToJson(m_threadingConfig.devices);
+    threadingObj["daq_callback"] = threadPlacementToJson(m_threadingConfig.daqCallback);
+    QJsonArray deviceGroupsArray;
+    for (const auto& group : m_threadingConfig.deviceGroups) {
+        QJsonObject groupObj = threadPlacementToJson(group.placement);
+        groupObj["name"] = group.name;
+        groupObj["devices"] = QJsonArray::fromStringList(group.deviceIds);
+        deviceGroupsArray.append(groupObj);
+    }
+    threadingObj["device_groups"] = deviceGroupsArray;
+    rootObj["threading"] = threadingObj;
+
     // 添加虚拟设备
     QJsonArray virtualDevicesArray;
     for (const auto& device : m_virtualDeviceConfigs) {
@@ -171,6 +242,40 @@ bool ConfigManager::saveConfig(const QString& filePath) const
         deviceObj["signal_type"] = device.signalType;
         deviceObj["amplitude"] = device.amplitude;
         deviceObj["frequency"] = device.frequency;
+        deviceObj["sample_rate"] = device.sampleRate;
+        deviceObj["channels"] = device.channelCount;
+        deviceObj["block_interval_ms"] = device.blockIntervalMs;
+        deviceObj["noise"] = device.noise;
+
+        // 添加复合信号分量
+        if (!device.harmonics.isEmpty()) {
+            QJsonArray harmonicsArray;
+            for (const auto& harmonic : device.harmonics) {
+                QJsonObject harmonicObj;
+                harmonicObj["order"] = harmonic.order;
+                harmonicObj["amplitude"] = harmonic.amplitude;
+                harmonicObj["phase"] = harmonic.phase;
+                harmonicsArray.append(harmonicObj);
+            }
+            deviceObj["harmonics"] = harmonicsArray;
+        }
+        if (device.chirpEndFrequency > 0.0) {
+            QJsonObject chirpObj;
+            chirpObj["end_frequency"] = device.chirpEndFrequency;
+            chirpObj["period_s"] = device.chirpPeriodSec;
+            deviceObj["chirp"] = chirpObj;
+        }
+        if (!device.steps.isEmpty()) {
+            QJsonArray stepsArray;
+            for (const auto& step : device.steps) {
+                QJsonObject stepObj;
+                stepObj["time_s"] = step.timeSec;
+                stepObj["level"] = step.level;
+                stepsArray.append(stepObj);
+            }
+            deviceObj["steps"] = stepsArray;
+            deviceObj["step_period_s"] = device.stepPeriodSec;
+        }
 
         // 添加通道参数
         QJsonObject channelParamsObj;
@@ -257,6 +362,33 @@ void ConfigManager::parseVirtualDevices(const QJsonArray& jsonArray)
         config.channelParams = channelParams;
         config.displayFormat = displayFormat;
 
+        // 块生成参数
+        config.sampleRate = qBound(1.0, deviceObj["sample_rate"].toDouble(config.sampleRate), 100000.0);
+        config.channelCount = qMax(1, deviceObj["channels"].toInt(config.channelCount));
+        config.blockIntervalMs = qMax(1, deviceObj["block_interval_ms"].toInt(config.blockIntervalMs));
+        config.noise = qMax(0.0, deviceObj["noise"].toDouble(config.noise));
+
+        // 复合信号：谐波、扫频和阶跃事件
+        const QJsonArray harmonicsArray = deviceObj["harmonics"].toArray();
+        for (const QJsonValue& value : harmonicsArray) {
+            const QJsonObject harmonicObj = value.toObject();
+            config.harmonics.append(Core::VirtualHarmonicConfig(harmonicObj["order"].toInt(2),
+                                                                harmonicObj["amplitude"].toDouble(0.0),
+                                                                harmonicObj["phase"].toDouble(0.0)));
+        }
+        if (deviceObj["chirp"].isObject()) {
+            const QJsonObject chirpObj = deviceObj["chirp"].toObject();
+            config.chirpEndFrequency = chirpObj["end_frequency"].toDouble(0.0);
+            config.chirpPeriodSec = chirpObj["period_s"].toDouble(config.chirpPeriodSec);
+        }
+        const QJsonArray stepsArray = deviceObj["steps"].toArray();
+        for (const QJsonValue& value : stepsArray) {
+            const QJsonObject stepObj = value.toObject();
+            config.steps.append(Core::VirtualStepConfig(stepObj["time_s"].toDouble(0.0),
+                                                        stepObj["level"].toDouble(0.0)));
+        }
+        config.stepPeriodSec = qMax(0.0, deviceObj["step_period_s"].toDouble(0.0));
+
         // 添加到列表
         m_virtualDeviceConfigs.append(config);
 
@@ -266,20 +398,23 @@ void ConfigManager::parseVirtualDevices(const QJsonArray& jsonArray)
                  << "采集类型=" << displayFormat.acquisitionType
                  << "单位=" << displayFormat.unit;
 
-        // 创建对应的通道配置
-        Core::ChannelConfig channelConfig;
-        channelConfig.channelId = instanceName; // 使用实例名称作为通道ID
-        channelConfig.channelName = instanceName;
-        channelConfig.deviceId = instanceName;
-        channelConfig.hardwareChannel = "0"; // 虚拟设备只有一个通道
-        channelConfig.params = channelParams;
-        channelConfig.displayFormat = displayFormat;
-
-        // 添加到通道映射
-        m_channelConfigs[channelConfig.channelId] = channelConfig;
+        // 创建对应的通道配置：第0个通道使用实例名称作为通道ID，其余通道追加序号
+        for (int c = 0; c < config.channelCount; ++c) {
+            Core::ChannelConfig channelConfig;
+            channelConfig.channelId = c == 0 ? instanceName : QString("%1_%2").arg(instanceName).arg(c);
+            channelConfig.channelName = channelConfig.channelId;
+            channelConfig.deviceId = instanceName;
+            channelConfig.hardwareChannel = QString::number(c);
+            channelConfig.params = channelParams;
+            channelConfig.displayFormat = displayFormat;
+
+            // 添加到通道映射
+            m_channelConfigs[channelConfig.channelId] = channelConfig;
+        }
 
         qDebug() << "已加载虚拟设备:" << instanceName << "信号类型:" << signalType
-                 << "振幅:" << amplitude << "频率:" << frequency;
+                 << "振幅:" << amplitude << "频率:" << frequency
+                 << "采样率:" << config.sampleRate << "通道数:" << config.channelCount;
     }
 }
 
@@ -298,12 +433,25 @@ void ConfigManager::parseModbusDevices(const QJsonArray& jsonArray)
         QString instanceName = deviceObj["instance_name"].toString();
         int readCycleMs = deviceObj["read_cycle_ms"].toInt(1000);
 
+        // 传输方式，默认为串口RTU
+        QString transport = deviceObj["transport"].toString("rtu").toLower();
+
         // 解析串口配置
         Core::SerialConfig serialConfig;
         if (deviceObj.contains("serial_config") && deviceObj["serial_config"].isObject()) {
             serialConfig = parseSerialConfig(deviceObj["serial_config"].toObject());
         }
 
+        // 解析TCP配置
+        Core::TcpConfig tcpConfig;
+        if (deviceObj.contains("tcp_config") && deviceObj["tcp_config"].isObject()) {
+            QJsonObject tcpObj = deviceObj["tcp_config"].toObject();
+            tcpConfig.host = tcpObj["host"].toString("127.0.0.1");
+            tcpConfig.port = tcpObj["port"].toInt(502);
+            tcpConfig.connections = qMax(1, tcpObj["connections"].toInt(1));
+            tcpConfig.simulated = tcpObj["simulated"].toBool(false);
+        }
+
         // 解析从站配置
         QList<Core::ModbusSlaveConfig> slaves;
         if (deviceObj.contains("slaves") && deviceObj["slaves"].isArray()) {
@@ -337,6 +485,16 @@ void ConfigManager::parseModbusDevices(const QJsonArray& jsonArray)
                         // 提取寄存器字段
                         int registerAddress = regObj["register_address"].toInt();
                         QString channelName = regObj["channel_name"].toString();
+                        QString pollGroup = regObj["poll_group"].toString();
+                        QString dataType = regObj["data_type"].toString("uint16").toLower();
+                        QString byteOrder = regObj["byte_order"].toString("big").toLower();
+                        QString wordOrder = regObj["word_order"].toString("big").toLower();
+
+                        static const QStringList dataTypes = {"int16", "uint16", "int32", "uint32", "float32", "float64"};
+                        if (!dataTypes.contains(dataType)) {
+                            qDebug() << "不支持的Modbus数据类型:" << dataType << "通道:" << channelName << "，按uint16处理";
+                            dataType = "uint16";
+                        }
 
                         // 解析通道参数
                         Core::ChannelParams channelParams;
@@ -364,6 +522,10 @@ void ConfigManager::parseModbusDevices(const QJsonArray& jsonArray)
                         regConfig.channelName = channelName;
                         regConfig.channelParams = channelParams;
                         regConfig.displayFormat = displayFormat;
+                        regConfig.pollGroup = pollGroup;
+                        regConfig.dataType = dataType;
+                        regConfig.byteOrder = byteOrder;
+                        regConfig.wordOrder = wordOrder;
 
                         // 添加到寄存器列表
                         registers.append(regConfig);
@@ -407,18 +569,55 @@ void ConfigManager::parseModbusDevices(const QJsonArray& jsonArray)
             }
         }
 
+        // 解析轮询组
+        QList<Core::ModbusPollGroupConfig> pollGroups;
+        if (deviceObj.contains("poll_groups") && deviceObj["poll_groups"].isArray()) {
+            QJsonArray groupsArray = deviceObj["poll_groups"].toArray();
+
+            for (int j = 0; j < groupsArray.size(); ++j) {
+                if (!groupsArray[j].isObject()) {
+                    qDebug() << "跳过非对象轮询组条目";
+                    continue;
+                }
+
+                QJsonObject groupObj = groupsArray[j].toObject();
+                Core::ModbusPollGroupConfig group;
+                group.name = groupObj["name"].toString();
+                group.cycleMs = qMax(1, groupObj["cycle_ms"].toInt(readCycleMs));
+                group.priority = groupObj["priority"].toInt(0);
+
+                if (group.name.isEmpty()) {
+                    qDebug() << "跳过未命名的轮询组";
+                    continue;
+                }
+                pollGroups.append(group);
+
+                qDebug() << "已加载Modbus轮询组:" << group.name
+                         << "周期:" << group.cycleMs << "毫秒"
+                         << "优先级:" << group.priority;
+            }
+        }
+
         // 创建Modbus设备配置
         Core::ModbusDeviceConfig config;
         config.deviceId = instanceName;
         config.instanceName = instanceName;
+        config.transport = transport;
         config.serialConfig = serialConfig;
+        config.tcpConfig = tcpConfig;
         config.readCycleMs = readCycleMs;
         config.slaves = slaves;
+        config.pollGroups = pollGroups;
+        // TCP按事务号区分应答，每个连接可以同时有多个请求在途
+        config.maxInFlight = qMax(1, deviceObj["max_in_flight"].toInt(transport == "tcp" ? 4 : config.maxInFlight));
+        config.timeoutMs = qMax(10, deviceObj["timeout_ms"].toInt(config.timeoutMs));
+        config.retries = qMax(0, deviceObj["retries"].toInt(config.retries));
 
         // 添加到列表
         m_modbusDeviceConfigs.append(config);
 
         qDebug() << "已加载Modbus设备:" << instanceName
+                 << "传输方式:" << transport
                  << "串口:" << serialConfig.port
                  << "波特率:" << serialConfig.baudrate
                  << "从站数量:" << slaves.size();
@@ -687,6 +886,9 @@ void ConfigManager::parseECUDevices(const QJsonArray& jsonArray)
         config.serialConfig = serialConfig;
         config.readCycleMs = readCycleMs;
         config.channels = channels;
+        if (deviceObj.contains("protocol") && deviceObj["protocol"].isObject()) {
+            config.protocol = parseECUProtocol(deviceObj["protocol"].toObject());
+        }
 
         // 添加到列表
         m_ecuDeviceConfigs.append(config);
@@ -694,7 +896,9 @@ void ConfigManager::parseECUDevices(const QJsonArray& jsonArray)
         qDebug() << "已加载ECU设备:" << instanceName
                  << "串口:" << serialConfig.port
                  << "波特率:" << serialConfig.baudrate
-                 << "通道数量:" << channels.size();
+                 << "通道数量:" << channels.size()
+                 << "帧长度:" << config.protocol.frameSize
+                 << "字段数量:" << config.protocol.fields.size();
     }
 }
 
@@ -743,6 +947,12 @@ Core::SerialConfig ConfigManager::parseSerialConfig(const QJsonObject& jsonObjec
     config.stopbits = jsonObject["stopbits"].toInt(1);
     config.parity = jsonObject["parity"].toString("N");
 
+    // 模拟对端
+    config.simulated = jsonObject["simulated"].toBool(false);
+    config.simulatedFrameRate = jsonObject["simulated_frame_rate"].toDouble(100.0);
+    config.simulatedCorruptionRate = jsonObject["simulated_corruption_rate"].toDouble(0.0);
+    config.simulatedResponseDelayMs = jsonObject["simulated_response_delay_ms"].toInt(0);
+
     return config;
 }
 
@@ -770,6 +980,211 @@ Core::DisplayFormat ConfigManager::parseDisplayFormat(const QJsonObject& jsonObj
     return format;
 }
 
+Core::DisplayConfig ConfigManager::parseDisplayConfig(const QJsonObject& jsonObject)
+{
+    Core::DisplayConfig config;
+
+    config.plotRenderer = jsonObject["plot_renderer"].toString(config.plotRenderer).toLower();
+    if (config.plotRenderer != "raster" && config.plotRenderer != "opengl") {
+        qDebug() << "未知的曲线绘制后端:" << config.plotRenderer << "，使用raster";
+        config.plotRenderer = "raster";
+    }
+    config.openGlSamples = qMax(0, jsonObject["opengl_samples"].toInt(config.openGlSamples));
+    config.softwareOpenGl = jsonObject["software_opengl"].toBool(config.softwareOpenGl);
+    config.plotTimeWindowSec = jsonObject["plot_time_window_s"].toDouble(config.plotTimeWindowSec);
+    if (config.plotTimeWindowSec <= 0.0) {
+        config.plotTimeWindowSec = Core::DisplayConfig().plotTimeWindowSec;
+    }
+
+    qDebug() << "解析显示配置:"
+             << "绘制后端=" << config.plotRenderer
+             << "多重采样=" << config.openGlSamples
+             << "软件OpenGL=" << config.softwareOpenGl
+             << "时间窗口=" << config.plotTimeWindowSec << "秒";
+
+    return config;
+}
+
+Core::AlignmentConfig ConfigManager::parseAlignmentConfig(const QJsonObject& jsonObject)
+{
+    Core::AlignmentConfig config;
+
+    config.enabled = jsonObject["enabled"].toBool(config.enabled);
+    config.method = jsonObject["method"].toString(config.method).toLower();
+    if (config.method != "linear" && config.method != "previous" && config.method != "nearest") {
+        qDebug() << "未知的插值方式:" << config.method << "，使用linear";
+        config.method = "linear";
+    }
+    config.outputIntervalMs = qMax(0, jsonObject["output_interval_ms"].toInt(config.outputIntervalMs));
+    config.latencyMs = qMax(0, jsonObject["latency_ms"].toInt(config.latencyMs));
+    config.staleMs = qMax(1, jsonObject["stale_ms"].toInt(config.staleMs));
+    config.historySize = qMax(2, jsonObject["history_size"].toInt(config.historySize));
+
+    qDebug() << "解析时间对齐配置:"
+             << "启用=" << config.enabled
+             << "插值方式=" << config.method
+             << "输出间隔=" << config.outputIntervalMs << "毫秒"
+             << "延迟预算=" << config.latencyMs << "毫秒"
+             << "过期时间=" << config.staleMs << "毫秒"
+             << "历史长度=" << config.historySize;
+
+    return config;
+}
+
+Core::ThreadingConfig ConfigManager::parseThreadingConfig(const QJsonObject& jsonObject)
+{
+    Core::ThreadingConfig config;
+
+    config.gui = parseThreadPlacement(jsonObject["gui"].toObject());
+    config.processor = parseThreadPlacement(jsonObject["processor"].toObject());
+    config.devices = parseThreadPlacement(jsonObject["devices"].toObject());
+    config.daqCallback = parseThreadPlacement(jsonObject["daq_callback"].toObject());
+
+    // 设备组：同一设备只能属于一个组，重复出现时以第一个组为准
+    QStringList groupedDevices;
+    const QJsonArray groupsArray = jsonObject["device_groups"].toArray();
+    for (int i = 0; i < groupsArray.size(); ++i) {
+        const QJsonObject groupObj = groupsArray[i].toObject();
+
+        Core::DeviceThreadGroupConfig group;
+        group.name = groupObj["name"].toString(QString("device_group_%1").arg(i));
+        group.placement = parseThreadPlacement(groupObj);
+        for (const QJsonValue& value : groupObj["devices"].toArray()) {
+            const QString deviceId = value.toString();
+            if (deviceId.isEmpty()) {
+                continue;
+            }
+            if (groupedDevices.contains(deviceId)) {
+                qDebug() << "设备" << deviceId << "已属于其他线程组，忽略组" << group.name << "中的重复项";
+                continue;
+            }
+            groupedDevices.append(deviceId);
+            group.deviceIds.append(deviceId);
+        }
+
+        if (group.deviceIds.isEmpty()) {
+            qDebug() << "线程组" << group.name << "没有设备，已忽略";
+            continue;
+        }
+        config.deviceGroups.append(group);
+    }
+
+    qDebug() << "解析线程配置:"
+             << "GUI CPU=" << config.gui.cpus << "优先级=" << config.gui.priority
+             << "处理器 CPU=" << config.processor.cpus << "优先级=" << config.processor.priority
+             << "设备 CPU=" << config.devices.cpus << "优先级=" << config.devices.priority
+             << "DAQ回调 CPU=" << config.daqCallback.cpus << "优先级=" << config.daqCallback.priority
+             << "设备组数=" << config.deviceGroups.size();
+
+    return config;
+}
+
+Core::ThreadPlacementConfig ConfigManager::parseThreadPlacement(const QJsonObject& jsonObject)
+{
+    Core::ThreadPlacementConfig placement;
+
+    for (const QJsonValue& value : jsonObject["cpus"].toArray()) {
+        const int cpu = value.toInt(-1);
+        if (cpu >= 0 && !placement.cpus.contains(cpu)) {
+            placement.cpus.append(cpu);
+        }
+    }
+
+    placement.priority = jsonObject["priority"].toString(placement.priority).toLower();
+    if (!Core::ThreadPlacement::priorityNames().contains(placement.priority)) {
+        qDebug() << "未知的线程优先级:" << placement.priority << "，使用inherit";
+        placement.priority = "inherit";
+    }
+    placement.realtimePriority = qBound(1, jsonObject["realtime_priority"].toInt(placement.realtimePriority), 99);
+
+    return placement;
+}
+
+QJsonObject ConfigManager::threadPlacementToJson(const Core::ThreadPlacementConfig& placement) const
+{
+    QJsonObject placementObj;
+    QJsonArray cpusArray;
+    for (int cpu : placement.cpus) {
+        cpusArray.append(cpu);
+    }
+    placementObj["cpus"] = cpusArray;
+    placementObj["priority"] = placement.priority;
+    placementObj["realtime_priority"] = placement.realtimePriority;
+    return placementObj;
+}
+
+Core::ECUProtocolConfig ConfigManager::parseECUProtocol(const QJsonObject& jsonObject)
+{
+    Core::ECUProtocolConfig protocol = Core::ECUProtocolConfig::defaultProtocol();
+
+    protocol.frameSize = jsonObject["frame_size"].toInt(protocol.frameSize);
+    if (jsonObject.contains("header")) {
+        protocol.header = QByteArray::fromHex(jsonObject["header"].toString().toLatin1());
+    }
+    if (jsonObject.contains("footer")) {
+        protocol.footer = QByteArray::fromHex(jsonObject["footer"].toString().toLatin1());
+    }
+
+    if (jsonObject.contains("checksum") && jsonObject["checksum"].isObject()) {
+        QJsonObject checksumObj = jsonObject["checksum"].toObject();
+        protocol.checksumOffset = checksumObj["offset"].toInt(protocol.checksumOffset);
+        protocol.checksumStart = checksumObj["start"].toInt(protocol.checksumStart);
+        protocol.checksumEnd = checksumObj["end"].toInt(protocol.checksumEnd);
+    } else if (jsonObject.contains("checksum") && jsonObject["checksum"].isNull()) {
+        protocol.checksumOffset = -1;
+    }
+
+    if (jsonObject.contains("fields") && jsonObject["fields"].isArray()) {
+        protocol.fields.clear();
+        QJsonArray fieldsArray = jsonObject["fields"].toArray();
+
+        for (int i = 0; i < fieldsArray.size(); ++i) {
+            if (!fieldsArray[i].isObject()) {
+                qDebug() << "跳过非对象ECU字段条目";
+                continue;
+            }
+
+            QJsonObject fieldObj = fieldsArray[i].toObject();
+
+            Core::ECUFieldConfig field;
+            field.name = fieldObj["name"].toString();
+            field.byteOffset = fieldObj["byte_offset"].toInt();
+            field.width = fieldObj["width"].toInt(1);
+            field.isSigned = fieldObj["signed"].toBool(false);
+            field.byteOrder = fieldObj["byte_order"].toString("little").toLower();
+            field.scale = fieldObj["scale"].toDouble(1.0);
+            field.offset = fieldObj["offset"].toDouble(0.0);
+
+            if (field.name.isEmpty() || (field.width != 1 && field.width != 2 && field.width != 4)
+                || field.byteOffset < 0 || field.byteOffset + field.width > protocol.frameSize) {
+                qDebug() << "跳过无效的ECU字段:" << field.name
+                         << "偏移:" << field.byteOffset << "宽度:" << field.width;
+                continue;
+            }
+
+            protocol.fields.append(field);
+        }
+    }
+
+    // 帧头、帧尾和校验和必须落在帧内
+    if (protocol.header.size() + protocol.footer.size() > protocol.frameSize
+        || protocol.checksumOffset >= protocol.frameSize
+        || (protocol.checksumOffset >= 0 && (protocol.checksumStart < 0 || protocol.checksumEnd >= protocol.frameSize
+                                             || protocol.checksumStart > protocol.checksumEnd))) {
+        qDebug() << "ECU帧协议无效，使用默认协议";
+        return Core::ECUProtocolConfig::defaultProtocol();
+    }
+
+    qDebug() << "解析ECU帧协议:"
+             << "帧长度=" << protocol.frameSize
+             << "帧头=" << protocol.header.toHex(' ')
+             << "帧尾=" << protocol.footer.toHex(' ')
+             << "校验和偏移=" << protocol.checksumOffset
+             << "字段数量=" << protocol.fields.size();
+
+    return protocol;
+}
+
 void ConfigManager::parseSecondaryInstruments(const QJsonArray& jsonArray)
 {
     // 清空之前的配置
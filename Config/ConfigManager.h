@@ -86,6 +86,24 @@ public:
      */
     int getSynchronizationIntervalMs() const;
 
+    /**
+     * @brief 获取显示配置
+     * @return 显示配置
+     */
+    Core::DisplayConfig getDisplayConfig() const;
+
+    /**
+     * @brief 获取时间对齐配置
+     * @return 时间对齐配置
+     */
+    Core::AlignmentConfig getAlignmentConfig() const;
+
+    /**
+     * @brief 获取线程配置
+     * @return 线程配置
+     */
+    Core::ThreadingConfig getThreadingConfig() const;
+
     /**
      * @brief 获取配置文件路径
      * @return 配置文件路径
@@ -158,6 +176,48 @@ private:
      */
     Core::DisplayFormat parseDisplayFormat(const QJsonObject& jsonObject);
 
+    /**
+     * @brief 解析显示配置
+     * @param jsonObject JSON对象
+     * @return 显示配置
+     */
+    Core::DisplayConfig parseDisplayConfig(const QJsonObject& jsonObject);
+
+    /**
+     * @brief 解析时间对齐配置
+     * @param jsonObject JSON对象
+     * @return 时间对齐配置
+     */
+    Core::AlignmentConfig parseAlignmentConfig(const QJsonObject& jsonObject);
+
+    /**
+     * @brief 解析线程配置
+     * @param jsonObject JSON对象
+     * @return 线程配置
+     */
+    Core::ThreadingConfig parseThreadingConfig(const QJsonObject& jsonObject);
+
+    /**
+     * @brief 解析线程放置策略
+     * @param jsonObject JSON对象
+     * @return 放置策略
+     */
+    Core::ThreadPlacementConfig parseThreadPlacement(const QJsonObject& jsonObject);
+
+    /**
+     * @brief 线程放置策略转换为JSON
+     * @param placement 放置策略
+     * @return JSON对象
+     */
+    QJsonObject threadPlacementToJson(const Core::ThreadPlacementConfig& placement) const;
+
+    /**
+     * @brief 解析ECU帧协议
+     * @param jsonObject JSON对象
+     * @return 帧协议（未给出的字段使用默认协议的值）
+     */
+    Core::ECUProtocolConfig parseECUProtocol(const QJsonObject& jsonObject);
+
 private:
     QString m_configFilePath;                                // 配置文件路径
     QList<Core::VirtualDeviceConfig> m_virtualDeviceConfigs; // 虚拟设备配置列表
@@ -167,6 +227,9 @@ private:
     QList<Core::SecondaryInstrumentConfig> m_secondaryInstrumentConfigs; // 二次计算仪器配置列表
     QMap<QString, Core::ChannelConfig> m_channelConfigs;     // 通道配置映射
     int m_synchronizationIntervalMs;                         // 数据同步间隔（毫秒）
+    Core::DisplayConfig m_displayConfig;                     // 显示配置
+    Core::AlignmentConfig m_alignmentConfig;                 // 时间对齐配置
+    Core::ThreadingConfig m_threadingConfig;                 // 线程配置
 };
 
 } // namespace Config
@@ -31,7 +31,8 @@ enum class StatusCode {
     CONNECTING,         // 正在连接
     CONNECTED,          // 已连接
     ACQUIRING,          // 正在采集
-    STOPPED             // 已停止
+    STOPPED,            // 已停止
+    STALE               // 数据过期（数据源长时间未更新）
 };
 
 /**
@@ -80,6 +81,7 @@ inline QString statusCodeToString(StatusCode status) {
         case StatusCode::CONNECTED: return "Connected";
         case StatusCode::ACQUIRING: return "Acquiring";
         case StatusCode::STOPPED: return "Stopped";
+        case StatusCode::STALE: return "Stale";
         default: return "Unknown";
     }
 }
@@ -4,9 +4,13 @@
 #include <QString>
 #include <QMap>
 #include <QList>
+#include <QVector>
+#include <QStringList>
 #include <QVariant>
+#include <QByteArray>
 #include <QDateTime>
 #include "Constants.h"
+#include "Timebase.h"
 
 namespace Core {
 
@@ -108,18 +112,58 @@ struct DeviceConfig {
     virtual ~DeviceConfig() = default;
 };
 
+/**
+ * @brief 虚拟设备谐波分量
+ * 叠加在基波上的正弦谐波：amplitude * sin(order * 基波相位 + phase)
+ */
+struct VirtualHarmonicConfig {
+    int order = 2;          // 谐波次数
+    double amplitude = 0.0; // 振幅
+    double phase = 0.0;     // 初相位（弧度）
+
+    VirtualHarmonicConfig() = default;
+
+    VirtualHarmonicConfig(int o, double amp, double ph)
+        : order(o), amplitude(amp), phase(ph) {}
+};
+
+/**
+ * @brief 虚拟设备阶跃事件
+ * 从timeSec时刻起信号叠加level
+ */
+struct VirtualStepConfig {
+    double timeSec = 0.0;   // 发生时刻（秒，相对开始采集）
+    double level = 0.0;     // 阶跃幅度
+
+    VirtualStepConfig() = default;
+
+    VirtualStepConfig(double t, double l)
+        : timeSec(t), level(l) {}
+};
+
 /**
  * @brief 虚拟设备配置
  * 用于配置虚拟设备的参数
  */
 struct VirtualDeviceConfig : public DeviceConfig {
     QString instanceName;   // 实例名称
-    QString signalType;     // 信号类型：sine, square, triangle, random
+    QString signalType;     // 信号类型：sine, square, triangle, sawtooth, random
     double amplitude;       // 振幅
     double frequency;       // 频率 (Hz)
     ChannelParams channelParams; // 通道参数
     DisplayFormat displayFormat; // 显示格式
 
+    // 块生成：按采样率成块产生多通道数据，用作流水线的负载源
+    double sampleRate = 100.0;              // 每通道采样率 (Hz)
+    int channelCount = 1;                   // 通道数（硬件通道"0".."N-1"，通道间错开相位）
+    int blockIntervalMs = 10;               // 块间隔（毫秒）
+    double noise = 0.0;                     // 高斯噪声标准差
+    QList<VirtualHarmonicConfig> harmonics; // 谐波分量
+    double chirpEndFrequency = 0.0;         // 扫频终止频率（大于0时基波在chirpPeriodSec内从frequency线性扫到该频率）
+    double chirpPeriodSec = 10.0;           // 扫频周期（秒）
+    QList<VirtualStepConfig> steps;         // 阶跃事件
+    double stepPeriodSec = 0.0;             // 阶跃事件重复周期（秒，0表示只发生一次）
+
     VirtualDeviceConfig() {
         deviceType = DeviceType::VIRTUAL;
     }
@@ -148,9 +192,26 @@ struct ModbusRegisterConfig {
     QString channelName;     // 通道名称
     ChannelParams channelParams; // 通道参数
     DisplayFormat displayFormat; // 显示格式
+    QString pollGroup;       // 轮询组名称（为空时属于默认组）
+    QString dataType = "uint16"; // 数据类型：int16/uint16/int32/uint32/float32/float64
+    QString byteOrder = "big";   // 寄存器内字节序：big（高字节在前）/little
+    QString wordOrder = "big";   // 多寄存器字序：big（高位字在低地址）/little
 
     ModbusRegisterConfig() = default;
 
+    /**
+     * @brief 数据类型占用的寄存器数量
+     */
+    int registerCount() const {
+        if (dataType == "int32" || dataType == "uint32" || dataType == "float32") {
+            return 2;
+        }
+        if (dataType == "float64") {
+            return 4;
+        }
+        return 1;
+    }
+
     ModbusRegisterConfig(int addr, const QString& name, const ChannelParams& params)
         : registerAddress(addr), channelName(name), channelParams(params) {}
 
@@ -158,6 +219,21 @@ struct ModbusRegisterConfig {
         : registerAddress(addr), channelName(name), channelParams(params), displayFormat(df) {}
 };
 
+/**
+ * @brief Modbus轮询组配置
+ * 同一组的寄存器按相同周期读取，总线饱和时优先降低低优先级组的频率
+ */
+struct ModbusPollGroupConfig {
+    QString name;           // 组名称
+    int cycleMs = 1000;     // 轮询周期（毫秒）
+    int priority = 0;       // 优先级（越大越重要）
+
+    ModbusPollGroupConfig() = default;
+
+    ModbusPollGroupConfig(const QString& n, int cycle, int prio)
+        : name(n), cycleMs(cycle), priority(prio) {}
+};
+
 /**
  * @brief Modbus从站配置
  * 配置Modbus设备的从站
@@ -184,10 +260,44 @@ struct SerialConfig {
     int stopbits;       // 停止位
     QString parity;     // 校验位
 
+    // 进程内模拟对端（Linux/Unix伪终端），用于没有硬件时调试和基准测试
+    bool simulated = false;                // 是否连接模拟对端（ECU帧发生器或Modbus RTU从站）
+    double simulatedFrameRate = 100.0;     // ECU模拟：每秒帧数
+    double simulatedCorruptionRate = 0.0;  // ECU模拟：损坏帧比例（0~1）
+    int simulatedResponseDelayMs = 0;      // Modbus RTU模拟：从站应答延迟（毫秒）
+
     SerialConfig() = default;
 
     SerialConfig(const QString& p, int baud, int data, int stop, const QString& par)
         : port(p), baudrate(baud), databits(data), stopbits(stop), parity(par) {}
+
+    /**
+     * @brief 传输一个字符的时间（起始位+数据位+校验位+停止位）
+     * @return 时间（微秒）
+     */
+    double characterTimeUs() const {
+        int baud = baudrate > 0 ? baudrate : 9600;
+        int dataBits = databits > 0 ? databits : 8;
+        int parityBits = (parity.isEmpty() || parity == "N") ? 0 : 1;
+        double stopBits = stopbits == 2 ? 2.0 : (stopbits == 3 ? 1.5 : 1.0);
+        return (1.0 + dataBits + parityBits + stopBits) * 1e6 / baud;
+    }
+};
+
+/**
+ * @brief Modbus TCP配置
+ * 配置Modbus TCP服务器地址和并发连接
+ */
+struct TcpConfig {
+    QString host;            // 服务器地址
+    int port = 502;          // 端口
+    int connections = 1;     // 并发连接数
+    bool simulated = false;  // 是否连接进程内的模拟服务器
+
+    TcpConfig() = default;
+
+    TcpConfig(const QString& h, int p, int conn)
+        : host(h), port(p), connections(conn) {}
 };
 
 /**
@@ -196,9 +306,15 @@ struct SerialConfig {
  */
 struct ModbusDeviceConfig : public DeviceConfig {
     QString instanceName;                // 实例名称
-    SerialConfig serialConfig;           // 串口配置
-    int readCycleMs;                     // 读取周期（毫秒）
+    QString transport = "rtu";           // 传输方式："rtu"（串口）或 "tcp"
+    SerialConfig serialConfig;           // 串口配置（rtu）
+    TcpConfig tcpConfig;                 // TCP配置（tcp）
+    int readCycleMs;                     // 读取周期（毫秒），也是默认轮询组的周期
     QList<ModbusSlaveConfig> slaves;     // 从站列表
+    QList<ModbusPollGroupConfig> pollGroups; // 轮询组列表（未配置时所有寄存器属于默认组）
+    int maxInFlight = 1;                 // 同时在途的最大请求数（tcp为每个连接）
+    int timeoutMs = 200;                 // 单次请求超时（毫秒）
+    int retries = 1;                     // 超时重试次数
 
     ModbusDeviceConfig() {
         deviceType = DeviceType::MODBUS;
@@ -266,6 +382,58 @@ struct ECUChannelConfig {
         : channelName(name), channelParams(params), displayFormat(df) {}
 };
 
+/**
+ * @brief ECU帧字段配置
+ * 描述帧中一个字段的位置和换算：值 = 原始值 * scale + offset
+ */
+struct ECUFieldConfig {
+    QString name;                // 字段名（对应通道的hardware_channel）
+    int byteOffset = 0;          // 帧内字节偏移
+    int width = 1;               // 字节宽度：1/2/4
+    bool isSigned = false;       // 是否有符号
+    QString byteOrder = "little"; // 字节序：little/big
+    double scale = 1.0;          // 比例
+    double offset = 0.0;         // 偏移
+
+    ECUFieldConfig() = default;
+
+    ECUFieldConfig(const QString& fieldName, int byteOff, int w, bool sign, double s, double o)
+        : name(fieldName), byteOffset(byteOff), width(w), isSigned(sign), scale(s), offset(o) {}
+};
+
+/**
+ * @brief ECU协议配置
+ * 帧长度、帧头、帧尾、校验和与字段布局，启动时编译为解码表
+ */
+struct ECUProtocolConfig {
+    int frameSize = 17;                          // 帧长度（字节）
+    QByteArray header = QByteArray("\x7F\x7F", 2); // 帧头
+    QByteArray footer = QByteArray("\x0D\x0A", 2); // 帧尾
+    int checksumOffset = 14;                     // 校验和字节偏移（小于0表示不校验）
+    int checksumStart = 0;                       // 累加和起始字节
+    int checksumEnd = 13;                        // 累加和结束字节（含）
+    QList<ECUFieldConfig> fields;                // 字段列表
+
+    /**
+     * @brief 默认协议（原有的17字节帧布局）
+     */
+    static ECUProtocolConfig defaultProtocol() {
+        ECUProtocolConfig protocol;
+        protocol.fields = {
+            ECUFieldConfig("speed", 2, 2, false, 1.0, 0.0),
+            ECUFieldConfig("throttle_position", 4, 2, false, 0.1, 0.0),
+            ECUFieldConfig("cylinder_temp", 6, 1, true, 1.0, -40.0),
+            ECUFieldConfig("exhaust_temp", 7, 1, false, 5.0, -40.0),
+            ECUFieldConfig("fuel_pressure", 8, 2, false, 1.0, 0.0),
+            ECUFieldConfig("rotor_temp", 10, 1, true, 1.0, -40.0),
+            ECUFieldConfig("intake_temp", 11, 1, true, 1.0, -40.0),
+            ECUFieldConfig("intake_pressure", 12, 1, false, 1.0, 0.0),
+            ECUFieldConfig("supply_voltage", 13, 1, false, 0.1, 0.0)
+        };
+        return protocol;
+    }
+};
+
 /**
  * @brief ECU设备配置
  * 用于配置ECU设备
@@ -275,6 +443,7 @@ struct ECUDeviceConfig : public DeviceConfig {
     SerialConfig serialConfig;                   // 串口配置
     int readCycleMs;                             // 读取周期（毫秒）
     QMap<QString, ECUChannelConfig> channels;    // 通道映射
+    ECUProtocolConfig protocol = ECUProtocolConfig::defaultProtocol(); // 帧协议
 
     ECUDeviceConfig() {
         deviceType = DeviceType::ECU;
@@ -323,7 +492,7 @@ struct ChannelConfig {
  */
 struct RawDataPoint {
     double value;            // 原始值
-    qint64 timestamp;        // 时间戳（毫秒）
+    qint64 timestamp;        // 时间戳（Timebase纳秒）
     QString deviceId;        // 设备ID
     QString hardwareChannel; // 硬件通道标识
 
@@ -333,13 +502,34 @@ struct RawDataPoint {
         : value(val), timestamp(ts), deviceId(devId), hardwareChannel(hwChan) {}
 };
 
+/**
+ * @brief 原始样本块
+ * 设备一次产生的多通道等间隔样本，按扫描交错存储：第i次扫描第c个通道为values[i * 通道数 + c]
+ */
+struct RawSampleBlock {
+    QStringList hardwareChannels;  // 硬件通道标识（按列顺序）
+    QVector<double> values;        // 样本值（按扫描交错）
+    qint64 firstTimestamp = 0;     // 第一次扫描的时间戳（Timebase纳秒）
+    double intervalNs = 0.0;       // 扫描间隔（纳秒）
+
+    int channelCount() const { return hardwareChannels.size(); }
+
+    int scanCount() const {
+        return hardwareChannels.isEmpty() ? 0 : values.size() / hardwareChannels.size();
+    }
+
+    qint64 timestampAt(int scan) const {
+        return firstTimestamp + static_cast<qint64>(scan * intervalNs);
+    }
+};
+
 /**
  * @brief 处理后的数据点
  * 经过处理的数据点
  */
 struct ProcessedDataPoint {
     double value;            // 处理后的值
-    qint64 timestamp;        // 时间戳（毫秒）
+    qint64 timestamp;        // 时间戳（Timebase纳秒）
     QString channelId;       // 通道ID
     StatusCode status;       // 状态码
     QString unit;            // 单位
@@ -375,13 +565,76 @@ struct SecondaryInstrumentConfig {
           displayFormat(df) {}
 };
 
+/**
+ * @brief 显示配置
+ * 用于配置主曲线图的绘制方式
+ */
+struct DisplayConfig {
+    QString plotRenderer = "raster";    // 曲线绘制后端："raster"（软件光栅）或 "opengl"
+    int openGlSamples = 4;              // OpenGL多重采样数
+    bool softwareOpenGl = false;        // 使用软件OpenGL光栅器（无GPU/无头环境）
+    double plotTimeWindowSec = 60.0;    // 曲线时间窗口（秒）
+
+    bool useOpenGl() const { return plotRenderer.compare("opengl", Qt::CaseInsensitive) == 0; }
+};
+
+/**
+ * @brief 时间对齐配置
+ * 各设备采样率不同，处理器按固定输出网格对每个通道的历史数据插值，生成时间对齐的同步帧
+ */
+struct AlignmentConfig {
+    bool enabled = true;                // 是否启用时间对齐（关闭时退回取最新值）
+    QString method = "linear";          // 插值方式："linear"（线性）、"previous"（前值保持）、"nearest"（最近点）
+    int outputIntervalMs = 0;           // 输出网格间隔（毫秒，0表示与同步间隔相同）
+    int latencyMs = 200;                // 延迟预算：只输出早于当前时间该值的网格点，等待慢速设备的数据到达
+    int staleMs = 2000;                 // 数据源超过该时间未更新时通道标记为过期
+    int historySize = 4096;             // 每个通道保留的历史样本数
+};
+
+/**
+ * @brief 线程放置策略
+ * 线程绑定的CPU核和优先级；默认值不改变线程（继承进程的设置）
+ */
+struct ThreadPlacementConfig {
+    QList<int> cpus;                    // 绑定的CPU核编号（空表示不绑定）
+    QString priority = "inherit";       // 优先级："inherit"、"low"、"normal"、"high"、"highest"、"time_critical"、"realtime"
+    int realtimePriority = 50;          // priority为realtime时的SCHED_FIFO优先级（1-99，仅Linux）
+
+    bool isDefault() const { return cpus.isEmpty() && priority == "inherit"; }
+};
+
+/**
+ * @brief 共用线程的设备组
+ * 组内设备移动到同一个事件循环线程，适合低速率的Modbus/ECU设备
+ */
+struct DeviceThreadGroupConfig {
+    QString name;                       // 组名（同时作为线程名）
+    QStringList deviceIds;              // 组内设备ID
+    ThreadPlacementConfig placement;    // 该线程的放置策略
+};
+
+/**
+ * @brief 线程配置
+ * 各类线程的CPU绑定和优先级，以及设备线程的分组
+ */
+struct ThreadingConfig {
+    ThreadPlacementConfig gui;          // GUI主线程
+    ThreadPlacementConfig processor;    // 数据处理器线程（同步、时间对齐和数据存储都在该线程执行）
+    ThreadPlacementConfig devices;      // 未分组设备各自的线程
+    ThreadPlacementConfig daqCallback;  // Art_DAQ驱动回调线程（EveryN回调中读取和处理数据）
+    QList<DeviceThreadGroupConfig> deviceGroups; // 共用线程的设备组
+};
+
 /**
  * @brief 同步数据帧
  * 包含特定时间点的所有通道数据
  */
 struct SynchronizedDataFrame {
-    qint64 timestamp;                                    // 时间戳（毫秒）
+    qint64 timestamp = 0;                                // 时间戳（Timebase纳秒）
+    quint64 sequence = 0;                                // 帧序号（从1开始递增，0表示无效帧）
     QMap<QString, ProcessedDataPoint> channelData;       // 通道数据映射
+    QMap<QString, qint64> acquisitionTimestamps;         // 设备ID -> 帧中该设备最新数据的采集时间戳（Timebase纳秒）
+    qint64 builtTimestamp = 0;                           // 帧生成完成的时间（Timebase纳秒）
 
     SynchronizedDataFrame() = default;
 
@@ -397,6 +650,20 @@ struct SynchronizedDataFrame {
         channelData[channelId] = dataPoint;
     }
 
+    /**
+     * @brief 记录帧中某设备数据的采集时间戳（保留最新的）
+     * @param deviceId 设备ID
+     * @param acquisitionTimestamp 采集时间戳（Timebase纳秒）
+     */
+    void noteAcquisition(const QString& deviceId, qint64 acquisitionTimestamp) {
+        auto it = acquisitionTimestamps.find(deviceId);
+        if (it == acquisitionTimestamps.end()) {
+            acquisitionTimestamps.insert(deviceId, acquisitionTimestamp);
+        } else if (acquisitionTimestamp > it.value()) {
+            it.value() = acquisitionTimestamp;
+        }
+    }
+
     /**
      * @brief 获取通道数据
      * @param channelId 通道ID
@@ -426,7 +693,7 @@ struct SynchronizedDataFrame {
      * @return 格式化的时间戳
      */
     QString getFormattedTimestamp(const QString& format = "yyyy-MM-dd hh:mm:ss.zzz") const {
-        return QDateTime::fromMSecsSinceEpoch(timestamp).toString(format);
+        return Timebase::toDateTime(timestamp).toString(format);
     }
 };
 
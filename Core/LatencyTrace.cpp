@@ -0,0 +1,246 @@
+#include "LatencyTrace.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <QFile>
+#include <QDebug>
+#include <atomic>
+
+namespace Core {
+
+namespace {
+
+struct TraceEvent {
+    qint64 startNs;        // 采集时间戳
+    qint64 endNs;          // 完成时刻
+    int device;            // 设备序号
+    int path;              // 路径
+};
+
+struct DeviceState {
+    QString deviceId;
+    QVector<quint64> buckets[LatencyTrace::PATH_COUNT];
+    quint64 counts[LatencyTrace::PATH_COUNT] = {};
+    quint64 sums[LatencyTrace::PATH_COUNT] = {};
+};
+
+QMutex s_mutex;
+QHash<QString, int> s_deviceIndex;        // 设备ID -> 序号
+QVector<DeviceState> s_devices;
+QVector<TraceEvent> s_events;
+int s_maxEvents = LatencyTrace::DEFAULT_MAX_TRACE_EVENTS;
+quint64 s_droppedEvents = 0;
+std::atomic<bool> s_tracing(false);
+
+// 调用方持有s_mutex
+int deviceIndexLocked(const QString& deviceId)
+{
+    auto it = s_deviceIndex.constFind(deviceId);
+    if (it != s_deviceIndex.constEnd()) {
+        return it.value();
+    }
+
+    DeviceState state;
+    state.deviceId = deviceId;
+    for (int path = 0; path < LatencyTrace::PATH_COUNT; ++path) {
+        state.buckets[path].fill(0, Metrics::BUCKET_COUNT);
+    }
+    s_devices.append(state);
+    s_deviceIndex.insert(deviceId, s_devices.size() - 1);
+    return s_devices.size() - 1;
+}
+
+// 调用方持有s_mutex
+void recordLocked(int path, const QString& deviceId, qint64 acquisitionNs, qint64 completedNs)
+{
+    const int device = deviceIndexLocked(deviceId);
+    DeviceState& state = s_devices[device];
+    const qint64 latencyNs = completedNs - acquisitionNs;
+    const quint64 value = latencyNs > 0 ? static_cast<quint64>(latencyNs) : 0;
+
+    ++state.buckets[path][Metrics::bucketIndex(value)];
+    ++state.counts[path];
+    state.sums[path] += value;
+
+    if (s_tracing.load(std::memory_order_relaxed)) {
+        if (s_events.size() < s_maxEvents) {
+            s_events.append(TraceEvent{acquisitionNs, completedNs, device, path});
+        } else {
+            ++s_droppedEvents;
+        }
+    }
+}
+
+Metrics::Stage metricsStage(int path)
+{
+    switch (path) {
+        case LatencyTrace::AcquisitionToFrame: return Metrics::AcquisitionToFrame;
+        case LatencyTrace::AcquisitionToDisk: return Metrics::AcquisitionToDisk;
+        case LatencyTrace::AcquisitionToScreen: return Metrics::AcquisitionToScreen;
+        default: return Metrics::Ingest;
+    }
+}
+
+} // namespace
+
+void LatencyTrace::record(Path path, const QString& deviceId, qint64 acquisitionNs, qint64 completedNs)
+{
+    if (!Metrics::isEnabled()) {
+        return;
+    }
+
+    // 采集到处理器的延迟已由调用方计入Metrics::Ingest
+    if (path != AcquisitionToIngest) {
+        Metrics::recordLatency(metricsStage(path), completedNs - acquisitionNs);
+    }
+
+    QMutexLocker locker(&s_mutex);
+    recordLocked(path, deviceId, acquisitionNs, completedNs);
+}
+
+void LatencyTrace::recordFrame(Path path, const SynchronizedDataFrame& frame, qint64 completedNs)
+{
+    if (!Metrics::isEnabled() || frame.acquisitionTimestamps.isEmpty()) {
+        return;
+    }
+
+    for (auto it = frame.acquisitionTimestamps.constBegin(); it != frame.acquisitionTimestamps.constEnd(); ++it) {
+        Metrics::recordLatency(metricsStage(path), completedNs - it.value());
+    }
+
+    QMutexLocker locker(&s_mutex);
+    for (auto it = frame.acquisitionTimestamps.constBegin(); it != frame.acquisitionTimestamps.constEnd(); ++it) {
+        recordLocked(path, it.key(), it.value(), completedNs);
+    }
+}
+
+QVector<LatencyTrace::DeviceLatency> LatencyTrace::snapshot()
+{
+    QMutexLocker locker(&s_mutex);
+
+    QVector<DeviceLatency> result;
+    result.reserve(s_devices.size());
+    for (const DeviceState& state : s_devices) {
+        DeviceLatency latency;
+        latency.deviceId = state.deviceId;
+        for (int path = 0; path < PATH_COUNT; ++path) {
+            latency.paths[path].buckets = state.buckets[path];
+            latency.paths[path].count = state.counts[path];
+            latency.paths[path].sumNs = state.sums[path];
+        }
+        result.append(latency);
+    }
+    return result;
+}
+
+void LatencyTrace::reset()
+{
+    QMutexLocker locker(&s_mutex);
+    for (DeviceState& state : s_devices) {
+        for (int path = 0; path < PATH_COUNT; ++path) {
+            state.buckets[path].fill(0);
+            state.counts[path] = 0;
+            state.sums[path] = 0;
+        }
+    }
+}
+
+void LatencyTrace::startTrace(int maxEvents)
+{
+    QMutexLocker locker(&s_mutex);
+    s_events.clear();
+    s_maxEvents = qMax(1, maxEvents);
+    s_events.reserve(qMin(s_maxEvents, 65536));
+    s_droppedEvents = 0;
+    s_tracing.store(true, std::memory_order_relaxed);
+}
+
+void LatencyTrace::stopTrace()
+{
+    s_tracing.store(false, std::memory_order_relaxed);
+}
+
+bool LatencyTrace::isTracing()
+{
+    return s_tracing.load(std::memory_order_relaxed);
+}
+
+int LatencyTrace::traceEventCount()
+{
+    QMutexLocker locker(&s_mutex);
+    return s_events.size();
+}
+
+bool LatencyTrace::exportTrace(const QString& filePath)
+{
+    // 复制后释放锁，写文件期间不阻塞记录
+    QVector<TraceEvent> events;
+    QStringList deviceIds;
+    quint64 dropped = 0;
+    {
+        QMutexLocker locker(&s_mutex);
+        events = s_events;
+        for (const DeviceState& state : s_devices) {
+            deviceIds.append(state.deviceId);
+        }
+        dropped = s_droppedEvents;
+    }
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "无法写入跟踪文件:" << filePath << "错误:" << file.errorString();
+        return false;
+    }
+
+    // 时间单位为微秒；异步事件（b/e）允许同一泳道内的区间相互重叠
+    file.write("{\"displayTimeUnit\":\"ns\",\"otherData\":{\"timebase_anchor_utc_ns\":\"");
+    file.write(QByteArray::number(Timebase::anchorWallNs()));
+    file.write("\",\"dropped_events\":");
+    file.write(QByteArray::number(dropped));
+    file.write("},\"traceEvents\":[\n");
+
+    // 每条事件前写分隔符，避免数组末尾多余的逗号
+    bool first = true;
+    auto writeEvent = [&file, &first](const QByteArray& json) {
+        file.write(first ? "" : ",\n");
+        file.write(json);
+        first = false;
+    };
+
+    for (int i = 0; i < deviceIds.size(); ++i) {
+        writeEvent("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + QByteArray::number(i + 1)
+                   + ",\"args\":{\"name\":\""
+                   + deviceIds[i].toUtf8().replace('\\', "\\\\").replace('"', "\\\"") + "\"}}");
+    }
+
+    for (int i = 0; i < events.size(); ++i) {
+        const TraceEvent& event = events[i];
+        const QByteArray name = pathName(static_cast<Path>(event.path)).toUtf8();
+        const QByteArray common = "\"name\":\"" + name + "\",\"cat\":\"latency\",\"pid\":1,\"tid\":"
+                                  + QByteArray::number(event.device + 1) + ",\"id\":" + QByteArray::number(i);
+
+        writeEvent("{" + common + ",\"ph\":\"b\",\"ts\":"
+                   + QByteArray::number(event.startNs / 1000.0, 'f', 3) + "}");
+        writeEvent("{" + common + ",\"ph\":\"e\",\"ts\":"
+                   + QByteArray::number(event.endNs / 1000.0, 'f', 3) + ",\"args\":{\"latency_us\":"
+                   + QByteArray::number((event.endNs - event.startNs) / 1000.0, 'f', 3) + "}}");
+    }
+
+    file.write("\n]}\n");
+
+    qDebug() << "已导出延迟跟踪:" << filePath << "事件数:" << events.size() << "丢弃:" << dropped;
+    return file.error() == QFileDevice::NoError;
+}
+
+QString LatencyTrace::pathName(Path path)
+{
+    switch (path) {
+        case AcquisitionToIngest: return "acq_to_ingest";
+        case AcquisitionToFrame: return "acq_to_frame";
+        case AcquisitionToDisk: return "acq_to_disk";
+        case AcquisitionToScreen: return "acq_to_screen";
+        default: return "unknown";
+    }
+}
+
+} // namespace Core
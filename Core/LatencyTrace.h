@@ -0,0 +1,102 @@
+#ifndef LATENCYTRACE_H
+#define LATENCYTRACE_H
+
+#include <QString>
+#include <QVector>
+#include "DataTypes.h"
+#include "Metrics.h"
+
+namespace Core {
+
+/**
+ * @brief 端到端延迟跟踪
+ * 以样本的采集时间戳为起点，按设备统计采集到处理器、到同步帧、到存储文件、到界面刷新的延迟分布；
+ * 帧、存储和界面三条路径同时计入Core::Metrics的端到端阶段。
+ * 开启跟踪时另外保存每次测量的起止时刻，可导出为Chrome跟踪文件（chrome://tracing或Perfetto）离线查看。
+ * 每帧每设备记录一次，进入处理器的延迟按块或按逐点样本抽样记录；使用互斥锁，可在任意线程调用。
+ */
+class LatencyTrace
+{
+public:
+    /**
+     * @brief 延迟路径
+     */
+    enum Path {
+        AcquisitionToIngest = 0,   // 采集 -> 进入处理器
+        AcquisitionToFrame,        // 采集 -> 同步帧生成
+        AcquisitionToDisk,         // 采集 -> 写入存储文件
+        AcquisitionToScreen,       // 采集 -> 界面刷新完成
+        PATH_COUNT
+    };
+
+    /**
+     * @brief 单个设备的延迟分布
+     */
+    struct DeviceLatency {
+        QString deviceId;
+        Metrics::Histogram paths[PATH_COUNT];
+    };
+
+    static constexpr int DEFAULT_MAX_TRACE_EVENTS = 200000;
+
+    /**
+     * @brief 记录一次延迟
+     * @param path 路径
+     * @param deviceId 设备ID
+     * @param acquisitionNs 采集时间戳（Timebase纳秒）
+     * @param completedNs 完成时刻（Timebase纳秒）
+     */
+    static void record(Path path, const QString& deviceId, qint64 acquisitionNs, qint64 completedNs);
+
+    /**
+     * @brief 按帧中各设备的采集时间戳记录一次延迟
+     * @param path 路径
+     * @param frame 同步帧
+     * @param completedNs 完成时刻（Timebase纳秒）
+     */
+    static void recordFrame(Path path, const SynchronizedDataFrame& frame, qint64 completedNs);
+
+    /**
+     * @brief 各设备自上次重置以来的延迟分布
+     */
+    static QVector<DeviceLatency> snapshot();
+
+    /**
+     * @brief 清空延迟分布
+     */
+    static void reset();
+
+    /**
+     * @brief 开始保存跟踪事件（清空之前的事件）
+     * @param maxEvents 最多保存的事件数，超出后不再保存并计数
+     */
+    static void startTrace(int maxEvents = DEFAULT_MAX_TRACE_EVENTS);
+
+    /**
+     * @brief 停止保存跟踪事件（已保存的事件保留到下次开始）
+     */
+    static void stopTrace();
+
+    /**
+     * @brief 是否正在保存跟踪事件
+     */
+    static bool isTracing();
+
+    /**
+     * @brief 已保存的跟踪事件数
+     */
+    static int traceEventCount();
+
+    /**
+     * @brief 导出Chrome跟踪文件（JSON，异步事件，每个设备一条泳道）
+     * @param filePath 文件路径
+     * @return 是否成功
+     */
+    static bool exportTrace(const QString& filePath);
+
+    static QString pathName(Path path);
+};
+
+} // namespace Core
+
+#endif // LATENCYTRACE_H
@@ -0,0 +1,132 @@
+#include "Log.h"
+#include "Timebase.h"
+#include <QDebug>
+#include <cstdarg>
+#include <cstdio>
+
+Q_LOGGING_CATEGORY(lcDevice, "daq.device", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcProcessing, "daq.processing", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcStorage, "daq.storage", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcDisplay, "daq.display", QtInfoMsg)
+
+namespace Core {
+
+static_assert((RingLog::CAPACITY & (RingLog::CAPACITY - 1)) == 0, "RingLog::CAPACITY必须是2的幂");
+
+RingLog::RingLog() = default;
+
+RingLog& RingLog::instance()
+{
+    static RingLog log;
+    return log;
+}
+
+void RingLog::write(QtMsgType type, const QLoggingCategory& category, const char *format, ...)
+{
+    const quint64 index = m_head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = m_slots[index & (CAPACITY - 1)];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.entry.timestampNs = Timebase::nowNs();
+    slot.entry.type = type;
+    slot.entry.category = &category;
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(slot.entry.message, MESSAGE_SIZE, format, args);
+    va_end(args);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+int RingLog::drain(const std::function<void(const Entry&)>& handler)
+{
+    const quint64 head = m_head.load(std::memory_order_acquire);
+
+    // 落后超过容量的部分已被覆盖
+    if (head - m_tail > static_cast<quint64>(CAPACITY)) {
+        m_lost.fetch_add(head - CAPACITY - m_tail, std::memory_order_relaxed);
+        m_tail = head - CAPACITY;
+    }
+
+    int count = 0;
+    Entry entry;
+    while (m_tail < head) {
+        Slot& slot = m_slots[m_tail & (CAPACITY - 1)];
+        const quint64 expected = 2 * m_tail + 2;
+        const quint64 sequence = slot.sequence.load(std::memory_order_acquire);
+
+        if (sequence < expected) {
+            // 该记录还在写入，下次再取
+            break;
+        }
+
+        if (sequence == expected) {
+            entry = slot.entry;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            // 复制期间被新一轮写入覆盖则丢弃
+            if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+                handler(entry);
+                ++count;
+            } else {
+                m_lost.fetch_add(1, std::memory_order_relaxed);
+            }
+        } else {
+            m_lost.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ++m_tail;
+    }
+
+    return count;
+}
+
+int RingLog::flushToQtLog()
+{
+    return drain([](const Entry& entry) {
+        const char *categoryName = entry.category ? entry.category->categoryName() : "default";
+        QMessageLogger logger(nullptr, 0, nullptr, categoryName);
+        const QString text = QStringLiteral("[%1 s] %2")
+                                 .arg(entry.timestampNs / 1e9, 0, 'f', 6)
+                                 .arg(QString::fromUtf8(entry.message));
+
+        switch (entry.type) {
+        case QtWarningMsg:
+            logger.warning().noquote() << text;
+            break;
+        case QtCriticalMsg:
+        case QtFatalMsg:
+            logger.critical().noquote() << text;
+            break;
+        case QtInfoMsg:
+            logger.info().noquote() << text;
+            break;
+        case QtDebugMsg:
+        default:
+            logger.debug().noquote() << text;
+            break;
+        }
+    });
+}
+
+quint64 RingLog::lostCount() const
+{
+    return m_lost.load(std::memory_order_relaxed);
+}
+
+bool RingLog::allow(std::atomic<qint64>& lastNs, int intervalMs)
+{
+    const qint64 nowNs = Timebase::nowNs();
+    qint64 previous = lastNs.load(std::memory_order_relaxed);
+    if (nowNs - previous < intervalMs * Timebase::NS_PER_MS) {
+        return false;
+    }
+
+    // 多个线程同时到达时只有一个记录
+    return lastNs.compare_exchange_strong(previous, nowNs, std::memory_order_relaxed);
+}
+
+} // namespace Core
@@ -0,0 +1,127 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <QtGlobal>
+#include <QLoggingCategory>
+#include <QDebug>
+#include <atomic>
+#include <array>
+#include <functional>
+
+/**
+ * @brief 日志分类
+ * 调试级别默认关闭，运行时通过QT_LOGGING_RULES打开，例如 "daq.processing.debug=true"
+ */
+Q_DECLARE_LOGGING_CATEGORY(lcDevice)       // daq.device     设备采集
+Q_DECLARE_LOGGING_CATEGORY(lcProcessing)   // daq.processing 通道处理和同步
+Q_DECLARE_LOGGING_CATEGORY(lcStorage)      // daq.storage    数据存储
+Q_DECLARE_LOGGING_CATEGORY(lcDisplay)      // daq.display    显示
+
+/**
+ * @brief 热路径跟踪日志（每个样本或每帧一次的输出）
+ * 只有定义了DAQ_ENABLE_TRACE（Debug构建）时才生成代码；否则整条语句连同参数的求值被编译器移除。
+ * 用法与qCDebug相同：DAQ_TRACE(lcProcessing) << "值:" << value;
+ */
+#ifdef DAQ_ENABLE_TRACE
+#define DAQ_TRACE(category) qCDebug(category)
+#else
+#define DAQ_TRACE(category) while (false) QMessageLogger().noDebug()
+#endif
+
+/**
+ * @brief 限频诊断日志（运行时仍需要的热路径诊断）
+ * 写入无锁环形日志，同一条语句在intervalMs内最多记录一次；由UI线程定期输出到Qt日志。
+ * 用法：DAQ_LOG_EVERY_MS(1000, QtWarningMsg, lcProcessing, "同步节拍迟到 %lld 微秒", latenessUs);
+ */
+#define DAQ_LOG_EVERY_MS(intervalMs, type, category, ...) \
+    do { \
+        static std::atomic<qint64> daqLogLastNs(Core::RingLog::NEVER_LOGGED); \
+        if (category().isEnabled(type) && Core::RingLog::allow(daqLogLastNs, intervalMs)) { \
+            Core::RingLog::instance().write(type, category(), __VA_ARGS__); \
+        } \
+    } while (false)
+
+namespace Core {
+
+/**
+ * @brief 无锁环形日志
+ * 任意线程写入：原子递增写位置取得槽位，格式化到槽内定长缓冲区，不分配内存、不加锁；
+ * 单个读线程按顺序取出。读线程落后超过容量时最旧的记录被覆盖并计入丢失数。
+ */
+class RingLog
+{
+public:
+    static constexpr int CAPACITY = 1024;          // 槽位数（2的幂）
+    static constexpr int MESSAGE_SIZE = 200;       // 每条消息的最大字节数（UTF-8，超出截断）
+    static constexpr qint64 NEVER_LOGGED = -(Q_INT64_C(1) << 62);
+
+    /**
+     * @brief 日志记录
+     */
+    struct Entry {
+        qint64 timestampNs = 0;                    // 写入时间（Timebase纳秒）
+        QtMsgType type = QtDebugMsg;               // 级别
+        const QLoggingCategory *category = nullptr; // 分类
+        char message[MESSAGE_SIZE] = {};           // 消息
+    };
+
+    /**
+     * @brief 全局实例
+     */
+    static RingLog& instance();
+
+    /**
+     * @brief 写入一条日志（printf格式）
+     * @param type 级别
+     * @param category 分类
+     * @param format 格式字符串
+     */
+    void write(QtMsgType type, const QLoggingCategory& category, const char *format, ...)
+#if defined(__GNUC__) || defined(__clang__)
+        __attribute__((format(printf, 4, 5)))
+#endif
+        ;
+
+    /**
+     * @brief 按顺序取出已写完的记录（只允许一个读线程调用）
+     * @param handler 记录处理函数
+     * @return 取出的记录数
+     */
+    int drain(const std::function<void(const Entry&)>& handler);
+
+    /**
+     * @brief 取出全部记录并输出到Qt日志（由UI线程定时调用）
+     * @return 输出的记录数
+     */
+    int flushToQtLog();
+
+    /**
+     * @brief 因读线程落后被覆盖的记录数
+     */
+    quint64 lostCount() const;
+
+    /**
+     * @brief 限频判断：距上次允许超过intervalMs时返回true并更新时间
+     * @param lastNs 该语句上次记录的时间（调用点的静态变量）
+     * @param intervalMs 最小间隔（毫秒）
+     */
+    static bool allow(std::atomic<qint64>& lastNs, int intervalMs);
+
+private:
+    RingLog();
+
+    struct Slot {
+        // 序号：2n+1表示第n条记录正在写入，2n+2表示写入完成
+        std::atomic<quint64> sequence{0};
+        Entry entry;
+    };
+
+    std::array<Slot, CAPACITY> m_slots;
+    std::atomic<quint64> m_head{0};                // 下一条记录的序号
+    quint64 m_tail = 0;                            // 读线程下一条要取的序号
+    std::atomic<quint64> m_lost{0};
+};
+
+} // namespace Core
+
+#endif // LOG_H
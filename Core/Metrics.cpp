@@ -0,0 +1,311 @@
+#include "Metrics.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDebug>
+#include <QtMath>
+#include <QtAlgorithms>
+#include <cmath>
+
+namespace Core {
+
+namespace {
+
+// 分片只由所属线程写入，用普通的原子读写代替带锁前缀的读-改-写
+inline void addRelaxed(std::atomic<quint64>& target, quint64 value)
+{
+    target.store(target.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+// 每个线程的指标分片
+struct ThreadShard {
+    static constexpr int STAGE_COUNT = Metrics::STAGE_COUNT;
+    static constexpr int BUCKET_COUNT = Metrics::BUCKET_COUNT;
+    static constexpr int COUNTER_COUNT = Metrics::COUNTER_COUNT;
+
+    std::atomic<quint64> buckets[STAGE_COUNT][BUCKET_COUNT];
+    std::atomic<quint64> counts[STAGE_COUNT];
+    std::atomic<quint64> sums[STAGE_COUNT];
+    std::atomic<quint64> counters[COUNTER_COUNT];
+
+    ThreadShard()
+    {
+        for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+            for (int i = 0; i < BUCKET_COUNT; ++i) {
+                buckets[stage][i].store(0, std::memory_order_relaxed);
+            }
+            counts[stage].store(0, std::memory_order_relaxed);
+            sums[stage].store(0, std::memory_order_relaxed);
+        }
+        for (int i = 0; i < COUNTER_COUNT; ++i) {
+            counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+QMutex s_shardMutex;
+QVector<ThreadShard*> s_shards;                  // 所有线程的分片（线程退出后保留，计数不丢失）
+std::atomic<qint64> s_gauges[Metrics::GAUGE_COUNT];
+thread_local ThreadShard* t_shard = nullptr;
+
+ThreadShard* localShard()
+{
+    if (!t_shard) {
+        t_shard = new ThreadShard();
+        QMutexLocker locker(&s_shardMutex);
+        s_shards.append(t_shard);
+    }
+    return t_shard;
+}
+
+} // namespace
+
+std::atomic<bool> Metrics::s_enabled(true);
+
+void Metrics::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Metrics::recordLatency(Stage stage, qint64 latencyNs)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    ThreadShard* shard = localShard();
+    const quint64 value = latencyNs > 0 ? static_cast<quint64>(latencyNs) : 0;
+    addRelaxed(shard->buckets[stage][bucketIndex(value)], 1);
+    addRelaxed(shard->counts[stage], 1);
+    addRelaxed(shard->sums[stage], value);
+}
+
+void Metrics::increment(Counter counter, quint64 count)
+{
+    if (!isEnabled()) {
+        return;
+    }
+
+    addRelaxed(localShard()->counters[counter], count);
+}
+
+void Metrics::setGauge(Gauge gauge, qint64 value)
+{
+    s_gauges[gauge].store(value, std::memory_order_relaxed);
+}
+
+Metrics::Snapshot Metrics::snapshot()
+{
+    Snapshot result;
+    result.timestampNs = Timebase::nowNs();
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        result.stages[stage].buckets.fill(0, BUCKET_COUNT);
+    }
+
+    QMutexLocker locker(&s_shardMutex);
+    for (const ThreadShard* shard : s_shards) {
+        for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+            Histogram& histogram = result.stages[stage];
+            quint64* buckets = histogram.buckets.data();
+            for (int i = 0; i < BUCKET_COUNT; ++i) {
+                buckets[i] += shard->buckets[stage][i].load(std::memory_order_relaxed);
+            }
+            histogram.count += shard->counts[stage].load(std::memory_order_relaxed);
+            histogram.sumNs += shard->sums[stage].load(std::memory_order_relaxed);
+        }
+        for (int i = 0; i < COUNTER_COUNT; ++i) {
+            result.counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    for (int i = 0; i < GAUGE_COUNT; ++i) {
+        result.gauges[i] = s_gauges[i].load(std::memory_order_relaxed);
+    }
+
+    return result;
+}
+
+bool Metrics::dumpToFile(const QString& filePath, const Snapshot& snapshot)
+{
+    QJsonObject root;
+    root["timestamp_ns"] = QString::number(snapshot.timestampNs);
+    root["wall_time"] = Timebase::toDateTime(snapshot.timestampNs).toString(Qt::ISODateWithMs);
+
+    QJsonObject stagesObj;
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        const Histogram& histogram = snapshot.stages[stage];
+        QJsonObject stageObj;
+        stageObj["count"] = static_cast<double>(histogram.count);
+        stageObj["mean_us"] = histogram.meanUs();
+        stageObj["p50_us"] = histogram.percentileUs(50.0);
+        stageObj["p90_us"] = histogram.percentileUs(90.0);
+        stageObj["p99_us"] = histogram.percentileUs(99.0);
+        stageObj["p999_us"] = histogram.percentileUs(99.9);
+        stageObj["max_us"] = histogram.maxUs();
+
+        // 只保存非空桶：[下界纳秒, 宽度纳秒, 计数]
+        QJsonArray bucketsArray;
+        for (int i = 0; i < histogram.buckets.size(); ++i) {
+            if (histogram.buckets[i] > 0) {
+                bucketsArray.append(QJsonArray{static_cast<double>(bucketLowerBound(i)),
+                                               static_cast<double>(bucketWidth(i)),
+                                               static_cast<double>(histogram.buckets[i])});
+            }
+        }
+        stageObj["buckets"] = bucketsArray;
+        stagesObj[stageName(static_cast<Stage>(stage))] = stageObj;
+    }
+    root["stages"] = stagesObj;
+
+    QJsonObject countersObj;
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        countersObj[counterName(static_cast<Counter>(i))] = static_cast<double>(snapshot.counters[i]);
+    }
+    root["counters"] = countersObj;
+
+    QJsonObject gaugesObj;
+    for (int i = 0; i < GAUGE_COUNT; ++i) {
+        gaugesObj[gaugeName(static_cast<Gauge>(i))] = static_cast<double>(snapshot.gauges[i]);
+    }
+    root["gauges"] = gaugesObj;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "无法写入性能指标文件:" << filePath << "错误:" << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    return true;
+}
+
+QString Metrics::stageName(Stage stage)
+{
+    switch (stage) {
+        case DeviceRead: return "device_read";
+        case Ingest: return "ingest";
+        case FrameBuild: return "frame_build";
+        case SecondaryEval: return "secondary_eval";
+        case StorageWrite: return "storage_write";
+        case UiRefresh: return "ui_refresh";
+        case AcquisitionToFrame: return "acq_to_frame";
+        case AcquisitionToDisk: return "acq_to_disk";
+        case AcquisitionToScreen: return "acq_to_screen";
+        default: return "unknown";
+    }
+}
+
+QString Metrics::counterName(Counter counter)
+{
+    switch (counter) {
+        case RawSamples: return "raw_samples";
+        case IngestedSamples: return "ingested_samples";
+        case Frames: return "frames";
+        case StoredRows: return "stored_rows";
+        case UiRefreshes: return "ui_refreshes";
+        default: return "unknown";
+    }
+}
+
+QString Metrics::gaugeName(Gauge gauge)
+{
+    switch (gauge) {
+        case Channels: return "channels";
+        case SyncLatenessUs: return "sync_lateness_us";
+        case UiIntervalMs: return "ui_interval_ms";
+        default: return "unknown";
+    }
+}
+
+int Metrics::bucketIndex(quint64 valueNs)
+{
+    if (valueNs < static_cast<quint64>(SUB_BUCKETS)) {
+        return static_cast<int>(valueNs);
+    }
+
+    const int magnitude = 63 - qCountLeadingZeroBits(valueNs);
+    if (magnitude > MAX_MAGNITUDE) {
+        return BUCKET_COUNT - 1;
+    }
+
+    // 最高位以下取SUB_BUCKET_BITS位作为子桶
+    const int shift = magnitude - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKETS + static_cast<int>((valueNs >> shift) - SUB_BUCKETS);
+}
+
+quint64 Metrics::bucketLowerBound(int index)
+{
+    if (index < SUB_BUCKETS) {
+        return static_cast<quint64>(index);
+    }
+
+    const int shift = index / SUB_BUCKETS - 1;
+    return static_cast<quint64>(index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+}
+
+quint64 Metrics::bucketWidth(int index)
+{
+    return index < SUB_BUCKETS ? 1 : Q_UINT64_C(1) << (index / SUB_BUCKETS - 1);
+}
+
+double Metrics::Histogram::meanUs() const
+{
+    return count > 0 ? sumNs / 1000.0 / count : 0.0;
+}
+
+double Metrics::Histogram::percentileUs(double percentile) const
+{
+    if (count == 0) {
+        return 0.0;
+    }
+
+    const quint64 target = qMax<quint64>(1, static_cast<quint64>(std::ceil(count * percentile / 100.0)));
+    quint64 cumulative = 0;
+    for (int i = 0; i < buckets.size(); ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= target) {
+            // 取桶中点
+            return (bucketLowerBound(i) + bucketWidth(i) / 2.0) / 1000.0;
+        }
+    }
+    return maxUs();
+}
+
+double Metrics::Histogram::maxUs() const
+{
+    for (int i = buckets.size() - 1; i >= 0; --i) {
+        if (buckets[i] > 0) {
+            return (bucketLowerBound(i) + bucketWidth(i)) / 1000.0;
+        }
+    }
+    return 0.0;
+}
+
+Metrics::Histogram Metrics::Histogram::operator-(const Histogram& earlier) const
+{
+    Histogram result = *this;
+    if (earlier.buckets.size() == buckets.size()) {
+        for (int i = 0; i < buckets.size(); ++i) {
+            result.buckets[i] -= earlier.buckets[i];
+        }
+        result.count -= earlier.count;
+        result.sumNs -= earlier.sumNs;
+    }
+    return result;
+}
+
+Metrics::Snapshot Metrics::Snapshot::operator-(const Snapshot& earlier) const
+{
+    Snapshot result = *this;
+    for (int stage = 0; stage < STAGE_COUNT; ++stage) {
+        result.stages[stage] = stages[stage] - earlier.stages[stage];
+    }
+    for (int i = 0; i < COUNTER_COUNT; ++i) {
+        result.counters[i] -= earlier.counters[i];
+    }
+    return result;
+}
+
+} // namespace Core
@@ -0,0 +1,183 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include "Timebase.h"
+
+namespace Core {
+
+/**
+ * @brief 流水线性能指标
+ * 计数器、测量值和各阶段耗时直方图。每个线程第一次记录时分配自己的分片，
+ * 之后只写本线程分片（无锁、无竞争，只有普通的原子读写）；读取快照时汇总所有分片。
+ * 直方图按HDR方式分桶：每个2的幂区间再均分为16个子桶，相对误差约6%，覆盖1纳秒到约1小时。
+ */
+class Metrics
+{
+public:
+    /**
+     * @brief 流水线阶段
+     */
+    enum Stage {
+        DeviceRead = 0,     // 设备读取和解码一批数据
+        Ingest,             // 样本从设备时间戳到进入处理器的延迟
+        FrameBuild,         // 生成一个同步帧（通道处理）
+        SecondaryEval,      // 一个同步帧的二次计算
+        StorageWrite,       // 写入一行存储数据
+        UiRefresh,          // 一次界面刷新
+        AcquisitionToFrame,  // 端到端：采集到同步帧生成
+        AcquisitionToDisk,   // 端到端：采集到写入存储文件
+        AcquisitionToScreen, // 端到端：采集到界面刷新完成
+        STAGE_COUNT
+    };
+
+    /**
+     * @brief 计数器
+     */
+    enum Counter {
+        RawSamples = 0,     // 设备产生的原始样本数
+        IngestedSamples,    // 处理器接收的样本数
+        Frames,             // 生成的同步帧数
+        StoredRows,         // 写入的存储行数
+        UiRefreshes,        // 界面刷新次数
+        COUNTER_COUNT
+    };
+
+    /**
+     * @brief 测量值（最新值，不按线程分片）
+     */
+    enum Gauge {
+        Channels = 0,       // 通道数
+        SyncLatenessUs,     // 同步时钟最近一次节拍迟到（微秒）
+        UiIntervalMs,       // 界面刷新节拍间隔（毫秒）
+        GAUGE_COUNT
+    };
+
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int MAX_MAGNITUDE = 42;                            // 最高位位置上限（约73分钟）
+    static constexpr int BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+    /**
+     * @brief 单个直方图的汇总数据
+     */
+    struct Histogram {
+        QVector<quint64> buckets;      // 各桶计数
+        quint64 count = 0;             // 样本数
+        quint64 sumNs = 0;             // 耗时总和（纳秒）
+
+        double meanUs() const;
+        double percentileUs(double percentile) const;
+        double maxUs() const;          // 最高非空桶的上界
+        Histogram operator-(const Histogram& earlier) const;
+    };
+
+    /**
+     * @brief 全部指标的快照
+     */
+    struct Snapshot {
+        qint64 timestampNs = 0;
+        Histogram stages[STAGE_COUNT];
+        quint64 counters[COUNTER_COUNT] = {};
+        qint64 gauges[GAUGE_COUNT] = {};
+
+        /**
+         * @brief 两次快照之差（测量值取本次的值）
+         */
+        Snapshot operator-(const Snapshot& earlier) const;
+    };
+
+    /**
+     * @brief 作用域计时：析构时把经过的时间记入指定阶段
+     */
+    class ScopedTimer
+    {
+    public:
+        explicit ScopedTimer(Stage stage)
+            : m_stage(stage), m_startNs(isEnabled() ? Timebase::nowNs() : 0) {}
+        ~ScopedTimer()
+        {
+            if (m_startNs != 0) {
+                recordLatency(m_stage, Timebase::nowNs() - m_startNs);
+            }
+        }
+
+    private:
+        Q_DISABLE_COPY(ScopedTimer)
+        Stage m_stage;
+        qint64 m_startNs;
+    };
+
+    /**
+     * @brief 是否启用记录
+     */
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief 启用或停用记录
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief 记录一次阶段耗时
+     * @param stage 阶段
+     * @param latencyNs 耗时（纳秒）
+     */
+    static void recordLatency(Stage stage, qint64 latencyNs);
+
+    /**
+     * @brief 计数器累加
+     * @param counter 计数器
+     * @param count 增量
+     */
+    static void increment(Counter counter, quint64 count = 1);
+
+    /**
+     * @brief 设置测量值
+     * @param gauge 测量值
+     * @param value 值
+     */
+    static void setGauge(Gauge gauge, qint64 value);
+
+    /**
+     * @brief 汇总所有线程分片得到当前快照（自启动以来的累计值）
+     */
+    static Snapshot snapshot();
+
+    /**
+     * @brief 把快照写入文件（JSON）
+     * @param filePath 文件路径
+     * @param snapshot 快照
+     * @return 是否成功
+     */
+    static bool dumpToFile(const QString& filePath, const Snapshot& snapshot);
+
+    static QString stageName(Stage stage);
+    static QString counterName(Counter counter);
+    static QString gaugeName(Gauge gauge);
+
+    /**
+     * @brief 数值所在的桶
+     */
+    static int bucketIndex(quint64 valueNs);
+
+    /**
+     * @brief 桶的下界（纳秒）
+     */
+    static quint64 bucketLowerBound(int index);
+
+    /**
+     * @brief 桶的宽度（纳秒）
+     */
+    static quint64 bucketWidth(int index);
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+} // namespace Core
+
+#endif // METRICS_H
@@ -0,0 +1,193 @@
+#include "ThreadPlacement.h"
+#include <QThread>
+#include <QDebug>
+
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace Core {
+
+namespace {
+
+#if defined(Q_OS_LINUX)
+/**
+ * @brief 优先级名称对应的nice值（SCHED_OTHER下只有nice值影响调度）
+ */
+int niceValue(const QString& priority)
+{
+    if (priority == "low") {
+        return 5;
+    } else if (priority == "high") {
+        return -5;
+    } else if (priority == "highest") {
+        return -10;
+    } else if (priority == "time_critical" || priority == "realtime") {
+        return -20;
+    }
+    return 0;
+}
+#elif defined(Q_OS_WIN)
+int windowsPriority(const QString& priority)
+{
+    if (priority == "low") {
+        return THREAD_PRIORITY_BELOW_NORMAL;
+    } else if (priority == "high") {
+        return THREAD_PRIORITY_ABOVE_NORMAL;
+    } else if (priority == "highest") {
+        return THREAD_PRIORITY_HIGHEST;
+    } else if (priority == "time_critical" || priority == "realtime") {
+        return THREAD_PRIORITY_TIME_CRITICAL;
+    }
+    return THREAD_PRIORITY_NORMAL;
+}
+#else
+QThread::Priority qtPriority(const QString& priority)
+{
+    if (priority == "low") {
+        return QThread::LowPriority;
+    } else if (priority == "high") {
+        return QThread::HighPriority;
+    } else if (priority == "highest") {
+        return QThread::HighestPriority;
+    } else if (priority == "time_critical" || priority == "realtime") {
+        return QThread::TimeCriticalPriority;
+    }
+    return QThread::NormalPriority;
+}
+#endif
+
+} // namespace
+
+QStringList ThreadPlacement::priorityNames()
+{
+    return {"inherit", "low", "normal", "high", "highest", "time_critical", "realtime"};
+}
+
+bool ThreadPlacement::applyToCurrentThread(const ThreadPlacementConfig& placement, const QString& threadName)
+{
+    if (placement.isDefault()) {
+        return true;
+    }
+
+    bool ok = true;
+    if (!placement.cpus.isEmpty()) {
+        ok = setAffinity(placement.cpus, threadName) && ok;
+    }
+    if (placement.priority != "inherit") {
+        ok = setPriority(placement.priority, placement.realtimePriority, threadName) && ok;
+    }
+
+    qDebug() << "线程放置:" << threadName
+             << "CPU:" << placement.cpus
+             << "优先级:" << placement.priority
+             << (ok ? "已生效" : "部分未生效")
+             << "线程ID:" << QThread::currentThreadId();
+    return ok;
+}
+
+void ThreadPlacement::applyOnStart(QThread* thread, const ThreadPlacementConfig& placement, const QString& threadName)
+{
+    if (!thread) {
+        return;
+    }
+
+    // Qt在线程启动时把objectName设置为操作系统线程名，便于在top/perf中区分
+    thread->setObjectName(threadName);
+
+    if (placement.isDefault()) {
+        return;
+    }
+
+    // started在新线程中发出，DirectConnection保证在该线程内执行
+    QObject::connect(thread, &QThread::started, thread, [placement, threadName]() {
+        applyToCurrentThread(placement, threadName);
+    }, Qt::DirectConnection);
+}
+
+bool ThreadPlacement::setAffinity(const QList<int>& cpus, const QString& threadName)
+{
+#if defined(Q_OS_LINUX)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    const int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (result != 0) {
+        qWarning() << "线程" << threadName << "绑定CPU失败:" << cpus << strerror(result);
+        return false;
+    }
+    return true;
+#elif defined(Q_OS_WIN)
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+            mask |= static_cast<DWORD_PTR>(1) << cpu;
+        }
+    }
+
+    if (mask == 0 || SetThreadAffinityMask(GetCurrentThread(), mask) == 0) {
+        qWarning() << "线程" << threadName << "绑定CPU失败:" << cpus << "错误码:" << GetLastError();
+        return false;
+    }
+    return true;
+#else
+    qWarning() << "线程" << threadName << "绑定CPU失败：当前平台不支持线程亲和性";
+    return false;
+#endif
+}
+
+bool ThreadPlacement::setPriority(const QString& priority, int realtimePriority, const QString& threadName)
+{
+#if defined(Q_OS_LINUX)
+    if (priority == "realtime") {
+        sched_param param;
+        param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO), realtimePriority,
+                                      sched_get_priority_max(SCHED_FIFO));
+        const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result == 0) {
+            return true;
+        }
+        qWarning() << "线程" << threadName << "设置SCHED_FIFO失败:" << strerror(result)
+                   << "（需要CAP_SYS_NICE或RLIMIT_RTPRIO），退回time_critical";
+    }
+
+    // Linux下setpriority对线程ID生效，只改变调用线程
+    const id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+    if (setpriority(PRIO_PROCESS, tid, niceValue(priority)) != 0) {
+        qWarning() << "线程" << threadName << "设置优先级" << priority << "失败:" << strerror(errno)
+                   << "（负nice值需要CAP_SYS_NICE或RLIMIT_NICE）";
+        return false;
+    }
+    return priority != "realtime";
+#elif defined(Q_OS_WIN)
+    Q_UNUSED(realtimePriority);
+    if (!SetThreadPriority(GetCurrentThread(), windowsPriority(priority))) {
+        qWarning() << "线程" << threadName << "设置优先级" << priority << "失败，错误码:" << GetLastError();
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(realtimePriority);
+    Q_UNUSED(threadName);
+    QThread::currentThread()->setPriority(qtPriority(priority));
+    return true;
+#endif
+}
+
+} // namespace Core
@@ -0,0 +1,51 @@
+#ifndef THREADPLACEMENT_H
+#define THREADPLACEMENT_H
+
+#include <QString>
+#include <QStringList>
+#include "DataTypes.h"
+
+class QThread;
+
+namespace Core {
+
+/**
+ * @brief 线程放置（CPU绑定和优先级）
+ * 只能作用于调用线程本身，QThread需要在started信号中（线程内）应用，见applyOnStart。
+ * Linux下优先级用nice值实现（负值需要CAP_SYS_NICE或RLIMIT_NICE），realtime使用SCHED_FIFO
+ * （需要CAP_SYS_NICE或RLIMIT_RTPRIO，失败时退回time_critical）；Windows下使用线程优先级和亲和性掩码。
+ * 权限不足时只输出警告，线程继续以原有设置运行。
+ */
+class ThreadPlacement
+{
+public:
+    /**
+     * @brief 支持的优先级名称
+     */
+    static QStringList priorityNames();
+
+    /**
+     * @brief 对调用线程应用放置策略
+     * @param placement 放置策略
+     * @param threadName 线程名称（用于日志）
+     * @return 全部设置是否生效
+     */
+    static bool applyToCurrentThread(const ThreadPlacementConfig& placement, const QString& threadName);
+
+    /**
+     * @brief 设置线程名称，并在线程启动时（started信号，线程内直接调用）应用放置策略
+     * 必须在thread->start()之前调用
+     * @param thread 线程
+     * @param placement 放置策略
+     * @param threadName 线程名称（操作系统中可见的线程名）
+     */
+    static void applyOnStart(QThread* thread, const ThreadPlacementConfig& placement, const QString& threadName);
+
+private:
+    static bool setAffinity(const QList<int>& cpus, const QString& threadName);
+    static bool setPriority(const QString& priority, int realtimePriority, const QString& threadName);
+};
+
+} // namespace Core
+
+#endif // THREADPLACEMENT_H
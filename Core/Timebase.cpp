@@ -0,0 +1,57 @@
+#include "Timebase.h"
+#include <chrono>
+
+namespace Core {
+
+namespace {
+
+/**
+ * @brief 时间基准起点：单调时钟和墙上时间在同一时刻各取一次
+ */
+struct Anchor {
+    std::chrono::steady_clock::time_point steady;
+    qint64 wallNs;
+
+    Anchor()
+        : steady(std::chrono::steady_clock::now())
+        , wallNs(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::system_clock::now().time_since_epoch()).count())
+    {
+    }
+};
+
+const Anchor& anchor()
+{
+    static const Anchor instance;
+    return instance;
+}
+
+} // namespace
+
+void Timebase::initialize()
+{
+    anchor();
+}
+
+qint64 Timebase::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - anchor().steady).count();
+}
+
+qint64 Timebase::anchorWallNs()
+{
+    return anchor().wallNs;
+}
+
+qint64 Timebase::toWallMs(qint64 timestampNs)
+{
+    return (anchor().wallNs + timestampNs) / NS_PER_MS;
+}
+
+QDateTime Timebase::toDateTime(qint64 timestampNs)
+{
+    return QDateTime::fromMSecsSinceEpoch(toWallMs(timestampNs));
+}
+
+} // namespace Core
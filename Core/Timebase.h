@@ -0,0 +1,61 @@
+#ifndef TIMEBASE_H
+#define TIMEBASE_H
+
+#include <QtGlobal>
+#include <QDateTime>
+
+namespace Core {
+
+/**
+ * @brief 进程统一时间基准
+ * 所有设备、处理器和存储使用同一个单调时钟（steady_clock），时间戳为进程起点以来的纳秒数，
+ * 不受系统时间调整（NTP校时、手动改时间）影响，不同设备的数据可以直接比较先后和对齐。
+ * 起点时刻同时记录一次墙上时间（锚点），需要显示或保存绝对时间时由锚点换算。
+ */
+class Timebase
+{
+public:
+    /**
+     * @brief 固定时间基准的起点（在main中尽早调用，否则在第一次取时间时固定）
+     */
+    static void initialize();
+
+    /**
+     * @brief 当前时间
+     * @return 起点以来的纳秒数（单调递增）
+     */
+    static qint64 nowNs();
+
+    /**
+     * @brief 起点对应的墙上时间
+     * @return 1970-01-01 UTC以来的纳秒数
+     */
+    static qint64 anchorWallNs();
+
+    /**
+     * @brief 时间戳换算为墙上时间
+     * @param timestampNs 时间戳（纳秒）
+     * @return 1970-01-01 UTC以来的毫秒数
+     */
+    static qint64 toWallMs(qint64 timestampNs);
+
+    /**
+     * @brief 时间戳换算为本地日期时间（用于显示和文件名）
+     * @param timestampNs 时间戳（纳秒）
+     * @return 日期时间
+     */
+    static QDateTime toDateTime(qint64 timestampNs);
+
+    /**
+     * @brief 两个时间戳之差
+     * @return 秒
+     */
+    static double secondsBetween(qint64 fromNs, qint64 toNs) { return (toNs - fromNs) / 1e9; }
+
+    static constexpr qint64 NS_PER_MS = 1000000;
+    static constexpr qint64 NS_PER_SECOND = 1000000000;
+};
+
+} // namespace Core
+
+#endif // TIMEBASE_H
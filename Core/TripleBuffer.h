@@ -0,0 +1,88 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+namespace Core {
+
+/**
+ * @brief 无锁三缓冲
+ * 单写单读：写线程在写缓冲中填充数据后发布，读线程取走最近一次发布的数据。
+ * 两端都只做一次原子交换，写线程永远不会等待读线程，读线程也不会跨线程调用。
+ * 读线程拿到的缓冲在下一次fetch之前保持不变。
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer()
+        : m_state(1)          // 中间缓冲为1，无新数据
+        , m_writeIndex(0)
+        , m_readIndex(2)
+    {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief 获取写缓冲（仅写线程调用）
+     * @return 写缓冲引用
+     */
+    T& writeBuffer()
+    {
+        return m_slots[m_writeIndex].value;
+    }
+
+    /**
+     * @brief 发布写缓冲（仅写线程调用）
+     * 写缓冲与中间缓冲交换，并标记有新数据
+     */
+    void publish()
+    {
+        unsigned previous = m_state.exchange(m_writeIndex | DIRTY_BIT, std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief 取最新发布的数据（仅读线程调用）
+     * @return 自上次调用以来是否有新数据
+     */
+    bool fetch()
+    {
+        if (!(m_state.load(std::memory_order_acquire) & DIRTY_BIT)) {
+            return false;
+        }
+
+        unsigned previous = m_state.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief 获取读缓冲（仅读线程调用）
+     * @return 读缓冲引用
+     */
+    const T& readBuffer() const
+    {
+        return m_slots[m_readIndex].value;
+    }
+
+private:
+    static constexpr unsigned INDEX_MASK = 0x3;
+    static constexpr unsigned DIRTY_BIT = 0x4;
+
+    // 每个缓冲独占缓存行，避免读写线程伪共享
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    Slot m_slots[3];
+    std::atomic<unsigned> m_state;   // 中间缓冲索引 | 新数据标志
+    unsigned m_writeIndex;           // 写线程独占
+    unsigned m_readIndex;            // 读线程独占
+};
+
+} // namespace Core
+
+#endif // TRIPLEBUFFER_H
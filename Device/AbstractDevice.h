@@ -83,9 +83,17 @@ signals:
      * @param deviceId 设备ID
      * @param hardwareChannel 硬件通道标识
      * @param rawValue 原始值
-     * @param timestamp 时间戳
+     * @param timestamp 时间戳（Core::Timebase纳秒）
      */
     void rawDataPointReady(QString deviceId, QString hardwareChannel, double rawValue, qint64 timestamp);
+
+    /**
+     * @brief 原始样本块就绪信号
+     * 高采样率设备一次发送一整块多通道样本，代替逐点发送rawDataPointReady
+     * @param deviceId 设备ID
+     * @param block 样本块
+     */
+    void rawDataBlockReady(QString deviceId, Core::RawSampleBlock block);
     
     /**
      * @brief 设备状态变化信号
@@ -1,4 +1,7 @@
 #include "DAQDevice.h"
+#include "../Core/Log.h"
+#include "../Core/Metrics.h"
+#include "../Core/ThreadPlacement.h"
 #include <cmath>
 
 // 定义必要的常量，确保这些常量在Art_DAQ.h中未定义的情况下可用
@@ -38,7 +41,7 @@ DAQDevice::DAQDevice(const Core::DAQDeviceConfig& config, QObject *parent)
     , isAcquiring(false)
     , m_filterEnabled(false)
     , m_cutoffFrequency(50.0)  // 默认截止频率设置为50Hz
-    , m_filterOrder(128)       // 默认滤波器阶数
+    , m_filter(FirFilter::DEFAULT_ORDER)
 {
     // 设置全局指针
     g_daqDevice = this;
@@ -55,6 +58,9 @@ DAQDevice::DAQDevice(const Core::DAQDeviceConfig& config, QObject *parent)
     qDebug() << "[DAQDevice] 初始化完成，设备ID:" << getDeviceId()
              << "，通道数:" << m_config.channels.size()
              << "，采样率:" << m_config.sampleRate;
+#ifdef DAQ_SIMULATED_DRIVER
+    qDebug() << "[DAQDevice] 使用模拟Art_DAQ驱动";
+#endif
 }
 
 DAQDevice::~DAQDevice()
@@ -325,11 +331,7 @@ void DAQDevice::initializeDAQTask()
 
     // 初始化滤波缓冲区
     int numChannels = m_config.channels.size();
-    m_filterBuffers.resize(numChannels);
-    for (int ch = 0; ch < numChannels; ++ch) {
-        m_filterBuffers[ch].resize(m_filterOrder + 1);
-        m_filterBuffers[ch].fill(0.0); // 初始化为0
-    }
+    m_filter.setChannelCount(numChannels);
 
     // 设置采样时钟参数 - 在使用ArtDAQErrChk之前定义所有变量
     int samplesPerChannel = 1000; // 每个通道的样本数
@@ -380,9 +382,11 @@ void DAQDevice::processData(float64 *data, int32 read)
         return;
     }
 
+    Core::Metrics::ScopedTimer readTimer(Core::Metrics::DeviceRead);
+
     try {
         // 获取当前时间戳
-        qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+        qint64 timestamp = Core::Timebase::nowNs();
 
         // 获取通道数
         int numChannels = m_config.channels.size();
@@ -396,9 +400,9 @@ void DAQDevice::processData(float64 *data, int32 read)
         const int maxProcessSamples = 100; // 减小处理样本数，降低内存占用
         int startSample = (read > maxProcessSamples) ? (read - maxProcessSamples) : 0;
 
-        static int logCounter = 0;
-        if (read > maxProcessSamples && ++logCounter % 100 == 0) {
-            qDebug() << "[DAQDevice] 数据量过大，只处理最新的" << maxProcessSamples << "个样本，总样本数:" << read;
+        if (read > maxProcessSamples) {
+            DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcDevice, "[DAQDevice] 数据量过大，只处理最新的 %d 个样本，总样本数: %d",
+                             maxProcessSamples, static_cast<int>(read));
         }
 
         // 每个通道的数据是交错存储的，需要解交错
@@ -421,6 +425,7 @@ void DAQDevice::processData(float64 *data, int32 read)
                         // 发送原始数据点 - 每个通道只发送最新的数据点，减少数据量
                         if (i == read - 1) {
                             emit rawDataPointReady(getDeviceId(), QString::number(channelId), rawValue, timestamp);
+                            Core::Metrics::increment(Core::Metrics::RawSamples);
                         }
                     }
                 }
@@ -437,86 +442,25 @@ void DAQDevice::processData(float64 *data, int32 read)
 
 void DAQDevice::calculateFilterCoefficients()
 {
-    // 重置滤波器系数
-    m_filterCoefficients.resize(m_filterOrder + 1);
-
-    // 归一化截止频率
-    double normalizedCutoff = m_cutoffFrequency / m_config.sampleRate;
-
-    // 限制截止频率在合理范围内
-    if (normalizedCutoff > 0.45) {
-        normalizedCutoff = 0.45; // 防止截止频率过高
-        m_cutoffFrequency = normalizedCutoff * m_config.sampleRate;
+    const bool clamped = m_cutoffFrequency / m_config.sampleRate > FirFilter::MAX_NORMALIZED_CUTOFF;
+    const double cutoffFrequency = m_filter.design(m_cutoffFrequency, m_config.sampleRate);
+    if (clamped) {
+        m_cutoffFrequency = cutoffFrequency; // 防止截止频率过高
         qDebug() << "[DAQDevice] 截止频率过高，已调整为:" << m_cutoffFrequency << "Hz";
     }
 
-    // 计算滤波器系数
-    double sum = 0.0;
-    for (int i = 0; i <= m_filterOrder; i++) {
-        // 计算滤波器系数
-        double coef;
-        if (i == m_filterOrder / 2) {
-            // 中心点
-            coef = 2.0 * normalizedCutoff;
-        } else {
-            // 其他点
-            double x = 2.0 * M_PI * normalizedCutoff * (i - m_filterOrder / 2.0);
-            coef = sin(x) / x;
-        }
-
-        // 应用Hamming窗函数 - 比汉宁窗有更好的侧带抑制
-        // Hamming窗函数: 0.54 - 0.46 * cos(2πn/N)
-        double hammingWindow = 0.54 - 0.46 * cos(2.0 * M_PI * i / m_filterOrder);
-        m_filterCoefficients[i] = coef * hammingWindow;
-        sum += m_filterCoefficients[i];
-    }
-
-    // 归一化系数，确保增益为1
-    for (int i = 0; i <= m_filterOrder; i++) {
-        m_filterCoefficients[i] /= sum;
-    }
-
-    qDebug() << "[DAQDevice] 已计算" << (m_filterOrder + 1) << "阶FIR滤波器系数，使用Hamming窗函数";
+    qDebug() << "[DAQDevice] 已计算" << (m_filter.order() + 1) << "阶FIR滤波器系数，使用Hamming窗函数";
     qDebug() << "[DAQDevice] 截止频率:" << m_cutoffFrequency << "Hz，采样率:" << m_config.sampleRate << "Hz";
 }
 
-double DAQDevice::applyFilter(double sample, int channelIndex)
+void DAQDevice::setCallbackThreadPlacement(const Core::ThreadPlacementConfig& placement)
 {
-    // 检查通道索引是否有效
-    if (channelIndex < 0 || channelIndex >= m_filterBuffers.size()) {
-        return sample; // 如果无效，返回原始样本
-    }
-
-    // 确保缓冲区大小正确
-    if (m_filterBuffers[channelIndex].size() != m_filterOrder + 1) {
-        m_filterBuffers[channelIndex].resize(m_filterOrder + 1);
-        m_filterBuffers[channelIndex].fill(sample); // 初始化为当前样本值，减少初始瞬态
-    }
-
-    // 移动缓冲区数据 - 使用更高效的方式
-    memmove(&m_filterBuffers[channelIndex][1], &m_filterBuffers[channelIndex][0], m_filterOrder * sizeof(double));
-
-    // 将新样本添加到缓冲区开头
-    m_filterBuffers[channelIndex][0] = sample;
-
-    // 应用FIR滤波器 - 使用向量化计算提高效率
-    double result = 0.0;
-
-    // 将卷积计算分成多个块以提高缓存命中率
-    const int blockSize = 16; // 适合现代CPU缓存线的块大小
-
-    for (int i = 0; i <= m_filterOrder; i += blockSize) {
-        double blockSum = 0.0;
-        int blockEnd = qMin(i + blockSize, m_filterOrder + 1);
-
-        for (int j = i; j < blockEnd; j++) {
-            blockSum += m_filterBuffers[channelIndex][j] * m_filterCoefficients[j];
-        }
-
-        result += blockSum;
-    }
+    m_callbackPlacement = placement;
+}
 
-    return result;
+double DAQDevice::applyFilter(double sample, int channelIndex)
+{
+    return m_filter.apply(sample, channelIndex);
 }
 
 QString DAQDevice::getDeviceChannelString() const
@@ -552,9 +496,16 @@ int32 ART_CALLBACK EveryNCallbackDAQ(TaskHandle taskHandle, int32 everyNsamplesE
         return -1;
     }
 
+    // 第一次在该驱动线程上回调时应用线程放置策略（CPU绑定和优先级）
+    static thread_local bool placementApplied = false;
+    if (!placementApplied) {
+        placementApplied = true;
+        Core::ThreadPlacement::applyToCurrentThread(g_daqDevice->m_callbackPlacement, "daq_callback");
+    }
+
     // 使用互斥锁保护访问，但设置超时，避免长时间阻塞
     if (!g_daqDevice->m_mutex.tryLock(100)) { // 100ms超时
-        qDebug() << "[DAQCallback] 无法获取互斥锁，跳过本次数据处理";
+        DAQ_LOG_EVERY_MS(1000, QtWarningMsg, lcDevice, "[DAQCallback] 无法获取互斥锁，跳过本次数据处理");
         return 0;
     }
 
@@ -593,11 +544,7 @@ int32 ART_CALLBACK EveryNCallbackDAQ(TaskHandle taskHandle, int32 everyNsamplesE
             delete[] data;
             return -1;
         } else if (read > 0) {
-            // 只在调试时输出详细信息，避免日志过多
-            static int counter = 0;
-            if (++counter % 100 == 0) {
-                qDebug() << "[DAQCallback] 成功读取" << read << "个样本，" << numChannels << "个通道";
-            }
+            DAQ_TRACE(lcDevice) << "[DAQCallback] 成功读取" << read << "个样本，" << numChannels << "个通道";
 
             // 解锁互斥锁，避免在处理数据时长时间持有锁
             g_daqDevice->m_mutex.unlock();
@@ -2,6 +2,7 @@
 #define DAQDEVICE_H
 
 #include "AbstractDevice.h"
+#include "FirFilter.h"
 #include "../Core/DataTypes.h"
 #include "../Include/Art_DAQ.h"
 #include <QObject>
@@ -74,6 +75,13 @@ public:
      */
     Core::DeviceType getDeviceType() const override;
 
+    /**
+     * @brief 设置驱动回调线程的放置策略
+     * 回调线程由驱动创建，在每个回调线程上第一次回调时应用一次
+     * @param placement 放置策略
+     */
+    void setCallbackThreadPlacement(const Core::ThreadPlacementConfig& placement);
+
 public slots:
     /**
      * @brief 设置滤波器启用状态
@@ -120,9 +128,8 @@ private:
     // 滤波器相关
     bool m_filterEnabled;                // 滤波器启用状态
     double m_cutoffFrequency;            // 截止频率
-    int m_filterOrder;                   // 滤波器阶数
-    QVector<QVector<double>> m_filterBuffers; // 滤波缓冲区
-    QVector<double> m_filterCoefficients;     // 滤波器系数
+    FirFilter m_filter;                  // FIR低通滤波器（每通道一个延迟线）
+    Core::ThreadPlacementConfig m_callbackPlacement; // 驱动回调线程的放置策略
 
     /**
      * @brief 处理数据
@@ -1,6 +1,8 @@
 #include "DeviceManager.h"
+#include "../Core/ThreadPlacement.h"
 #include <QThread>
 #include <QTimer>
+#include <QSet>
 
 namespace Device {
 
@@ -18,6 +20,11 @@ DeviceManager::~DeviceManager()
     qDebug() << "销毁设备管理器";
 }
 
+void DeviceManager::setThreadingConfig(const Core::ThreadingConfig& config)
+{
+    m_threadingConfig = config;
+}
+
 bool DeviceManager::createDevices(const QList<Core::DeviceConfig*>& configs)
 {
     bool success = true;
@@ -42,7 +49,11 @@ bool DeviceManager::createDevices(const QList<Core::DeviceConfig*>& configs)
             case Core::DeviceType::MODBUS: {
                 auto modbusConfig = dynamic_cast<Core::ModbusDeviceConfig*>(config);
                 if (modbusConfig) {
-                    device = new ModbusDevice(*modbusConfig, nullptr);
+                    if (modbusConfig->transport == "tcp") {
+                        device = new ModbusTcpDevice(*modbusConfig, nullptr);
+                    } else {
+                        device = new ModbusDevice(*modbusConfig, nullptr);
+                    }
                 }
                 break;
             }
@@ -74,6 +85,8 @@ bool DeviceManager::createDevices(const QList<Core::DeviceConfig*>& configs)
                 // 连接设备信号
                 connect(device, &AbstractDevice::rawDataPointReady,
                         this, &DeviceManager::rawDataPointReady);
+                connect(device, &AbstractDevice::rawDataBlockReady,
+                        this, &DeviceManager::rawDataBlockReady);
                 connect(device, &AbstractDevice::deviceStatusChanged,
                         this, &DeviceManager::deviceStatusChanged);
                 connect(device, &AbstractDevice::errorOccurred,
@@ -111,6 +124,8 @@ bool DeviceManager::createVirtualDevices(const QList<Core::VirtualDeviceConfig>&
             // 连接设备信号
             connect(device, &AbstractDevice::rawDataPointReady,
                     this, &DeviceManager::rawDataPointReady);
+            connect(device, &AbstractDevice::rawDataBlockReady,
+                    this, &DeviceManager::rawDataBlockReady);
             connect(device, &AbstractDevice::deviceStatusChanged,
                     this, &DeviceManager::deviceStatusChanged);
             connect(device, &AbstractDevice::errorOccurred,
@@ -132,8 +147,13 @@ bool DeviceManager::createModbusDevices(const QList<Core::ModbusDeviceConfig>& c
     bool success = true;
 
     for (const auto& config : configs) {
-        // 创建Modbus设备（不设置父对象，以便可以移动到线程）
-        ModbusDevice* device = new ModbusDevice(config, nullptr);
+        // 创建Modbus设备（不设置父对象，以便可以移动到线程），按传输方式选择串口或TCP
+        AbstractDevice* device = nullptr;
+        if (config.transport == "tcp") {
+            device = new ModbusTcpDevice(config, nullptr);
+        } else {
+            device = new ModbusDevice(config, nullptr);
+        }
 
         // 创建设备线程
         if (createDeviceThread(device)) {
@@ -143,6 +163,8 @@ bool DeviceManager::createModbusDevices(const QList<Core::ModbusDeviceConfig>& c
             // 连接设备信号
             connect(device, &AbstractDevice::rawDataPointReady,
                     this, &DeviceManager::rawDataPointReady);
+            connect(device, &AbstractDevice::rawDataBlockReady,
+                    this, &DeviceManager::rawDataBlockReady);
             connect(device, &AbstractDevice::deviceStatusChanged,
                     this, &DeviceManager::deviceStatusChanged);
             connect(device, &AbstractDevice::errorOccurred,
@@ -184,6 +206,8 @@ bool DeviceManager::createDAQDevices(const QList<Core::DAQDeviceConfig>& configs
             // 连接设备信号
             connect(device, &AbstractDevice::rawDataPointReady,
                     this, &DeviceManager::rawDataPointReady);
+            connect(device, &AbstractDevice::rawDataBlockReady,
+                    this, &DeviceManager::rawDataBlockReady);
             connect(device, &AbstractDevice::deviceStatusChanged,
                     this, &DeviceManager::deviceStatusChanged);
             connect(device, &AbstractDevice::errorOccurred,
@@ -232,6 +256,8 @@ bool DeviceManager::createECUDevices(const QList<Core::ECUDeviceConfig>& configs
             // 连接设备信号
             connect(device, &AbstractDevice::rawDataPointReady,
                     this, &DeviceManager::rawDataPointReady);
+            connect(device, &AbstractDevice::rawDataBlockReady,
+                    this, &DeviceManager::rawDataBlockReady);
             connect(device, &AbstractDevice::deviceStatusChanged,
                     this, &DeviceManager::deviceStatusChanged);
             connect(device, &AbstractDevice::errorOccurred,
@@ -376,8 +402,39 @@ bool DeviceManager::createDeviceThread(AbstractDevice* device)
         return false;
     }
 
+    const QString deviceId = device->getDeviceId();
+
+    // DAQ的数据处理在驱动回调线程中执行，回调线程的放置策略交给设备在第一次回调时应用
+    if (auto daqDevice = qobject_cast<DAQDevice*>(device)) {
+        daqDevice->setCallbackThreadPlacement(m_threadingConfig.daqCallback);
+    }
+
+    // 查找设备所属的线程组
+    const Core::DeviceThreadGroupConfig* group = nullptr;
+    for (const auto& candidate : m_threadingConfig.deviceGroups) {
+        if (candidate.deviceIds.contains(deviceId)) {
+            group = &candidate;
+            break;
+        }
+    }
+
+    // 同组的后续设备直接移动到已运行的共用线程
+    if (group && m_groupThreads.contains(group->name)) {
+        QThread* thread = m_groupThreads.value(group->name);
+        qDebug() << "将设备" << deviceId << "移动到共用线程" << group->name;
+        device->moveToThread(thread);
+        connect(thread, &QThread::finished, device, &QObject::deleteLater);
+        m_deviceThreads[deviceId] = thread;
+        return true;
+    }
+
     // 创建线程（不设置父对象，以便可以在cleanup中删除）
     QThread* thread = new QThread();
+    if (group) {
+        Core::ThreadPlacement::applyOnStart(thread, group->placement, group->name);
+    } else {
+        Core::ThreadPlacement::applyOnStart(thread, m_threadingConfig.devices, deviceId);
+    }
 
     // 将设备移动到线程
     qDebug() << "将设备" << device->getDeviceId() << "移动到线程" << thread;
@@ -403,9 +460,12 @@ bool DeviceManager::createDeviceThread(AbstractDevice* device)
     }
 
     // 添加到线程映射
-    m_deviceThreads[device->getDeviceId()] = thread;
+    m_deviceThreads[deviceId] = thread;
+    if (group) {
+        m_groupThreads[group->name] = thread;
+    }
 
-    qDebug() << "创建设备线程成功:" << device->getDeviceId();
+    qDebug() << "创建设备线程成功:" << deviceId << (group ? "线程组:" + group->name : QString());
     return true;
 }
 
@@ -417,9 +477,10 @@ void DeviceManager::cleanup()
     // 断开所有设备
     disconnectAllDevices();
 
-    // 停止并删除所有线程
-    for (auto it = m_deviceThreads.begin(); it != m_deviceThreads.end(); ++it) {
-        QThread* thread = it.value();
+    // 停止并删除所有线程（同组设备共用一个线程，只处理一次）
+    const QList<QThread*> threadList = m_deviceThreads.values();
+    const QSet<QThread*> threads(threadList.begin(), threadList.end());
+    for (QThread* thread : threads) {
         if (thread) {
             thread->quit();
             thread->wait();
@@ -429,6 +490,7 @@ void DeviceManager::cleanup()
 
     // 清空映射
     m_deviceThreads.clear();
+    m_groupThreads.clear();
     m_devices.clear();
 
     qDebug() << "清理设备和线程完成";
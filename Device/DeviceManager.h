@@ -10,6 +10,7 @@
 #include "AbstractDevice.h"
 #include "VirtualDevice.h"
 #include "ModbusDevice.h"
+#include "ModbusTcpDevice.h"
 #include "DAQDevice.h"
 #include "ECUDevice.h"
 
@@ -42,6 +43,13 @@ public:
      */
     bool createDevices(const QList<Core::DeviceConfig*>& configs);
 
+    /**
+     * @brief 设置线程配置（CPU绑定、优先级和设备线程分组）
+     * 必须在创建设备之前调用，对已创建的设备线程不生效
+     * @param config 线程配置
+     */
+    void setThreadingConfig(const Core::ThreadingConfig& config);
+
     /**
      * @brief 创建虚拟设备
      * @param configs 虚拟设备配置列表
@@ -124,6 +132,13 @@ signals:
      */
     void rawDataPointReady(QString deviceId, QString hardwareChannel, double rawValue, qint64 timestamp);
 
+    /**
+     * @brief 原始样本块就绪信号
+     * @param deviceId 设备ID
+     * @param block 样本块
+     */
+    void rawDataBlockReady(QString deviceId, Core::RawSampleBlock block);
+
     /**
      * @brief 设备状态变化信号
      * @param deviceId 设备ID
@@ -142,6 +157,7 @@ signals:
 private:
     /**
      * @brief 创建设备线程
+     * 属于线程组的设备移动到该组的共用线程（第一个设备创建时启动），其余设备各自创建线程
      * @param device 设备指针
      * @return 是否成功创建线程
      */
@@ -154,7 +170,9 @@ private:
 
 private:
     QMap<QString, AbstractDevice*> m_devices;    // 设备映射（设备ID -> 设备指针）
-    QMap<QString, QThread*> m_deviceThreads;     // 设备线程映射（设备ID -> 线程指针）
+    QMap<QString, QThread*> m_deviceThreads;     // 设备线程映射（设备ID -> 线程指针，同组设备指向同一线程）
+    QMap<QString, QThread*> m_groupThreads;      // 共用线程映射（组名 -> 线程指针）
+    Core::ThreadingConfig m_threadingConfig;     // 线程配置
 };
 
 } // namespace Device
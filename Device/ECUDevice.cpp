@@ -1,4 +1,9 @@
 #include "ECUDevice.h"
+#include "../Core/Log.h"
+#include "../Core/Metrics.h"
+#ifdef DAQ_SIMULATED_PEERS
+#include "../Simulation/ECUFrameGenerator.h"
+#endif
 #include <QDebug>
 #include <QThread>
 
@@ -9,8 +14,12 @@ ECUDevice::ECUDevice(const Core::ECUDeviceConfig& config, QObject *parent)
     , m_config(config)
     , m_serialPort(nullptr)
     , m_timer(nullptr)
+    , m_decoder(config.protocol, config.channels)
+    , m_frame(config.protocol.frameSize)
+    , m_values(m_decoder.fieldCount())
     , m_isAcquiring(false)
     , m_lastDataTime(0)
+    , m_simulator(nullptr)
 {
     qDebug() << "[ECUDevice] 构造函数开始，设备:" << config.instanceName
              << "线程ID:" << QThread::currentThreadId();
@@ -28,6 +37,10 @@ ECUDevice::ECUDevice(const Core::ECUDeviceConfig& config, QObject *parent)
     m_timer->setInterval(m_config.readCycleMs);
     qDebug() << "[ECUDevice] 定时器间隔设置为:" << m_config.readCycleMs << "毫秒";
 
+    m_parser.setProtocol(m_config.protocol);
+    m_parser.setByteTimeNs(m_config.serialConfig.characterTimeUs() * 1000.0);
+    m_frame.resize(qMax(m_frame.size(), m_parser.frameSize()));
+
     // 初始化通道参数映射
     for (auto it = m_config.channels.begin(); it != m_config.channels.end(); ++it) {
         m_channelParams[it.key()] = it.value().channelParams;
@@ -127,8 +140,12 @@ bool ECUDevice::configureSerialPort()
         return false;
     }
 
-    // 设置串口名称
+    // 设置串口名称（模拟时为模拟线路的伪终端）
+#ifdef DAQ_SIMULATED_PEERS
+    m_serialPort->setPortName(m_simulator ? m_simulator->portName() : m_config.serialConfig.port);
+#else
     m_serialPort->setPortName(m_config.serialConfig.port);
+#endif
 
     // 设置波特率
     switch (m_config.serialConfig.baudrate) {
@@ -207,6 +224,26 @@ bool ECUDevice::connectDevice()
         qDebug() << "[ECUDevice] 串口对象初始化成功";
     }
 
+    // 首次连接时启动模拟ECU
+#ifdef DAQ_SIMULATED_PEERS
+    if (m_config.serialConfig.simulated && !m_simulator) {
+        m_simulator = new Simulation::ECUFrameGenerator(m_config.protocol, m_config.serialConfig, this);
+        m_simulator->setFrameRate(m_config.serialConfig.simulatedFrameRate);
+        m_simulator->setCorruptionRate(m_config.serialConfig.simulatedCorruptionRate);
+        if (!m_simulator->start()) {
+            setStatus(Core::StatusCode::ERROR_CONNECTION, "ECU模拟帧发生器启动失败");
+            delete m_simulator;
+            m_simulator = nullptr;
+            return false;
+        }
+    }
+#else
+    if (m_config.serialConfig.simulated) {
+        setStatus(Core::StatusCode::ERROR_CONFIG, "未启用模拟对端，无法使用simulated串口（构建时开启DAQ_SIMULATED_PEERS）");
+        return false;
+    }
+#endif
+
     // 如果已经连接，直接返回成功
     if (m_serialPort->isOpen()) {
         qDebug() << "ECU设备已连接，无需重新连接:" << m_config.instanceName;
@@ -241,7 +278,8 @@ bool ECUDevice::connectDevice()
         }
     }
 
-    if (!portFound) {
+    // 伪终端不在系统串口列表中
+    if (!portFound && !m_simulator) {
         QString errorMsg = QString("串口不存在: %1").arg(m_serialPort->portName());
         qDebug() << "[ECUDevice] " << errorMsg;
         setStatus(Core::StatusCode::ERROR_CONFIG, errorMsg);
@@ -257,7 +295,7 @@ bool ECUDevice::connectDevice()
     }
 
     // 清空缓冲区
-    m_buffer.clear();
+    m_parser.reset();
 
     qDebug() << "ECU设备连接成功:" << m_config.instanceName
              << "串口:" << m_config.serialConfig.port;
@@ -313,7 +351,7 @@ void ECUDevice::startAcquisition()
     m_isAcquiring = true;
 
     // 清空缓冲区
-    m_buffer.clear();
+    m_parser.reset();
     qDebug() << "[ECUDevice] 缓冲区已清空";
 
     // 确保定时器在当前线程中启动
@@ -391,27 +429,20 @@ Core::DeviceType ECUDevice::getDeviceType() const
 
 void ECUDevice::readECUData()
 {
-    // 减少日志输出频率，使用静态计数器
-    static int logCounter = 0;
-    bool shouldLog = (++logCounter % 100 == 0);
-
-    if (shouldLog) {
-        qDebug() << "[ECUDevice] 定时器触发读取ECU数据，设备:" << getDeviceId()
-                 << "线程ID:" << QThread::currentThreadId()
-                 << "状态:" << Core::statusCodeToString(m_status);
-    }
+    DAQ_TRACE(lcDevice) << "[ECUDevice] 定时器触发读取ECU数据，设备:" << getDeviceId()
+             << "线程ID:" << QThread::currentThreadId()
+             << "状态:" << Core::statusCodeToString(m_status);
 
     // 如果不在采集状态，直接返回
     if (!m_isAcquiring) {
-        if (shouldLog) {
-            qDebug() << "[ECUDevice] 设备不在采集状态，跳过数据读取";
-        }
+        DAQ_TRACE(lcDevice) << "[ECUDevice] 设备不在采集状态，跳过数据读取";
         return;
     }
 
     // 如果串口未打开，尝试重新打开而不是重新连接
     if (!m_serialPort || !m_serialPort->isOpen()) {
-        qDebug() << "[ECUDevice] 警告：串口未打开，尝试重新打开...";
+        DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcDevice, "[ECUDevice] 警告：串口未打开，尝试重新打开... 设备: %s",
+                         qUtf8Printable(getDeviceId()));
 
         if (m_serialPort) {
             // 尝试重新打开串口
@@ -421,7 +452,7 @@ void ECUDevice::readECUData()
                 m_serialPort->clear();
             } else {
                 QString errorMsg = QString("无法打开串口: %1 - %2").arg(m_config.serialConfig.port).arg(m_serialPort->errorString());
-                qDebug() << "[ECUDevice] " << errorMsg;
+                DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcDevice, "[ECUDevice] %s", qUtf8Printable(errorMsg));
 
                 // 限制错误报告频率，避免日志刷屏
                 static QDateTime lastErrorTime;
@@ -444,23 +475,20 @@ void ECUDevice::readECUData()
     // 检查是否有数据可读
     qint64 bytesAvailable = m_serialPort->bytesAvailable();
 
-    // 减少日志输出频率，只在有数据或应该记录日志时输出
-    if (bytesAvailable > 0 || shouldLog) {
-        qDebug() << "[ECUDevice] 串口可读字节数:" << bytesAvailable;
-    }
+    DAQ_TRACE(lcDevice) << "[ECUDevice] 串口可读字节数:" << bytesAvailable;
 
     if (bytesAvailable > 0) {
-        qDebug() << "[ECUDevice] 有数据可读，处理数据...";
         handleSerialData();
-    } else if (shouldLog) {
-        qDebug() << "[ECUDevice] 没有数据可读，等待设备自动发送数据...";
+    } else {
+        DAQ_TRACE(lcDevice) << "[ECUDevice] 没有数据可读，等待设备自动发送数据...";
 
         // 检查自上次收到数据以来的时间
-        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+        qint64 currentTime = Core::Timebase::nowNs();
 
         // 如果超过10秒没有收到数据，尝试清空缓冲区
-        if (m_lastDataTime > 0 && (currentTime - m_lastDataTime) > 10000) {
-            qDebug() << "[ECUDevice] 超过10秒未收到数据，清空串口缓冲区";
+        if (m_lastDataTime > 0 && (currentTime - m_lastDataTime) > 10 * Core::Timebase::NS_PER_SECOND) {
+            DAQ_LOG_EVERY_MS(10000, QtWarningMsg, lcDevice, "[ECUDevice] 超过10秒未收到数据，清空串口缓冲区 设备: %s",
+                             qUtf8Printable(getDeviceId()));
             m_serialPort->clear();
             // 不更新m_lastDataTime，只在实际收到数据时更新
         }
@@ -471,319 +499,66 @@ void ECUDevice::handleSerialData()
 {
     QMutexLocker locker(&m_mutex);
 
-    // 读取所有可用数据
-    QByteArray data = m_serialPort->readAll();
-    if (data.isEmpty()) {
+    if (!m_serialPort) {
         return;
     }
 
-    // 更新最后接收数据的时间
-    m_lastDataTime = QDateTime::currentMSecsSinceEpoch();
-
-    // 打印接收到的原始数据（十六进制格式）
-    QString hexData;
-    for (int i = 0; i < data.size(); ++i) {
-        hexData += QString("%1 ").arg(static_cast<quint8>(data.at(i)), 2, 16, QChar('0'));
-    }
-    qDebug() << "[ECUDevice] 接收到数据:" << hexData << "大小:" << data.size() << "字节";
-
-    // 添加到缓冲区
-    m_buffer.append(data);
-    qDebug() << "[ECUDevice] 当前缓冲区大小:" << m_buffer.size() << "字节";
-
-    // 检查是否有完整的帧
-    // 帧格式: 0x7F 0x7F [数据...] [校验和] 0x0D 0x0A
-    // 帧总长度为17字节
-    const QByteArray frameHeader = QByteArray("\x7F\x7F", 2);
-    const QByteArray frameFooter = QByteArray("\x0D\x0A", 2);
-
-    qDebug() << "[ECUDevice] 查找帧头(0x7F 0x7F)和帧尾(0x0D 0x0A)";
+    Core::Metrics::ScopedTimer readTimer(Core::Metrics::DeviceRead);
 
-    // 处理接收到的数据
-    while (m_buffer.size() >= 17) {  // 最小帧长度
-        // 查找帧头 (0x7F 0x7F)
-        int startPos = m_buffer.indexOf(frameHeader);
+    // 串口数据直接读入解析器的环形缓冲区，缓冲区满时先解析再继续读取
+    qint64 received = 0;
+    qint64 count = 0;
+    while ((count = m_parser.readFrom(m_serialPort, Core::Timebase::nowNs())) > 0) {
+        received += count;
 
-        if (startPos < 0) {
-            // 没有找到帧头，清空缓冲区
-            qDebug() << "[ECUDevice] 未找到帧头，清空缓冲区";
-            m_buffer.clear();
-            break;
-        }
-
-        // 移除帧头之前的数据
-        if (startPos > 0) {
-            qDebug() << "[ECUDevice] 移除帧头之前的" << startPos << "字节数据";
-            m_buffer.remove(0, startPos);
-        }
-
-        // 检查是否有完整的帧
-        if (m_buffer.size() < 17) {
-            // 数据不足，等待更多数据
-            qDebug() << "[ECUDevice] 数据不足，等待更多数据";
-            break;
+        while (m_parser.nextFrame(m_frame.data())) {
+            emitChannelData(m_frame.constData(), m_parser.frameTimestampNs());
         }
-
-        // 检查帧尾 (0x0D 0x0A)
-        if (static_cast<unsigned char>(m_buffer.at(15)) == 0x0D &&
-            static_cast<unsigned char>(m_buffer.at(16)) == 0x0A) {
-
-            // 提取完整帧
-            QByteArray frame = m_buffer.mid(0, 17);
-
-            // 打印帧内容（十六进制格式）
-            QString frameHex;
-            for (int i = 0; i < frame.size(); ++i) {
-                frameHex += QString("%1 ").arg(static_cast<quint8>(frame.at(i)), 2, 16, QChar('0'));
-            }
-            qDebug() << "[ECUDevice] 提取完整帧:" << frameHex << "大小:" << frame.size() << "字节";
-
-            // 验证校验和
-            if (validateChecksum(frame)) {
-                qDebug() << "[ECUDevice] 校验和验证通过";
-
-                // 解析帧数据
-                ECUFrameData frameData;
-                if (parseFrame(frame, frameData)) {
-                    qDebug() << "[ECUDevice] 帧解析成功:";
-                    qDebug() << "  - 发动机转速:" << frameData.engineSpeed << "rpm";
-                    qDebug() << "  - 节气门开度:" << frameData.throttlePosition << "%";
-                    qDebug() << "  - 缸温:" << frameData.cylinderTemp << "°C";
-                    qDebug() << "  - 排温:" << frameData.exhaustTemp << "°C";
-                    qDebug() << "  - 燃油压力:" << frameData.fuelPressure << "kPa";
-                    qDebug() << "  - 转子温度:" << frameData.rotorTemp << "°C";
-                    qDebug() << "  - 进气温度:" << frameData.intakeTemp << "°C";
-                    qDebug() << "  - 进气压力:" << frameData.intakePressure;
-                    qDebug() << "  - 供电电压:" << frameData.supplyVoltage << "V";
-
-                    // 发送数据到通道
-                    emitChannelData(frameData);
-                } else {
-                    qDebug() << "[ECUDevice] 帧解析失败";
-                }
-            } else {
-                qDebug() << "[ECUDevice] 校验和验证失败，丢弃帧";
-            }
-
-            // 移除已处理的帧
-            m_buffer.remove(0, 17);
-            qDebug() << "[ECUDevice] 从缓冲区移除已处理帧，剩余字节:" << m_buffer.size();
-        } else {
-            // 帧尾不匹配，移除第一个字节并继续寻找帧头
-            qDebug() << "[ECUDevice] 帧尾不匹配，移除第一个字节并继续寻找";
-            m_buffer.remove(0, 1);
-        }
-    }
-
-    // 如果缓冲区过大，清除旧数据
-    if (m_buffer.size() > 1024) {
-        m_buffer.clear();
-        qDebug() << "[ECUDevice] 缓冲区过大，已清空:" << m_config.instanceName;
-    }
-}
-
-bool ECUDevice::validateChecksum(const QByteArray &frame)
-{
-    if (frame.size() < 15) {
-        qDebug() << "[ECUDevice] 帧长度不足，无法验证校验和";
-        return false;
     }
 
-    unsigned char calculatedChecksum = 0;
-    for (int i = 0; i <= 13; ++i) {
-        calculatedChecksum += static_cast<unsigned char>(frame.at(i));
+    if (received == 0) {
+        return;
     }
 
-    unsigned char receivedChecksum = static_cast<unsigned char>(frame.at(14));
-
-    bool isValid = (calculatedChecksum == receivedChecksum);
-    qDebug() << "[ECUDevice] 校验和验证:"
-             << "计算值=" << QString("0x%1").arg(calculatedChecksum, 2, 16, QChar('0'))
-             << "接收值=" << QString("0x%1").arg(receivedChecksum, 2, 16, QChar('0'))
-             << "结果=" << (isValid ? "通过" : "失败");
-
-    return isValid;
-}
-
-bool ECUDevice::parseFrame(const QByteArray &frame, ECUFrameData &data)
-{
-    // 检查帧长度是否足够
-    if (frame.size() < 17) {
-        qDebug() << "[ECUDevice] ECU帧长度不足:" << frame.size() << "，需要至少17字节";
-        return false;
+    // 更新最后接收数据的时间
+    m_lastDataTime = Core::Timebase::nowNs();
+
+    // 定期输出解析统计
+    if (!m_sinceStatistics.isValid()) {
+        m_sinceStatistics.start();
+    } else if (m_sinceStatistics.elapsed() >= 5000) {
+        const ECUFrameParser::Statistics stats = m_parser.takeStatistics();
+        qDebug() << "[ECUDevice] 帧解析统计 - 设备:" << getDeviceId()
+                 << "有效帧:" << stats.frames
+                 << "校验和错误:" << stats.checksumErrors
+                 << "帧尾错误:" << stats.footerErrors
+                 << "丢弃字节:" << stats.discardedBytes
+                 << "溢出字节:" << stats.overflowBytes
+                 << "帧间隔(平均/最小/最大):" << stats.meanIntervalUs << "/" << stats.minIntervalUs
+                 << "/" << stats.maxIntervalUs << "微秒"
+                 << "抖动:" << stats.jitterUs << "微秒";
+#ifdef DAQ_SIMULATED_PEERS
+        if (m_simulator) {
+            const Simulation::ECUFrameGenerator::Statistics simulated = m_simulator->takeStatistics();
+            qDebug() << "[ECUDevice] 模拟ECU统计 - 发送帧:" << simulated.frames
+                     << "损坏帧:" << simulated.corruptedFrames
+                     << "线路饱和跳过:" << simulated.skippedFrames
+                     << "线路占用率:" << simulated.line.txUtilization
+                     << "接收溢出字节:" << simulated.line.bytesDropped;
+        }
+#endif
+        m_sinceStatistics.restart();
     }
-
-    // 打印帧的每个字节（十六进制格式）
-    qDebug() << "[ECUDevice] 开始解析帧，帧长度:" << frame.size() << "字节";
-    qDebug() << "[ECUDevice] 帧头(0-1):"
-             << QString("0x%1 0x%2").arg(static_cast<quint8>(frame.at(0)), 2, 16, QChar('0'))
-             .arg(static_cast<quint8>(frame.at(1)), 2, 16, QChar('0'));
-
-    // 解析转速 (字节2-3) - 直接转为float
-    quint8 byte2 = static_cast<quint8>(frame.at(2));
-    quint8 byte3 = static_cast<quint8>(frame.at(3));
-    quint16 rawEngineSpeed = byte2 | (static_cast<quint16>(byte3) << 8);
-    data.engineSpeed = static_cast<float>(rawEngineSpeed);
-    qDebug() << "[ECUDevice] 转速字节:" << QString("0x%1 0x%2").arg(byte2, 2, 16, QChar('0')).arg(byte3, 2, 16, QChar('0'));
-
-    // 解析节气门开度 (字节4-5) - 原始值需除以10.0得到百分比
-    quint8 byte4 = static_cast<quint8>(frame.at(4));
-    quint8 byte5 = static_cast<quint8>(frame.at(5));
-    quint16 rawThrottlePosition = byte4 | (static_cast<quint16>(byte5) << 8);
-    data.throttlePosition = static_cast<float>(rawThrottlePosition) / 10.0f;
-    qDebug() << "[ECUDevice] 节气门开度字节:" << QString("0x%1 0x%2").arg(byte4, 2, 16, QChar('0')).arg(byte5, 2, 16, QChar('0'));
-
-    // 解析缸温 (字节6) - 原始值减去偏移量后转为float
-    qint8 byte6 = static_cast<qint8>(frame.at(6));
-    data.cylinderTemp = static_cast<float>(byte6 - 40);
-    qDebug() << "[ECUDevice] 缸温字节:" << QString("0x%1").arg(static_cast<quint8>(byte6), 2, 16, QChar('0'));
-
-    // 解析排温 (字节7) - 原始值乘以系数后转为float
-    quint8 byte7 = static_cast<quint8>(frame.at(7));
-    data.exhaustTemp = static_cast<float>(byte7 * 5.0 - 40.0);
-    qDebug() << "[ECUDevice] 排温字节:" << QString("0x%1").arg(byte7, 2, 16, QChar('0'));
-
-    // 解析燃油压力 (字节8-9) - 直接转为float
-    quint8 byte8 = static_cast<quint8>(frame.at(8));
-    quint8 byte9 = static_cast<quint8>(frame.at(9));
-    quint16 rawFuelPressure = byte8 | (static_cast<quint16>(byte9) << 8);
-    data.fuelPressure = static_cast<float>(rawFuelPressure);
-    qDebug() << "[ECUDevice] 燃油压力字节:" << QString("0x%1 0x%2").arg(byte8, 2, 16, QChar('0')).arg(byte9, 2, 16, QChar('0'));
-
-    // 解析转子温度 (字节10) - 原始值减去偏移量后转为float
-    qint8 byte10 = static_cast<qint8>(frame.at(10));
-    data.rotorTemp = static_cast<float>(byte10 - 40);
-    qDebug() << "[ECUDevice] 转子温度字节:" << QString("0x%1").arg(static_cast<quint8>(byte10), 2, 16, QChar('0'));
-
-    // 解析进气温度 (字节11) - 原始值减去偏移量后转为float
-    qint8 byte11 = static_cast<qint8>(frame.at(11));
-    data.intakeTemp = static_cast<float>(byte11 - 40);
-    qDebug() << "[ECUDevice] 进气温度字节:" << QString("0x%1").arg(static_cast<quint8>(byte11), 2, 16, QChar('0'));
-
-    // 解析进气压力 (字节12) - 直接转为float
-    quint8 byte12 = static_cast<quint8>(frame.at(12));
-    data.intakePressure = static_cast<float>(byte12);
-    qDebug() << "[ECUDevice] 进气压力字节:" << QString("0x%1").arg(byte12, 2, 16, QChar('0'));
-
-    // 解析供电电压 (字节13) - 原始值除以10.0得到电压
-    quint8 byte13 = static_cast<quint8>(frame.at(13));
-    data.supplyVoltage = static_cast<float>(byte13) / 10.0f;
-    qDebug() << "[ECUDevice] 供电电压字节:" << QString("0x%1").arg(byte13, 2, 16, QChar('0'));
-
-    // 检查校验和和帧尾
-    qDebug() << "[ECUDevice] 校验和字节(14):" << QString("0x%1").arg(static_cast<quint8>(frame.at(14)), 2, 16, QChar('0'));
-    qDebug() << "[ECUDevice] 帧尾(15-16):"
-             << QString("0x%1 0x%2").arg(static_cast<quint8>(frame.at(15)), 2, 16, QChar('0'))
-             .arg(static_cast<quint8>(frame.at(16)), 2, 16, QChar('0'));
-
-    qDebug() << "[ECUDevice] 帧解析完成";
-    return true;
 }
 
-void ECUDevice::emitChannelData(const ECUFrameData &data)
+void ECUDevice::emitChannelData(const quint8 *frame, qint64 timestampNs)
 {
-    // 获取当前时间戳
-    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
-    qDebug() << "[ECUDevice] 发送通道数据，时间戳:" << timestamp;
-
-    int channelCount = 0;
-
-    // 发送各个通道的数据
-    if (m_channelParams.contains("speed")) {
-        double value = applyFilter(static_cast<double>(data.engineSpeed));
-        qDebug() << "[ECUDevice] 发送通道数据 - speed:" << value;
-        emit rawDataPointReady(getDeviceId(), "speed", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 speed 通道";
-    }
-
-    if (m_channelParams.contains("throttle_position")) {
-        // 节气门开度已经在解析时除以10转换为百分比
-        double value = applyFilter(static_cast<double>(data.throttlePosition));
-        qDebug() << "[ECUDevice] 发送通道数据 - throttle_position:" << value;
-        emit rawDataPointReady(getDeviceId(), "throttle_position", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 throttle_position 通道";
-    }
-
-    if (m_channelParams.contains("cylinder_temp")) {
-        double value = applyFilter(static_cast<double>(data.cylinderTemp));
-        qDebug() << "[ECUDevice] 发送通道数据 - cylinder_temp:" << value;
-        emit rawDataPointReady(getDeviceId(), "cylinder_temp", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 cylinder_temp 通道";
-    }
-
-    if (m_channelParams.contains("exhaust_temp")) {
-        double value = applyFilter(static_cast<double>(data.exhaustTemp));
-        qDebug() << "[ECUDevice] 发送通道数据 - exhaust_temp:" << value;
-        emit rawDataPointReady(getDeviceId(), "exhaust_temp", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 exhaust_temp 通道";
-    }
-
-    if (m_channelParams.contains("fuel_pressure")) {
-        double value = applyFilter(static_cast<double>(data.fuelPressure));
-        qDebug() << "[ECUDevice] 发送通道数据 - fuel_pressure:" << value;
-        emit rawDataPointReady(getDeviceId(), "fuel_pressure", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 fuel_pressure 通道";
-    }
-
-    if (m_channelParams.contains("rotor_temp")) {
-        double value = applyFilter(static_cast<double>(data.rotorTemp));
-        qDebug() << "[ECUDevice] 发送通道数据 - rotor_temp:" << value;
-        emit rawDataPointReady(getDeviceId(), "rotor_temp", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 rotor_temp 通道";
-    }
-
-    if (m_channelParams.contains("intake_temp")) {
-        double value = applyFilter(static_cast<double>(data.intakeTemp));
-        qDebug() << "[ECUDevice] 发送通道数据 - intake_temp:" << value;
-        emit rawDataPointReady(getDeviceId(), "intake_temp", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 intake_temp 通道";
-    }
-
-    if (m_channelParams.contains("intake_pressure")) {
-        double value = applyFilter(static_cast<double>(data.intakePressure));
-        qDebug() << "[ECUDevice] 发送通道数据 - intake_pressure:" << value;
-        emit rawDataPointReady(getDeviceId(), "intake_pressure", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 intake_pressure 通道";
-    }
-
-    if (m_channelParams.contains("supply_voltage")) {
-        double value = applyFilter(static_cast<double>(data.supplyVoltage));
-        qDebug() << "[ECUDevice] 发送通道数据 - supply_voltage:" << value;
-        emit rawDataPointReady(getDeviceId(), "supply_voltage", value, timestamp);
-        channelCount++;
-    } else {
-        qDebug() << "[ECUDevice] 通道映射中不存在 supply_voltage 通道";
-    }
-
-    qDebug() << "[ECUDevice] 总共发送了" << channelCount << "个通道的数据";
-
-    // 打印通道映射信息（仅在第一次发送数据时）
-    static bool firstTime = true;
-    if (firstTime) {
-        qDebug() << "[ECUDevice] 通道映射信息:";
-        for (auto it = m_channelParams.begin(); it != m_channelParams.end(); ++it) {
-            qDebug() << "  - 通道名称:" << it.key()
-                     << "增益:" << it.value().gain
-                     << "偏移:" << it.value().offset;
-        }
-        firstTime = false;
+    // 按解码表一次提取全部字段
+    m_decoder.decode(frame, m_values.data());
+    for (int i = 0; i < m_decoder.fieldCount(); ++i) {
+        emit rawDataPointReady(getDeviceId(), m_decoder.hardwareChannel(i), applyFilter(m_values[i]), timestampNs);
     }
+    Core::Metrics::increment(Core::Metrics::RawSamples, static_cast<quint64>(m_decoder.fieldCount()));
 }
 
 } // namespace Device
@@ -8,29 +8,20 @@
 #include <QSerialPortInfo>
 #include <QMap>
 #include <QMutex>
-#include <QByteArray>
+#include <QElapsedTimer>
+#include <QVector>
+#include "ECUFrameParser.h"
+#include "ECUFrameDecoder.h"
 
-namespace Device {
+namespace Simulation {
+class ECUFrameGenerator;
+}
 
-/**
- * @brief ECU帧数据结构体
- * 存储ECU设备发送的各种数据
- */
-struct ECUFrameData {
-    float engineSpeed;        // 发动机转速 (rpm)
-    float throttlePosition;   // 节气门开度 (%)
-    float cylinderTemp;       // 缸温 (°C)
-    float exhaustTemp;        // 排温 (°C)
-    float fuelPressure;       // 燃油压力 (kPa)
-    float rotorTemp;          // 转子温度 (°C)
-    float intakeTemp;         // 进气温度 (°C)
-    float intakePressure;     // 进气压力
-    float supplyVoltage;      // 供电电压 (V)
-};
+namespace Device {
 
 /**
  * @brief ECU设备类
- * 用于与ECU设备通信
+ * 用于与ECU设备通信，帧格式和字段布局由配置中的protocol描述
  */
 class ECUDevice : public AbstractDevice
 {
@@ -110,35 +101,26 @@ private:
     bool configureSerialPort();
 
     /**
-     * @brief 解析ECU帧数据
-     * @param frame 接收到的数据帧
-     * @param data 解析后的数据结构
-     * @return 是否成功解析
-     */
-    bool parseFrame(const QByteArray &frame, ECUFrameData &data);
-
-    /**
-     * @brief 验证帧校验和
-     * @param frame 接收到的数据帧
-     * @return 校验和是否正确
-     */
-    bool validateChecksum(const QByteArray &frame);
-
-    /**
-     * @brief 发送数据到通道
-     * @param data 解析后的ECU数据
+     * @brief 解码一帧并发送各通道数据
+     * @param frame 已通过校验的数据帧
+     * @param timestampNs 帧到达时刻（Core::Timebase纳秒）
      */
-    void emitChannelData(const ECUFrameData &data);
+    void emitChannelData(const quint8 *frame, qint64 timestampNs);
 
 private:
     Core::ECUDeviceConfig m_config;  // ECU设备配置
     QSerialPort* m_serialPort;       // 串口对象
     QTimer* m_timer;                 // 定时器
-    QByteArray m_buffer;             // 数据缓冲区
+    ECUFrameParser m_parser;         // 环形缓冲区帧解析器
+    ECUFrameDecoder m_decoder;       // 帧字段解码表
+    QVector<quint8> m_frame;         // 当前帧（按协议帧长度预分配）
+    QVector<double> m_values;        // 解码结果（按字段数量预分配）
+    QElapsedTimer m_sinceStatistics; // 距上次输出解析统计
     bool m_isAcquiring;              // 是否正在采集
     QMutex m_mutex;                  // 互斥锁
     QMap<QString, Core::ChannelParams> m_channelParams; // 通道参数映射
-    qint64 m_lastDataTime;           // 最后接收数据的时间戳
+    qint64 m_lastDataTime;           // 最后接收数据的时间戳（Core::Timebase纳秒）
+    Simulation::ECUFrameGenerator* m_simulator; // 进程内模拟ECU（以DAQ_SIMULATED_PEERS构建且serial_config.simulated为true时）
 };
 
 } // namespace Device
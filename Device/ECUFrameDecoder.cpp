@@ -0,0 +1,67 @@
+#include "ECUFrameDecoder.h"
+#include <QDebug>
+
+namespace Device {
+
+ECUFrameDecoder::ECUFrameDecoder(const Core::ECUProtocolConfig& protocol, const QMap<QString, Core::ECUChannelConfig>& channels)
+{
+    for (const auto& fieldConfig : protocol.fields) {
+        if (!channels.contains(fieldConfig.name)) {
+            qDebug() << "[ECUFrameDecoder] 字段未配置通道，跳过:" << fieldConfig.name;
+            continue;
+        }
+        if (fieldConfig.byteOffset < 0 || fieldConfig.byteOffset + fieldConfig.width > protocol.frameSize) {
+            qDebug() << "[ECUFrameDecoder] 字段超出帧长度，跳过:" << fieldConfig.name;
+            continue;
+        }
+
+        Field field;
+        field.byteOffset = fieldConfig.byteOffset;
+        field.width = fieldConfig.width;
+        field.isSigned = fieldConfig.isSigned;
+        field.bigEndian = fieldConfig.byteOrder == "big";
+        field.scale = fieldConfig.scale;
+        field.offset = fieldConfig.offset;
+        field.hardwareChannel = fieldConfig.name;
+        m_fields.append(field);
+    }
+
+    for (auto it = channels.constBegin(); it != channels.constEnd(); ++it) {
+        bool found = false;
+        for (const auto& field : m_fields) {
+            found = found || field.hardwareChannel == it.key();
+        }
+        if (!found) {
+            qDebug() << "[ECUFrameDecoder] 通道在帧协议中没有对应字段:" << it.key();
+        }
+    }
+}
+
+void ECUFrameDecoder::decode(const quint8* frame, double* values) const
+{
+    for (int i = 0; i < m_fields.size(); ++i) {
+        const Field& field = m_fields[i];
+        const quint8* bytes = frame + field.byteOffset;
+
+        quint32 raw = 0;
+        for (int b = 0; b < field.width; ++b) {
+            const int index = field.bigEndian ? b : field.width - 1 - b;
+            raw = (raw << 8) | bytes[index];
+        }
+
+        double value;
+        if (!field.isSigned) {
+            value = static_cast<double>(raw);
+        } else if (field.width == 1) {
+            value = static_cast<double>(static_cast<qint8>(raw));
+        } else if (field.width == 2) {
+            value = static_cast<double>(static_cast<qint16>(raw));
+        } else {
+            value = static_cast<double>(static_cast<qint32>(raw));
+        }
+
+        values[i] = value * field.scale + field.offset;
+    }
+}
+
+} // namespace Device
@@ -0,0 +1,60 @@
+#ifndef ECUFRAMEDECODER_H
+#define ECUFRAMEDECODER_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include "../Core/DataTypes.h"
+
+namespace Device {
+
+/**
+ * @brief ECU帧解码表
+ * 启动时把ECUProtocolConfig的字段描述编译为解码表，只保留配置了通道的字段；
+ * 每帧按表顺序一次提取全部字段，不再按字段名查找通道映射。
+ */
+class ECUFrameDecoder
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param protocol 帧协议
+     * @param channels 通道映射（硬件通道名 -> 通道配置）
+     */
+    ECUFrameDecoder(const Core::ECUProtocolConfig& protocol, const QMap<QString, Core::ECUChannelConfig>& channels);
+
+    /**
+     * @brief 解码表中的字段数量
+     */
+    int fieldCount() const { return m_fields.size(); }
+
+    /**
+     * @brief 字段对应的硬件通道
+     * @param index 字段索引
+     */
+    const QString& hardwareChannel(int index) const { return m_fields[index].hardwareChannel; }
+
+    /**
+     * @brief 解码一帧
+     * @param frame 已通过校验的帧
+     * @param values 输出，至少fieldCount()个
+     */
+    void decode(const quint8* frame, double* values) const;
+
+private:
+    struct Field {
+        int byteOffset = 0;          // 帧内字节偏移
+        int width = 1;               // 字节宽度
+        bool isSigned = false;       // 是否有符号
+        bool bigEndian = false;      // 高字节在前
+        double scale = 1.0;          // 比例
+        double offset = 0.0;         // 偏移
+        QString hardwareChannel;     // 硬件通道
+    };
+
+    QVector<Field> m_fields;         // 解码表
+};
+
+} // namespace Device
+
+#endif // ECUFRAMEDECODER_H
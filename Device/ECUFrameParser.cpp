@@ -0,0 +1,275 @@
+#include "ECUFrameParser.h"
+#include <QIODevice>
+#include <QDebug>
+#include <cstring>
+#include <cmath>
+
+namespace Device {
+
+static_assert((ECUFrameParser::CAPACITY & (ECUFrameParser::CAPACITY - 1)) == 0, "容量必须是2的幂");
+
+ECUFrameParser::ECUFrameParser()
+    : m_readPos(0)
+    , m_size(0)
+    , m_state(State::Header)
+    , m_headerMatched(0)
+    , m_byteTimeNs(0.0)
+    , m_streamPosition(0)
+    , m_markHead(0)
+    , m_markCount(0)
+    , m_frameTimestampNs(0)
+    , m_lastFrameNs(-1)
+    , m_intervalMeanNs(0.0)
+    , m_intervalM2(0.0)
+    , m_intervalMinNs(0.0)
+    , m_intervalMaxNs(0.0)
+{
+    setProtocol(Core::ECUProtocolConfig::defaultProtocol());
+}
+
+void ECUFrameParser::setProtocol(const Core::ECUProtocolConfig &protocol)
+{
+    if (protocol.frameSize <= 0 || protocol.frameSize > MAX_FRAME_SIZE) {
+        qDebug() << "[ECUFrameParser] 帧长度超出范围:" << protocol.frameSize << "，使用默认协议";
+        setProtocol(Core::ECUProtocolConfig::defaultProtocol());
+        return;
+    }
+
+    m_frameSize = protocol.frameSize;
+    m_header = protocol.header;
+    m_footer = protocol.footer;
+    m_checksumOffset = protocol.checksumOffset;
+    m_checksumStart = protocol.checksumStart;
+    m_checksumEnd = protocol.checksumEnd;
+    reset();
+}
+
+void ECUFrameParser::setByteTimeNs(double byteTimeNs)
+{
+    m_byteTimeNs = qMax(0.0, byteTimeNs);
+}
+
+qint64 ECUFrameParser::readFrom(QIODevice *device, qint64 arrivalNs)
+{
+    qint64 total = 0;
+
+    // 空闲区域可能在缓冲区末尾折返，分两段读取
+    while (m_size < CAPACITY) {
+        const int writePos = (m_readPos + m_size) & MASK;
+        const int contiguous = qMin(CAPACITY - m_size, CAPACITY - writePos);
+        const qint64 count = device->read(reinterpret_cast<char *>(m_buffer.data() + writePos), contiguous);
+        if (count <= 0) {
+            break;
+        }
+        m_size += static_cast<int>(count);
+        total += count;
+    }
+
+    if (total > 0) {
+        markArrival(arrivalNs);
+    }
+
+    return total;
+}
+
+void ECUFrameParser::append(const char *data, int size, qint64 arrivalNs)
+{
+    // 数据比缓冲区还大时只保留最后CAPACITY字节
+    if (size > CAPACITY) {
+        m_statistics.overflowBytes += size - CAPACITY;
+        data += size - CAPACITY;
+        size = CAPACITY;
+    }
+
+    const int overflow = m_size + size - CAPACITY;
+    if (overflow > 0) {
+        m_statistics.overflowBytes += overflow;
+        consume(overflow);
+        m_state = State::Header;
+        m_headerMatched = 0;
+    }
+
+    const int writePos = (m_readPos + m_size) & MASK;
+    const int first = qMin(size, CAPACITY - writePos);
+    std::memcpy(m_buffer.data() + writePos, data, first);
+    std::memcpy(m_buffer.data(), data + first, size - first);
+    m_size += size;
+
+    if (size > 0) {
+        markArrival(arrivalNs);
+    }
+}
+
+bool ECUFrameParser::nextFrame(quint8 *frame)
+{
+    while (m_size > 0) {
+        if (m_state == State::Header) {
+            if (m_headerMatched >= m_header.size()) {
+                m_state = State::Body;
+                continue;
+            }
+            if (m_size <= m_headerMatched) {
+                return false;
+            }
+            if (at(m_headerMatched) == static_cast<quint8>(m_header.at(m_headerMatched))) {
+                ++m_headerMatched;
+            } else {
+                // 从下一个字节重新匹配帧头
+                consume(1);
+                ++m_statistics.discardedBytes;
+                m_headerMatched = 0;
+            }
+            continue;
+        }
+
+        if (m_size < m_frameSize) {
+            return false;
+        }
+
+        if (!validate()) {
+            // 丢弃一个字节，从下一个字节重新寻找帧头
+            consume(1);
+            ++m_statistics.discardedBytes;
+            m_state = State::Header;
+            m_headerMatched = 0;
+            continue;
+        }
+
+        const int first = qMin(m_frameSize, CAPACITY - m_readPos);
+        std::memcpy(frame, m_buffer.data() + m_readPos, first);
+        std::memcpy(frame + first, m_buffer.data(), m_frameSize - first);
+
+        // 由最后一个字节的到达时刻减去帧的传输时间得到第一个字节的到达时刻
+        const qint64 lastByteNs = arrivalTimeNs(m_streamPosition + m_frameSize - 1);
+        recordFrameTime(lastByteNs - static_cast<qint64>((m_frameSize - 1) * m_byteTimeNs));
+
+        consume(m_frameSize);
+        ++m_statistics.frames;
+        m_state = State::Header;
+        m_headerMatched = 0;
+        return true;
+    }
+
+    return false;
+}
+
+void ECUFrameParser::reset()
+{
+    m_readPos = 0;
+    m_size = 0;
+    m_state = State::Header;
+    m_headerMatched = 0;
+    m_streamPosition = 0;
+    m_markHead = 0;
+    m_markCount = 0;
+    m_lastFrameNs = -1;
+}
+
+ECUFrameParser::Statistics ECUFrameParser::takeStatistics()
+{
+    Statistics statistics = m_statistics;
+    if (statistics.intervals > 0) {
+        statistics.meanIntervalUs = m_intervalMeanNs / 1000.0;
+        statistics.minIntervalUs = m_intervalMinNs / 1000.0;
+        statistics.maxIntervalUs = m_intervalMaxNs / 1000.0;
+        statistics.jitterUs = statistics.intervals > 1
+            ? std::sqrt(m_intervalM2 / (statistics.intervals - 1)) / 1000.0
+            : 0.0;
+    }
+
+    m_statistics = Statistics();
+    m_intervalMeanNs = 0.0;
+    m_intervalM2 = 0.0;
+    return statistics;
+}
+
+void ECUFrameParser::markArrival(qint64 arrivalNs)
+{
+    // 记录已满时覆盖最旧的记录（只在长时间不取帧时发生）
+    if (m_markCount == MAX_MARKS) {
+        m_markHead = (m_markHead + 1) % MAX_MARKS;
+        --m_markCount;
+    }
+
+    ArrivalMark& mark = m_marks[(m_markHead + m_markCount) % MAX_MARKS];
+    mark.endPosition = m_streamPosition + m_size;
+    mark.timeNs = arrivalNs;
+    ++m_markCount;
+}
+
+qint64 ECUFrameParser::arrivalTimeNs(quint64 position) const
+{
+    // 找到包含该字节的那次读取，从读取时刻往前推算
+    for (int i = 0; i < m_markCount; ++i) {
+        const ArrivalMark& mark = m_marks[(m_markHead + i) % MAX_MARKS];
+        if (mark.endPosition > position) {
+            return mark.timeNs - static_cast<qint64>((mark.endPosition - 1 - position) * m_byteTimeNs);
+        }
+    }
+
+    return m_markCount > 0 ? m_marks[(m_markHead + m_markCount - 1) % MAX_MARKS].timeNs : 0;
+}
+
+void ECUFrameParser::recordFrameTime(qint64 timestampNs)
+{
+    m_frameTimestampNs = timestampNs;
+
+    if (m_lastFrameNs >= 0) {
+        const double interval = static_cast<double>(timestampNs - m_lastFrameNs);
+        const quint64 n = ++m_statistics.intervals;
+        if (n == 1) {
+            m_intervalMinNs = interval;
+            m_intervalMaxNs = interval;
+        } else {
+            m_intervalMinNs = qMin(m_intervalMinNs, interval);
+            m_intervalMaxNs = qMax(m_intervalMaxNs, interval);
+        }
+
+        const double delta = interval - m_intervalMeanNs;
+        m_intervalMeanNs += delta / n;
+        m_intervalM2 += delta * (interval - m_intervalMeanNs);
+    }
+
+    m_lastFrameNs = timestampNs;
+}
+
+bool ECUFrameParser::validate()
+{
+    // 就地验证帧尾
+    const int footerStart = m_frameSize - m_footer.size();
+    for (int i = 0; i < m_footer.size(); ++i) {
+        if (at(footerStart + i) != static_cast<quint8>(m_footer.at(i))) {
+            ++m_statistics.footerErrors;
+            return false;
+        }
+    }
+
+    // 就地验证累加和
+    if (m_checksumOffset >= 0) {
+        quint8 checksum = 0;
+        for (int i = m_checksumStart; i <= m_checksumEnd; ++i) {
+            checksum += at(i);
+        }
+        if (checksum != at(m_checksumOffset)) {
+            ++m_statistics.checksumErrors;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ECUFrameParser::consume(int count)
+{
+    m_readPos = (m_readPos + count) & MASK;
+    m_size -= count;
+    m_streamPosition += count;
+
+    // 丢弃只覆盖已消费数据的读取记录
+    while (m_markCount > 0 && m_marks[m_markHead].endPosition <= m_streamPosition) {
+        m_markHead = (m_markHead + 1) % MAX_MARKS;
+        --m_markCount;
+    }
+}
+
+} // namespace Device
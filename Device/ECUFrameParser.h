@@ -0,0 +1,162 @@
+#ifndef ECUFRAMEPARSER_H
+#define ECUFRAMEPARSER_H
+
+#include <QtGlobal>
+#include <QByteArray>
+#include <array>
+#include "../Core/DataTypes.h"
+
+class QIODevice;
+
+namespace Device {
+
+/**
+ * @brief ECU帧解析器
+ * 固定容量的环形缓冲区加增量状态机：串口数据直接读入环形缓冲区，
+ * 状态机逐字节匹配帧头，凑齐一帧后就地验证帧尾和校验和，
+ * 验证失败时丢弃一个字节重新同步。解析过程不移动缓冲区数据，也不为每帧分配内存。
+ *
+ * 每次读入数据时记录读取时刻，取出一帧时按字节在数据流中的位置和字节传输时间
+ * 反推该帧第一个字节的到达时刻，并统计相邻帧的间隔和抖动。
+ *
+ * 帧长度、帧头、帧尾和校验和位置来自ECUProtocolConfig，默认协议为17字节帧：
+ * 0x7F 0x7F [数据12字节] [校验和] 0x0D 0x0A，校验和为字节0-13的累加和（取低8位）。
+ */
+class ECUFrameParser
+{
+public:
+    static constexpr int MAX_FRAME_SIZE = 1024;   // 最大帧长度
+    static constexpr int CAPACITY = 4096;         // 环形缓冲区容量（2的幂）
+
+    /**
+     * @brief 解析统计
+     */
+    struct Statistics {
+        quint64 frames = 0;            // 有效帧数
+        quint64 checksumErrors = 0;    // 校验和错误
+        quint64 footerErrors = 0;      // 帧尾错误
+        quint64 discardedBytes = 0;    // 同步时丢弃的字节数
+        quint64 overflowBytes = 0;     // 缓冲区满时丢弃的字节数
+        quint64 intervals = 0;         // 帧间隔样本数
+        double meanIntervalUs = 0.0;   // 平均帧间隔（微秒）
+        double minIntervalUs = 0.0;    // 最小帧间隔（微秒）
+        double maxIntervalUs = 0.0;    // 最大帧间隔（微秒）
+        double jitterUs = 0.0;         // 帧间隔标准差（微秒）
+    };
+
+    ECUFrameParser();
+
+    /**
+     * @brief 设置帧格式（同时清空缓冲区）
+     * @param protocol 帧协议
+     */
+    void setProtocol(const Core::ECUProtocolConfig &protocol);
+
+    /**
+     * @brief 帧长度
+     */
+    int frameSize() const { return m_frameSize; }
+
+    /**
+     * @brief 设置一个字节在线路上的传输时间，用于反推帧到达时刻
+     * @param byteTimeNs 字节时间（纳秒）
+     */
+    void setByteTimeNs(double byteTimeNs);
+
+    /**
+     * @brief 从设备读取数据到环形缓冲区（直接写入空闲区域，不经过临时缓冲）
+     * @param device 数据来源
+     * @param arrivalNs 读取时刻（Core::Timebase纳秒），视为本次读到的最后一个字节的到达时刻
+     * @return 读取的字节数
+     */
+    qint64 readFrom(QIODevice *device, qint64 arrivalNs);
+
+    /**
+     * @brief 追加数据（缓冲区满时丢弃最旧的数据）
+     * @param data 数据
+     * @param size 字节数
+     * @param arrivalNs 最后一个字节的到达时刻（Core::Timebase纳秒）
+     */
+    void append(const char *data, int size, qint64 arrivalNs);
+
+    /**
+     * @brief 取出下一个有效帧
+     * @param frame 输出缓冲区，至少frameSize()字节
+     * @return 是否取到完整有效帧
+     */
+    bool nextFrame(quint8 *frame);
+
+    /**
+     * @brief 最近取出的帧第一个字节的到达时刻（Core::Timebase纳秒）
+     */
+    qint64 frameTimestampNs() const { return m_frameTimestampNs; }
+
+    /**
+     * @brief 清空缓冲区和解析状态
+     */
+    void reset();
+
+    /**
+     * @brief 缓冲区中未解析的字节数
+     */
+    int size() const { return m_size; }
+
+    /**
+     * @brief 取出并清零统计
+     */
+    Statistics takeStatistics();
+
+private:
+    enum class State {
+        Header,    // 匹配帧头
+        Body       // 已找到帧头，等待凑齐一帧
+    };
+
+    quint8 at(int offset) const { return m_buffer[(m_readPos + offset) & MASK]; }
+    void consume(int count);
+
+    /**
+     * @brief 一次读取的结束位置和时刻
+     */
+    struct ArrivalMark {
+        quint64 endPosition = 0;   // 读取后数据流的总字节数
+        qint64 timeNs = 0;         // 读取时刻
+    };
+
+    bool validate();
+    void markArrival(qint64 arrivalNs);
+    qint64 arrivalTimeNs(quint64 position) const;
+    void recordFrameTime(qint64 timestampNs);
+
+    static constexpr int MASK = CAPACITY - 1;
+
+    std::array<quint8, CAPACITY> m_buffer;   // 环形缓冲区
+    int m_readPos;                           // 读位置
+    int m_size;                              // 未解析字节数
+    State m_state;                           // 状态机状态
+    int m_headerMatched;                     // 已匹配的帧头字节数
+    int m_frameSize;                         // 帧长度
+    QByteArray m_header;                     // 帧头
+    QByteArray m_footer;                     // 帧尾
+    int m_checksumOffset;                    // 校验和偏移（小于0不校验）
+    int m_checksumStart;                     // 累加和起始字节
+    int m_checksumEnd;                       // 累加和结束字节（含）
+
+    static constexpr int MAX_MARKS = 64;
+    double m_byteTimeNs;                     // 字节传输时间
+    quint64 m_streamPosition;                // 读位置在数据流中的绝对位置
+    std::array<ArrivalMark, MAX_MARKS> m_marks; // 未消费数据的读取记录（环形）
+    int m_markHead;                          // 最旧的记录
+    int m_markCount;                         // 记录数
+    qint64 m_frameTimestampNs;               // 最近取出的帧的到达时刻
+    qint64 m_lastFrameNs;                    // 上一帧的到达时刻（-1表示没有）
+    double m_intervalMeanNs;                 // 帧间隔均值（Welford）
+    double m_intervalM2;                     // 帧间隔平方差和（Welford）
+    double m_intervalMinNs;                  // 最小帧间隔
+    double m_intervalMaxNs;                  // 最大帧间隔
+    Statistics m_statistics;                 // 解析统计
+};
+
+} // namespace Device
+
+#endif // ECUFRAMEPARSER_H
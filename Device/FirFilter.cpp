@@ -0,0 +1,89 @@
+#include "FirFilter.h"
+#include <QtMath>
+#include <cstring>
+
+namespace Device {
+
+FirFilter::FirFilter(int order)
+    : m_order(qMax(1, order))
+{
+    m_coefficients.fill(0.0, m_order + 1);
+}
+
+double FirFilter::design(double cutoffFrequency, double sampleRate)
+{
+    m_coefficients.resize(m_order + 1);
+
+    // 归一化截止频率，限制在合理范围内
+    double normalizedCutoff = cutoffFrequency / sampleRate;
+    if (normalizedCutoff > MAX_NORMALIZED_CUTOFF) {
+        normalizedCutoff = MAX_NORMALIZED_CUTOFF;
+    }
+
+    double sum = 0.0;
+    for (int i = 0; i <= m_order; i++) {
+        double coef;
+        if (i == m_order / 2) {
+            // 中心点
+            coef = 2.0 * normalizedCutoff;
+        } else {
+            double x = 2.0 * M_PI * normalizedCutoff * (i - m_order / 2.0);
+            coef = sin(x) / x;
+        }
+
+        // Hamming窗函数: 0.54 - 0.46 * cos(2πn/N)，比汉宁窗有更好的侧带抑制
+        double hammingWindow = 0.54 - 0.46 * cos(2.0 * M_PI * i / m_order);
+        m_coefficients[i] = coef * hammingWindow;
+        sum += m_coefficients[i];
+    }
+
+    // 归一化系数，确保增益为1
+    for (int i = 0; i <= m_order; i++) {
+        m_coefficients[i] /= sum;
+    }
+
+    return normalizedCutoff * sampleRate;
+}
+
+void FirFilter::setChannelCount(int channels)
+{
+    m_buffers.resize(qMax(0, channels));
+    for (QVector<double>& buffer : m_buffers) {
+        buffer.fill(0.0, m_order + 1);
+    }
+}
+
+double FirFilter::apply(double sample, int channelIndex)
+{
+    if (channelIndex < 0 || channelIndex >= m_buffers.size()) {
+        return sample;
+    }
+
+    QVector<double>& buffer = m_buffers[channelIndex];
+    if (buffer.size() != m_order + 1) {
+        // 初始化为当前样本值，减少初始瞬态
+        buffer.fill(sample, m_order + 1);
+    }
+
+    // 延迟线后移一位，新样本放在开头
+    double* history = buffer.data();
+    memmove(history + 1, history, m_order * sizeof(double));
+    history[0] = sample;
+
+    // 分块累加卷积
+    const double* coefficients = m_coefficients.constData();
+    const int blockSize = 16;
+    double result = 0.0;
+    for (int i = 0; i <= m_order; i += blockSize) {
+        double blockSum = 0.0;
+        const int blockEnd = qMin(i + blockSize, m_order + 1);
+        for (int j = i; j < blockEnd; j++) {
+            blockSum += history[j] * coefficients[j];
+        }
+        result += blockSum;
+    }
+
+    return result;
+}
+
+} // namespace Device
@@ -0,0 +1,56 @@
+#ifndef FIRFILTER_H
+#define FIRFILTER_H
+
+#include <QtGlobal>
+#include <QVector>
+
+namespace Device {
+
+/**
+ * @brief 多通道FIR低通滤波器
+ * 加Hamming窗的sinc低通，系数归一化为直流增益1；每个通道一个延迟线。
+ * 从DAQDevice中拆出，不依赖采集驱动，可单独测试和做基准测试。
+ */
+class FirFilter
+{
+public:
+    static constexpr int DEFAULT_ORDER = 128;          // 默认滤波器阶数
+    static constexpr double MAX_NORMALIZED_CUTOFF = 0.45; // 归一化截止频率上限
+
+    explicit FirFilter(int order = DEFAULT_ORDER);
+
+    /**
+     * @brief 计算滤波器系数
+     * @param cutoffFrequency 截止频率（Hz）
+     * @param sampleRate 采样率（Hz）
+     * @return 实际使用的截止频率（超过采样率的MAX_NORMALIZED_CUTOFF倍时被限制）
+     */
+    double design(double cutoffFrequency, double sampleRate);
+
+    /**
+     * @brief 设置通道数（所有延迟线清零）
+     * @param channels 通道数
+     */
+    void setChannelCount(int channels);
+
+    /**
+     * @brief 滤波一个样本
+     * @param sample 样本值
+     * @param channelIndex 通道索引（无效时原样返回）
+     * @return 滤波后的值
+     */
+    double apply(double sample, int channelIndex);
+
+    int order() const { return m_order; }
+    int channelCount() const { return m_buffers.size(); }
+    const QVector<double>& coefficients() const { return m_coefficients; }
+
+private:
+    int m_order;                           // 滤波器阶数
+    QVector<QVector<double>> m_buffers;    // 每个通道的延迟线（下标0为最新样本）
+    QVector<double> m_coefficients;        // 滤波器系数
+};
+
+} // namespace Device
+
+#endif // FIRFILTER_H
@@ -0,0 +1,147 @@
+#include "ModbusChannelMap.h"
+#include <QtEndian>
+#include <algorithm>
+#include <cstring>
+
+namespace Device {
+
+ModbusChannelMap::ModbusChannelMap(const QList<Core::ModbusSlaveConfig>& slaves)
+{
+    // 同一从站可能配置多个块（如功能码3和4各一块）：先按(从站ID,功能码)合并寄存器，再各生成一次解码计划
+    QMap<QPair<int, int>, QMap<int, Core::ModbusRegisterConfig>> blocks;
+    for (const auto& slave : slaves) {
+        QMap<int, Core::ModbusRegisterConfig>& block = blocks[qMakePair(slave.slaveId, slave.operationCommand)];
+        for (const auto& reg : slave.registers) {
+            block[reg.registerAddress] = reg;
+        }
+    }
+
+    for (auto blockIt = blocks.constBegin(); blockIt != blocks.constEnd(); ++blockIt) {
+        const int slaveId = blockIt.key().first;
+        const int functionCode = blockIt.key().second;
+
+        // 线圈和离散输入每个通道占一位，不做类型解码
+        const bool bitAccess = functionCode == 1 || functionCode == 2;
+
+        QVector<DecodeEntry>& plan = m_decodePlans[blockIt.key()];
+        plan.reserve(blockIt->size());
+        for (auto it = blockIt->constBegin(); it != blockIt->constEnd(); ++it) {
+            DecodeEntry entry;
+            entry.address = it.key();
+            entry.dataType = bitAccess ? DataType::UInt16 : parseDataType(it->dataType);
+            entry.count = bitAccess ? 1 : it->registerCount();
+            entry.swapBytes = !bitAccess && it->byteOrder == "little";
+            entry.swapWords = !bitAccess && it->wordOrder == "little";
+            entry.hardwareChannel = hardwareChannel(slaveId, it.key());
+            entry.channelName = it->channelName;
+            plan.append(entry);
+        }
+    }
+}
+
+QVector<ModbusChannelValue> ModbusChannelMap::extract(int slaveId, const QModbusDataUnit& unit) const
+{
+    QVector<ModbusChannelValue> values;
+
+    auto planIt = m_decodePlans.constFind(qMakePair(slaveId, functionCode(unit.registerType())));
+    if (planIt == m_decodePlans.constEnd()) {
+        return values;
+    }
+
+    const int startAddress = unit.startAddress();
+    const int endAddress = startAddress + static_cast<int>(unit.valueCount());
+    const auto registers = unit.values();
+    const quint16* data = registers.constData();
+
+    // 二分找到读取区间内的第一个通道，之后按地址顺序解码
+    const QVector<DecodeEntry>& plan = planIt.value();
+    auto entryIt = std::lower_bound(plan.constBegin(), plan.constEnd(), startAddress,
+                                    [](const DecodeEntry& entry, int address) { return entry.address < address; });
+
+    values.reserve(static_cast<int>(plan.constEnd() - entryIt));
+    for (; entryIt != plan.constEnd() && entryIt->address < endAddress; ++entryIt) {
+        if (entryIt->address + entryIt->count > endAddress) {
+            continue;
+        }
+
+        ModbusChannelValue value;
+        value.hardwareChannel = entryIt->hardwareChannel;
+        value.channelName = entryIt->channelName;
+        value.slaveId = slaveId;
+        value.registerAddress = entryIt->address;
+        value.rawValue = decode(*entryIt, data + (entryIt->address - startAddress));
+        values.append(value);
+    }
+
+    return values;
+}
+
+int ModbusChannelMap::functionCode(QModbusDataUnit::RegisterType type)
+{
+    switch (type) {
+        case QModbusDataUnit::Coils: return 1;
+        case QModbusDataUnit::DiscreteInputs: return 2;
+        case QModbusDataUnit::HoldingRegisters: return 3;
+        case QModbusDataUnit::InputRegisters: return 4;
+        default: return 0;
+    }
+}
+
+ModbusChannelMap::DataType ModbusChannelMap::parseDataType(const QString& dataType)
+{
+    if (dataType == "int16") {
+        return DataType::Int16;
+    } else if (dataType == "int32") {
+        return DataType::Int32;
+    } else if (dataType == "uint32") {
+        return DataType::UInt32;
+    } else if (dataType == "float32") {
+        return DataType::Float32;
+    } else if (dataType == "float64") {
+        return DataType::Float64;
+    }
+    return DataType::UInt16;
+}
+
+double ModbusChannelMap::decode(const DecodeEntry& entry, const quint16* registers)
+{
+    // 按字序把寄存器拼成高位在前的整数，每个寄存器按字节序调整
+    quint64 bits = 0;
+    for (int i = 0; i < entry.count; ++i) {
+        quint16 word = registers[entry.swapWords ? entry.count - 1 - i : i];
+        if (entry.swapBytes) {
+            word = qbswap(word);
+        }
+        bits = (bits << 16) | word;
+    }
+
+    switch (entry.dataType) {
+        case DataType::Int16:
+            return static_cast<double>(static_cast<qint16>(bits));
+        case DataType::UInt16:
+            return static_cast<double>(static_cast<quint16>(bits));
+        case DataType::Int32:
+            return static_cast<double>(static_cast<qint32>(static_cast<quint32>(bits)));
+        case DataType::UInt32:
+            return static_cast<double>(static_cast<quint32>(bits));
+        case DataType::Float32: {
+            const quint32 raw = static_cast<quint32>(bits);
+            float value;
+            std::memcpy(&value, &raw, sizeof(value));
+            return static_cast<double>(value);
+        }
+        case DataType::Float64: {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    }
+    return 0.0;
+}
+
+QString ModbusChannelMap::hardwareChannel(int slaveId, int registerAddress)
+{
+    return QString("%1_%2").arg(slaveId).arg(registerAddress);
+}
+
+} // namespace Device
@@ -0,0 +1,91 @@
+#ifndef MODBUSCHANNELMAP_H
+#define MODBUSCHANNELMAP_H
+
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QHash>
+#include <QPair>
+#include <QVector>
+#include <QModbusDataUnit>
+#include "../Core/DataTypes.h"
+
+namespace Device {
+
+/**
+ * @brief Modbus通道值
+ * 从一次读取结果中解码出的、配置了通道的值
+ */
+struct ModbusChannelValue {
+    QString hardwareChannel;   // 硬件通道标识（从站ID_寄存器地址）
+    QString channelName;       // 通道名称
+    int slaveId = 0;           // 从站ID
+    int registerAddress = 0;   // 起始寄存器地址
+    double rawValue = 0.0;     // 按数据类型解码后的原始值
+};
+
+/**
+ * @brief Modbus通道映射
+ * 串口和TCP两种Modbus设备共用：把一次读取结果中配置了通道的寄存器按数据类型解码（合并读取的空隙寄存器被跳过）。
+ * 构造时为每个从站的每种功能码生成按地址排序的解码计划（数据类型、字节序、字序和硬件通道标识都预先确定），
+ * 应答处理时只需一次二分查找，然后顺序解码，不再逐个寄存器查找映射表。
+ */
+class ModbusChannelMap
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param slaves 从站配置列表
+     */
+    explicit ModbusChannelMap(const QList<Core::ModbusSlaveConfig>& slaves);
+
+    /**
+     * @brief 解码读取结果中配置了通道的值
+     * 按读取结果的寄存器类型选择对应功能码的解码计划，只解码完整落在读取区间内的通道
+     * @param slaveId 从站ID
+     * @param unit 读取结果
+     * @return 通道值列表
+     */
+    QVector<ModbusChannelValue> extract(int slaveId, const QModbusDataUnit& unit) const;
+
+    /**
+     * @brief 构造硬件通道标识
+     * @param slaveId 从站ID
+     * @param registerAddress 寄存器地址
+     * @return 硬件通道标识
+     */
+    static QString hardwareChannel(int slaveId, int registerAddress);
+
+private:
+    enum class DataType {
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    /**
+     * @brief 解码计划中的一项（一个通道）
+     */
+    struct DecodeEntry {
+        int address = 0;             // 起始寄存器地址
+        int count = 1;               // 占用的寄存器数量
+        DataType dataType = DataType::UInt16;
+        bool swapBytes = false;      // 寄存器内低字节在前
+        bool swapWords = false;      // 低位字在低地址
+        QString hardwareChannel;     // 预先构造的硬件通道标识
+        QString channelName;         // 通道名称
+    };
+
+    static DataType parseDataType(const QString& dataType);
+    static int functionCode(QModbusDataUnit::RegisterType type);
+    static double decode(const DecodeEntry& entry, const quint16* registers);
+
+    QHash<QPair<int, int>, QVector<DecodeEntry>> m_decodePlans;      // (从站ID,功能码) -> 按地址排序的解码计划
+};
+
+} // namespace Device
+
+#endif // MODBUSCHANNELMAP_H
@@ -1,4 +1,9 @@
 #include "ModbusDevice.h"
+#include "../Core/Log.h"
+#include "../Core/Metrics.h"
+#ifdef DAQ_SIMULATED_PEERS
+#include "../Simulation/ModbusRtuSlaveSimulator.h"
+#endif
 #include <QThread>
 
 namespace Device {
@@ -8,7 +13,12 @@ ModbusDevice::ModbusDevice(const Core::ModbusDeviceConfig& config, QObject *pare
     , m_config(config)
     , m_modbusClient(nullptr)
     , m_timer(nullptr)
+    , m_channelMap(config.slaves)
+    , m_pollScheduler(config, ModbusRequestPlanner(config.serialConfig))
     , m_isAcquiring(false)
+    , m_pipeline(nullptr)
+    , m_lastStatisticsUs(0)
+    , m_simulator(nullptr)
 {
     // 注意：不在构造函数中创建QModbusRtuSerialClient，而是在线程启动后创建
     // 这样可以确保QModbusRtuSerialClient和QSerialPort对象在正确的线程中创建
@@ -19,16 +29,23 @@ ModbusDevice::ModbusDevice(const Core::ModbusDeviceConfig& config, QObject *pare
     // 连接定时器信号到读取数据的槽
     connect(m_timer, &QTimer::timeout, this, &ModbusDevice::readModbusData);
 
-    // 设置定时器间隔
-    m_timer->setInterval(m_config.readCycleMs);
-
-    // 初始化通道映射
-    for (const auto& slave : m_config.slaves) {
-        for (const auto& reg : slave.registers) {
-            m_channelNames[slave.slaveId][reg.registerAddress] = reg.channelName;
-            m_channelParams[slave.slaveId][reg.registerAddress] = reg.channelParams;
-        }
-    }
+    // 单次定时器，由轮询调度器按最早截止时间重新启动
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(0);
+    m_clock.start();
+
+    // 请求流水线：结果直接处理，组结束通过事件循环排队处理，避免在持有m_mutex时重入
+    m_pipeline = new ModbusRequestPipeline(this);
+    ModbusRequestPipeline::Options options;
+    options.maxInFlight = m_config.maxInFlight;
+    options.timeoutMs = m_config.timeoutMs;
+    options.retries = m_config.retries;
+    m_pipeline->setOptions(options);
+    connect(m_pipeline, &ModbusRequestPipeline::replyReady, this, &ModbusDevice::processModbusResponse);
+    connect(m_pipeline, &ModbusRequestPipeline::requestFailed, this, &ModbusDevice::onRequestFailed);
+    connect(m_pipeline, &ModbusRequestPipeline::tagFinished, this, &ModbusDevice::onPollGroupFinished,
+            Qt::QueuedConnection);
 
     // 连接线程启动信号，确保在正确的线程中创建QModbusRtuSerialClient
     connect(QThread::currentThread(), &QThread::started, this, &ModbusDevice::initializeModbusClient);
@@ -72,6 +89,7 @@ void ModbusDevice::initializeModbusClient()
 
     // 创建新的Modbus客户端
     m_modbusClient = new QModbusRtuSerialClient(this);
+    m_pipeline->setClient(m_modbusClient);
 
     qDebug() << "初始化Modbus客户端 - 设备:" << m_config.instanceName
              << "线程ID:" << QThread::currentThreadId();
@@ -128,6 +146,30 @@ bool ModbusDevice::connectDevice()
         QThread::msleep(100);
     }
 
+    // 首次连接时启动模拟从站，只应答配置中的从站ID
+#ifdef DAQ_SIMULATED_PEERS
+    if (m_config.serialConfig.simulated && !m_simulator) {
+        m_simulator = new Simulation::ModbusRtuSlaveSimulator(m_config.serialConfig, this);
+        QSet<int> slaveIds;
+        for (const auto& slave : m_config.slaves) {
+            slaveIds.insert(slave.slaveId);
+        }
+        m_simulator->setSlaveIds(slaveIds);
+        m_simulator->setResponseDelayMs(m_config.serialConfig.simulatedResponseDelayMs);
+        if (!m_simulator->open()) {
+            setStatus(Core::StatusCode::ERROR_CONNECTION, "Modbus RTU模拟从站启动失败");
+            delete m_simulator;
+            m_simulator = nullptr;
+            return false;
+        }
+    }
+#else
+    if (m_config.serialConfig.simulated) {
+        setStatus(Core::StatusCode::ERROR_CONFIG, "未启用模拟对端，无法使用simulated串口（构建时开启DAQ_SIMULATED_PEERS）");
+        return false;
+    }
+#endif
+
     // 配置串口参数
     if (!configureSerialPort()) {
         QString errorMsg = "串口配置失败: " + m_config.serialConfig.port;
@@ -218,6 +260,11 @@ void ModbusDevice::startAcquisition()
 
     m_isAcquiring = true;
 
+    // 所有轮询组从现在开始到期，之前未返回的应答不再参与调度
+    m_pipeline->clear();
+    m_pollScheduler.reset(monotonicUs());
+    m_lastStatisticsUs = monotonicUs();
+
     // 确保定时器在当前线程中启动
     QMetaObject::invokeMethod(m_timer, "start", Qt::QueuedConnection);
 
@@ -230,6 +277,11 @@ void ModbusDevice::stopAcquisition()
     QMutexLocker locker(&m_mutex);
     m_isAcquiring = false;
 
+    // 丢弃尚未发出的请求
+    if (m_pipeline) {
+        m_pipeline->clear();
+    }
+
     // 停止定时器
     if (m_timer && m_timer->isActive()) {
         QMetaObject::invokeMethod(m_timer, "stop", Qt::QueuedConnection);
@@ -272,6 +324,8 @@ void ModbusDevice::readModbusData()
 
         if (!m_modbusClient) {
             qDebug() << "初始化Modbus客户端失败:" << getDeviceId();
+            // 定时器为单次触发，连接恢复前按读取周期重试
+            m_timer->start(m_config.readCycleMs);
             return;
         }
     }
@@ -283,6 +337,8 @@ void ModbusDevice::readModbusData()
             m_modbusClient->state() == QModbusDevice::ConnectingState) {
             qDebug() << "Modbus设备正在状态转换中，等待完成:" << getDeviceId()
                      << "当前状态:" << m_modbusClient->state();
+            // 定时器为单次触发，连接恢复前按读取周期重试
+            m_timer->start(m_config.readCycleMs);
             return;
         }
 
@@ -304,142 +360,155 @@ void ModbusDevice::readModbusData()
                 qDebug() << "重新连接Modbus设备成功:" << getDeviceId();
             } else {
                 qDebug() << "重新连接Modbus设备失败:" << getDeviceId();
+                m_timer->start(m_config.readCycleMs);
                 return;
             }
         } else {
             qDebug() << "重连尝试过于频繁，跳过本次重连:" << getDeviceId();
+            m_timer->start(m_config.readCycleMs);
             return;
         }
     }
 
-    // 遍历所有从站
-    for (const auto& slave : m_config.slaves) {
-        // 获取该从站的所有寄存器地址
-        QList<int> registerAddresses;
-        for (const auto& reg : slave.registers) {
-            registerAddresses.append(reg.registerAddress);
-        }
+    pollDueGroups();
+}
 
-        // 如果没有寄存器，跳过该从站
-        if (registerAddresses.isEmpty()) {
-            continue;
+void ModbusDevice::pollDueGroups()
+{
+    // 流水线队列中还有未发出的请求时不再提交，等组结束后再调度，请求不会在客户端中堆积
+    while (m_pipeline->queuedCount() == 0) {
+        const qint64 nowUs = monotonicUs();
+        const int group = m_pollScheduler.takeDueGroup(nowUs);
+        if (group < 0) {
+            scheduleNextPoll();
+            return;
         }
 
-        // 对寄存器地址进行排序
-        std::sort(registerAddresses.begin(), registerAddresses.end());
+        // 到该组下一次截止时间仍未发出的请求过期丢弃
+        const qint64 staleMs = qMax<qint64>(0, (m_pollScheduler.groupDeadlineUs(group) - nowUs) / 1000);
+        const QDeadlineTimer staleDeadline(staleMs, Qt::PreciseTimer);
+        m_pipeline->submitGroup(m_pollScheduler.groupRequests(group), group, staleDeadline);
+    }
+}
 
-        // 合并连续的寄存器地址，减少请求次数
-        int startAddress = registerAddresses.first();
-        int count = 1;
+void ModbusDevice::onPollGroupFinished(int group, qint64 busTimeUs)
+{
+    QMutexLocker locker(&m_mutex);
 
-        for (int i = 1; i < registerAddresses.size(); ++i) {
-            if (registerAddresses[i] == registerAddresses[i-1] + 1) {
-                // 连续的寄存器
-                count++;
-            } else {
-                // 不连续，发送请求并重新开始
-                QModbusReply* reply = readRegisters(slave.slaveId, slave.operationCommand,
-                                                  startAddress, count);
-                if (reply) {
-                    connect(reply, &QModbusReply::finished, this, [this, reply]() {
-                        this->processModbusResponse(reply);
-                    });
-                } else {
-                    qDebug() << "发送Modbus请求失败 - 从站:" << slave.slaveId
-                             << "功能码:" << slave.operationCommand
-                             << "起始地址:" << startAddress
-                             << "数量:" << count
-                             << "设备:" << getDeviceId();
-                }
-
-                startAddress = registerAddresses[i];
-                count = 1;
-            }
-        }
+    m_pollScheduler.completeGroup(group, busTimeUs);
+    reportStatistics();
 
-        // 发送最后一组请求
-        QModbusReply* reply = readRegisters(slave.slaveId, slave.operationCommand,
-                                          startAddress, count);
-        if (reply) {
-            connect(reply, &QModbusReply::finished, this, [this, reply]() {
-                this->processModbusResponse(reply);
-            });
-        } else {
-            qDebug() << "发送Modbus请求失败(最后一组) - 从站:" << slave.slaveId
-                     << "功能码:" << slave.operationCommand
-                     << "起始地址:" << startAddress
-                     << "数量:" << count
-                     << "设备:" << getDeviceId();
-        }
+    if (m_isAcquiring) {
+        pollDueGroups();
     }
 }
 
-void ModbusDevice::processModbusResponse(QModbusReply *reply)
+void ModbusDevice::onRequestFailed(int slaveId, const QString &error)
+{
+    // 从站离线时每个周期都会失败，限频输出
+    DAQ_LOG_EVERY_MS(1000, QtWarningMsg, lcDevice, "%s 从站: %d 设备: %s",
+                     qUtf8Printable(error), slaveId, qUtf8Printable(getDeviceId()));
+    emit errorOccurred(getDeviceId(), error);
+}
+
+void ModbusDevice::reportStatistics()
 {
-    // 确保响应对象有效
-    if (!reply) {
-        qDebug() << "Modbus响应对象为空，设备:" << getDeviceId();
+    const qint64 nowUs = monotonicUs();
+    if (nowUs - m_lastStatisticsUs < 5000000) {
         return;
     }
+    m_lastStatisticsUs = nowUs;
+
+    qDebug() << "Modbus轮询统计 - 设备:" << getDeviceId()
+             << "总线占用率:" << m_pollScheduler.busUtilization()
+             << "在途请求:" << m_pipeline->inFlightCount();
+    for (const auto& stats : m_pollScheduler.takeStatistics()) {
+        qDebug() << "  轮询组:" << stats.name
+                 << "优先级:" << stats.priority
+                 << "周期:" << stats.configuredCycleMs << "->" << stats.effectiveCycleMs << "毫秒"
+                 << "总线时间:" << stats.busTimeMs << "毫秒"
+                 << "轮询次数:" << stats.polls
+                 << "延迟次数:" << stats.latePolls
+                 << "丢失周期:" << stats.missedCycles
+                 << "最大延迟:" << stats.maxLatenessMs << "毫秒";
+    }
+
+    const auto slaveStatistics = m_pipeline->takeStatistics();
+    for (auto it = slaveStatistics.constBegin(); it != slaveStatistics.constEnd(); ++it) {
+        const auto& stats = it.value();
+        qDebug() << "  从站:" << it.key()
+                 << "请求:" << stats.requests
+                 << "应答:" << stats.responses
+                 << "超时:" << stats.timeouts
+                 << "错误:" << stats.errors
+                 << "重试:" << stats.retries
+                 << "过期丢弃:" << stats.staleSkipped
+                 << "静默跳过:" << stats.silentSkipped
+                 << "往返时间(最小/平均/最大):" << stats.minRttMs << "/" << stats.averageRttMs << "/" << stats.maxRttMs << "毫秒"
+                 << (stats.silent ? "静默退避中" : "");
+    }
+
+#ifdef DAQ_SIMULATED_PEERS
+    if (m_simulator) {
+        const auto simulated = m_simulator->takeStatistics();
+        qDebug() << "  模拟从站 - 请求:" << simulated.requests
+                 << "CRC错误字节:" << simulated.crcErrors
+                 << "未配置从站:" << simulated.ignored
+                 << "线路占用率(请求/应答):" << simulated.line.rxUtilization << "/" << simulated.line.txUtilization;
+    }
+#endif
+}
 
-    // 设置自动删除，确保资源释放
-    reply->setParent(this);
+void ModbusDevice::scheduleNextPoll()
+{
+    if (!m_isAcquiring) {
+        return;
+    }
 
-    // 检查是否有错误
-    if (reply->error() != QModbusDevice::NoError) {
-        QString errorMsg = QString("Modbus响应错误: %1 - 从站: %2").arg(reply->errorString()).arg(reply->serverAddress());
-        qDebug() << errorMsg << "设备:" << getDeviceId();
-        emit errorOccurred(getDeviceId(), errorMsg);
-        reply->deleteLater();
+    const qint64 deadlineUs = m_pollScheduler.nextDeadlineUs();
+    if (deadlineUs < 0) {
         return;
     }
 
-    // 获取响应数据
-    const QModbusDataUnit unit = reply->result();
-    int slaveId = reply->serverAddress();
+    const qint64 delayUs = deadlineUs - monotonicUs();
+    m_timer->start(delayUs > 0 ? static_cast<int>((delayUs + 999) / 1000) : 0);
+}
+
+qint64 ModbusDevice::monotonicUs() const
+{
+    return m_clock.nsecsElapsed() / 1000;
+}
+
+void ModbusDevice::processModbusResponse(int slaveId, const QModbusDataUnit &unit)
+{
+    Core::Metrics::ScopedTimer readTimer(Core::Metrics::DeviceRead);
+
     int startAddress = unit.startAddress();
     int valueCount = unit.valueCount();
 
-    qDebug() << "收到Modbus响应 - 从站:" << slaveId
+    DAQ_TRACE(lcDevice) << "收到Modbus响应 - 从站:" << slaveId
              << "起始地址:" << startAddress
              << "值数量:" << valueCount
              << "设备:" << getDeviceId();
 
     // 获取当前时间戳
-    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
-
-    // 处理每个寄存器的值
-    for (uint i = 0; i < valueCount; ++i) {
-        int registerAddress = startAddress + i;
-        quint16 rawValue = unit.value(i);
-
-        // 获取通道名称和参数
-        QString channelName = getRegisterChannelName(slaveId, registerAddress);
-        Core::ChannelParams params = getRegisterChannelParams(slaveId, registerAddress);
-
-        // 如果找不到通道名称，跳过该寄存器
-        if (channelName.isEmpty()) {
-            continue;
-        }
+    qint64 timestamp = Core::Timebase::nowNs();
 
+    // 处理配置了通道的寄存器（合并读取的空隙寄存器已跳过）
+    for (const auto& value : m_channelMap.extract(slaveId, unit)) {
         // 应用滤波器
-        double filteredValue = applyFilter(static_cast<double>(rawValue));
-
-        // 构造硬件通道标识（从站ID_寄存器地址）
-        QString hardwareChannel = QString("%1_%2").arg(slaveId).arg(registerAddress);
+        double filteredValue = applyFilter(value.rawValue);
 
         // 发送原始数据点就绪信号
-        emit rawDataPointReady(getDeviceId(), hardwareChannel, filteredValue, timestamp);
+        emit rawDataPointReady(getDeviceId(), value.hardwareChannel, filteredValue, timestamp);
+        Core::Metrics::increment(Core::Metrics::RawSamples);
 
-        qDebug() << "Modbus数据点 - 设备:" << getDeviceId()
+        DAQ_TRACE(lcDevice) << "Modbus数据点 - 设备:" << getDeviceId()
                  << "从站:" << slaveId
-                 << "地址:" << registerAddress
-                 << "通道:" << channelName
+                 << "地址:" << value.registerAddress
+                 << "通道:" << value.channelName
                  << "值:" << filteredValue;
     }
-
-    // 删除响应对象
-    reply->deleteLater();
 }
 
 bool ModbusDevice::configureSerialPort()
@@ -448,9 +517,13 @@ bool ModbusDevice::configureSerialPort()
              << "串口:" << m_config.serialConfig.port
              << "波特率:" << m_config.serialConfig.baudrate;
 
-    // 设置串口名称
-    m_modbusClient->setConnectionParameter(QModbusDevice::SerialPortNameParameter,
-                                         m_config.serialConfig.port);
+    // 设置串口名称（模拟时为模拟线路的伪终端）
+#ifdef DAQ_SIMULATED_PEERS
+    const QString portName = m_simulator ? m_simulator->portName() : m_config.serialConfig.port;
+#else
+    const QString portName = m_config.serialConfig.port;
+#endif
+    m_modbusClient->setConnectionParameter(QModbusDevice::SerialPortNameParameter, portName);
 
     // 设置波特率
     m_modbusClient->setConnectionParameter(QModbusDevice::SerialBaudRateParameter,
@@ -490,13 +563,6 @@ bool ModbusDevice::configureSerialPort()
     }
     m_modbusClient->setConnectionParameter(QModbusDevice::SerialParityParameter, parity);
 
-    // 设置响应超时和重试次数
-    int timeout = 1000; // 1秒超时
-    int retries = 3;    // 3次重试
-
-    m_modbusClient->setTimeout(timeout);
-    m_modbusClient->setNumberOfRetries(retries);
-
     // 检查可用的串口
     QList<QSerialPortInfo> ports = QSerialPortInfo::availablePorts();
     qDebug() << "系统可用串口数量:" << ports.size();
@@ -512,102 +578,12 @@ bool ModbusDevice::configureSerialPort()
         }
     }
 
-    if (!portFound) {
+    // 伪终端不在系统串口列表中
+    if (!portFound && !m_simulator) {
         qDebug() << "警告: 未找到配置的串口:" << m_config.serialConfig.port << "设备:" << getDeviceId();
     }
 
     return true;
 }
 
-QModbusReply* ModbusDevice::readRegisters(int slaveId, int functionCode, int startAddress, int count)
-{
-    // 创建数据单元
-    QModbusDataUnit::RegisterType registerType;
-
-    // 根据功能码确定寄存器类型
-    switch (functionCode) {
-        case 1:
-            registerType = QModbusDataUnit::Coils;
-            break;
-        case 2:
-            registerType = QModbusDataUnit::DiscreteInputs;
-            break;
-        case 3:
-            registerType = QModbusDataUnit::HoldingRegisters;
-            break;
-        case 4:
-            registerType = QModbusDataUnit::InputRegisters;
-            break;
-        default:
-            qDebug() << "不支持的功能码:" << functionCode << "设备:" << getDeviceId();
-            return nullptr;
-    }
-
-    // 创建数据单元 - 注意：某些设备可能需要调整寄存器地址
-    // 例如，有些设备使用0-based寻址，有些使用1-based寻址
-    // 如果设备使用1-based寻址但配置文件中使用0-based，则需要加1
-    // 如果设备使用0-based寻址但配置文件中使用1-based，则需要减1
-
-    // 这里我们假设配置文件中的地址是0-based，与Qt API一致
-    QModbusDataUnit dataUnit(registerType, startAddress, count);
-
-    // 发送读取请求
-    QModbusReply* reply = m_modbusClient->sendReadRequest(dataUnit, slaveId);
-
-    // 检查请求是否成功
-    if (!reply) {
-        QString errorMsg = QString("发送Modbus请求失败: %1 - 从站: %2").arg(m_modbusClient->errorString()).arg(slaveId);
-        qDebug() << errorMsg << "设备:" << getDeviceId();
-        emit errorOccurred(getDeviceId(), errorMsg);
-        return nullptr;
-    }
-
-    if (reply->isFinished()) {
-        // 请求已完成（可能是错误）
-        if (reply->error() != QModbusDevice::NoError) {
-            QString errorMsg = QString("Modbus请求错误: %1 - 从站: %2").arg(reply->errorString()).arg(slaveId);
-            qDebug() << errorMsg << "设备:" << getDeviceId();
-            emit errorOccurred(getDeviceId(), errorMsg);
-        } else {
-            // 如果没有错误，可能是请求成功完成
-            processModbusResponse(reply);
-        }
-
-        reply->deleteLater();
-        return nullptr;
-    }
-
-    return reply;
-}
-
-QString ModbusDevice::getRegisterChannelName(int slaveId, int registerAddress) const
-{
-    // 检查从站ID是否存在
-    if (!m_channelNames.contains(slaveId)) {
-        return QString();
-    }
-
-    // 检查寄存器地址是否存在
-    if (!m_channelNames[slaveId].contains(registerAddress)) {
-        return QString();
-    }
-
-    return m_channelNames[slaveId][registerAddress];
-}
-
-Core::ChannelParams ModbusDevice::getRegisterChannelParams(int slaveId, int registerAddress) const
-{
-    // 检查从站ID是否存在
-    if (!m_channelParams.contains(slaveId)) {
-        return Core::ChannelParams();
-    }
-
-    // 检查寄存器地址是否存在
-    if (!m_channelParams[slaveId].contains(registerAddress)) {
-        return Core::ChannelParams();
-    }
-
-    return m_channelParams[slaveId][registerAddress];
-}
-
 } // namespace Device
@@ -2,8 +2,12 @@
 #define MODBUSDEVICE_H
 
 #include "AbstractDevice.h"
+#include "ModbusPollScheduler.h"
+#include "ModbusRequestPipeline.h"
+#include "ModbusChannelMap.h"
 #include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QSerialPort>
 #include <QSerialPortInfo>
 #include <QModbusRtuSerialClient>
@@ -12,6 +16,10 @@
 #include <QMap>
 #include <QMutex>
 
+namespace Simulation {
+class ModbusRtuSlaveSimulator;
+}
+
 namespace Device {
 
 /**
@@ -78,57 +86,71 @@ private slots:
 
     /**
      * @brief 读取Modbus数据
-     * 定时器触发时读取所有从站的寄存器
+     * 定时器触发时由轮询调度器选出到期的轮询组并发送该组的读请求
      */
     void readModbusData();
 
     /**
      * @brief 处理Modbus响应
-     * @param reply Modbus响应对象
+     * @param slaveId 从站ID
+     * @param unit 读取结果
      */
-    void processModbusResponse(QModbusReply *reply);
+    void processModbusResponse(int slaveId, const QModbusDataUnit &unit);
 
-private:
     /**
-     * @brief 配置串口参数
-     * @return 是否成功配置
+     * @brief 轮询组的全部请求已结束，更新调度器并提交下一个到期组
+     * @param group 组索引
+     * @param busTimeUs 该组请求占用的总线时间（微秒）
      */
-    bool configureSerialPort();
+    void onPollGroupFinished(int group, qint64 busTimeUs);
 
     /**
-     * @brief 读取从站寄存器
+     * @brief 请求最终失败
      * @param slaveId 从站ID
-     * @param functionCode 功能码
-     * @param startAddress 起始地址
-     * @param count 寄存器数量
-     * @return Modbus响应对象
+     * @param error 错误信息
      */
-    QModbusReply* readRegisters(int slaveId, int functionCode, int startAddress, int count);
+    void onRequestFailed(int slaveId, const QString &error);
 
+private:
     /**
-     * @brief 获取寄存器通道名称
-     * @param slaveId 从站ID
-     * @param registerAddress 寄存器地址
-     * @return 通道名称
+     * @brief 把到期轮询组的请求提交到流水线（调用方已持有m_mutex）
      */
-    QString getRegisterChannelName(int slaveId, int registerAddress) const;
+    void pollDueGroups();
 
     /**
-     * @brief 获取寄存器通道参数
-     * @param slaveId 从站ID
-     * @param registerAddress 寄存器地址
-     * @return 通道参数
+     * @brief 按最早截止时间启动单次定时器
+     */
+    void scheduleNextPoll();
+
+    /**
+     * @brief 每5秒输出一次轮询组和从站统计
+     */
+    void reportStatistics();
+
+    /**
+     * @brief 当前单调时间（微秒）
      */
-    Core::ChannelParams getRegisterChannelParams(int slaveId, int registerAddress) const;
+    qint64 monotonicUs() const;
+
+    /**
+     * @brief 配置串口参数
+     * @return 是否成功配置
+     */
+    bool configureSerialPort();
 
 private:
     Core::ModbusDeviceConfig m_config;                // 设备配置
     QModbusRtuSerialClient* m_modbusClient;           // Modbus客户端
     QTimer* m_timer;                                  // 定时器
-    QMap<int, QMap<int, QString>> m_channelNames;     // 从站ID -> 寄存器地址 -> 通道名称
-    QMap<int, QMap<int, Core::ChannelParams>> m_channelParams; // 从站ID -> 寄存器地址 -> 通道参数
+    ModbusChannelMap m_channelMap;                    // 从站ID/寄存器地址 -> 通道
+    ModbusPollScheduler m_pollScheduler;              // 轮询调度器（配置阶段生成各组读请求计划）
     QMutex m_mutex;                                   // 互斥锁，用于保护数据访问
     bool m_isAcquiring;                               // 是否正在采集
+
+    ModbusRequestPipeline* m_pipeline;                // 请求流水线（限制在途请求数、超时重试）
+    QElapsedTimer m_clock;                            // 调度用单调时钟
+    qint64 m_lastStatisticsUs;                        // 上次输出统计的时间
+    Simulation::ModbusRtuSlaveSimulator* m_simulator; // 进程内模拟从站（以DAQ_SIMULATED_PEERS构建且serial_config.simulated为true时）
 };
 
 } // namespace Device
@@ -0,0 +1,288 @@
+#include "ModbusPollScheduler.h"
+#include <QDebug>
+#include <QMap>
+
+namespace Device {
+
+ModbusPollScheduler::ModbusPollScheduler(const Core::ModbusDeviceConfig& config, const ModbusRequestPlanner& planner)
+    : m_deviceName(config.instanceName)
+{
+    // 组名称 -> 组索引；默认组（名称为空）使用设备的读取周期
+    QMap<QString, int> groupIndex;
+    auto addGroup = [this, &groupIndex](const QString& name, int cycleMs, int priority) {
+        Group group;
+        group.name = name;
+        group.priority = priority;
+        group.periodUs = static_cast<qint64>(qMax(1, cycleMs)) * 1000;
+        group.degradeFactor = 1;
+        group.deadlineUs = 0;
+        group.busy = false;
+        group.busTimeUs = 0.0;
+        groupIndex[name] = m_groups.size();
+        m_groups.append(group);
+    };
+
+    for (const auto& pollGroup : config.pollGroups) {
+        if (!groupIndex.contains(pollGroup.name)) {
+            addGroup(pollGroup.name, pollGroup.cycleMs, pollGroup.priority);
+        }
+    }
+
+    // 按组拆分从站的寄存器，再分别生成请求计划
+    QVector<QList<Core::ModbusSlaveConfig>> groupSlaves;
+    for (const auto& slave : config.slaves) {
+        QMap<int, Core::ModbusSlaveConfig> slaveByGroup;
+        for (const auto& reg : slave.registers) {
+            if (!groupIndex.contains(reg.pollGroup)) {
+                if (!reg.pollGroup.isEmpty()) {
+                    qDebug() << "寄存器" << reg.channelName << "引用了未定义的轮询组" << reg.pollGroup
+                             << "，使用默认组，设备:" << m_deviceName;
+                }
+                if (!groupIndex.contains(QString())) {
+                    addGroup(QString(), config.readCycleMs, 0);
+                }
+            }
+            int index = groupIndex.value(groupIndex.contains(reg.pollGroup) ? reg.pollGroup : QString());
+
+            auto it = slaveByGroup.find(index);
+            if (it == slaveByGroup.end()) {
+                it = slaveByGroup.insert(index, Core::ModbusSlaveConfig(slave.slaveId, slave.operationCommand, {}));
+            }
+            it->registers.append(reg);
+        }
+
+        groupSlaves.resize(m_groups.size());
+        for (auto it = slaveByGroup.constBegin(); it != slaveByGroup.constEnd(); ++it) {
+            groupSlaves[it.key()].append(it.value());
+        }
+    }
+    groupSlaves.resize(m_groups.size());
+
+    for (int i = 0; i < m_groups.size(); ++i) {
+        Group& group = m_groups[i];
+        group.requests = planner.plan(groupSlaves[i]);
+        for (const auto& request : group.requests) {
+            group.busTimeUs += request.costUs;
+        }
+
+        group.statistics.name = group.name.isEmpty() ? QStringLiteral("default") : group.name;
+        group.statistics.priority = group.priority;
+        group.statistics.configuredCycleMs = group.periodUs / 1000.0;
+
+        qDebug() << "Modbus轮询组:" << group.statistics.name
+                 << "周期:" << group.statistics.configuredCycleMs << "毫秒"
+                 << "优先级:" << group.priority
+                 << "请求数:" << group.requests.size()
+                 << "估算总线时间:" << group.busTimeUs / 1000.0 << "毫秒"
+                 << "设备:" << m_deviceName;
+    }
+
+    // 去掉没有寄存器的组
+    for (int i = m_groups.size() - 1; i >= 0; --i) {
+        if (m_groups[i].requests.isEmpty()) {
+            m_groups.remove(i);
+        }
+    }
+
+    rebalance();
+}
+
+void ModbusPollScheduler::reset(qint64 nowUs)
+{
+    for (auto& group : m_groups) {
+        group.deadlineUs = nowUs;
+        group.busy = false;
+        group.statistics.polls = 0;
+        group.statistics.latePolls = 0;
+        group.statistics.missedCycles = 0;
+        group.statistics.maxLatenessMs = 0.0;
+    }
+}
+
+int ModbusPollScheduler::takeDueGroup(qint64 nowUs)
+{
+    // 最早截止时间优先，截止时间相同时优先级高者优先
+    int selected = -1;
+    for (int i = 0; i < m_groups.size(); ++i) {
+        const Group& group = m_groups[i];
+        if (group.busy || group.deadlineUs > nowUs) {
+            continue;
+        }
+        if (selected < 0
+            || group.deadlineUs < m_groups[selected].deadlineUs
+            || (group.deadlineUs == m_groups[selected].deadlineUs && group.priority > m_groups[selected].priority)) {
+            selected = i;
+        }
+    }
+
+    if (selected < 0) {
+        return -1;
+    }
+
+    Group& group = m_groups[selected];
+    const qint64 period = effectivePeriodUs(group);
+    const qint64 latenessUs = nowUs - group.deadlineUs;
+
+    ++group.statistics.polls;
+    if (latenessUs > 0) {
+        group.statistics.maxLatenessMs = qMax(group.statistics.maxLatenessMs, latenessUs / 1000.0);
+    }
+
+    // 定时器按毫秒取整，几乎每次轮询都会略晚于截止时间，超出容差才计为延迟
+    const qint64 toleranceUs = qMax<qint64>(LATE_TOLERANCE_MIN_US, period / 10);
+    if (latenessUs > toleranceUs) {
+        ++group.statistics.latePolls;
+    }
+
+    // 延迟超过一个周期时丢弃错过的周期，不集中补发
+    if (latenessUs >= period) {
+        group.statistics.missedCycles += latenessUs / period;
+        group.deadlineUs = nowUs;
+    }
+    group.deadlineUs += period;
+    group.busy = true;
+
+    return selected;
+}
+
+void ModbusPollScheduler::completeGroup(int group, qint64 busTimeUs)
+{
+    if (group < 0 || group >= m_groups.size()) {
+        return;
+    }
+
+    Group& target = m_groups[group];
+    if (!target.busy) {
+        // 重复完成（组已结束）不再更新统计
+        return;
+    }
+    target.busy = false;
+
+    // 整组请求都被跳过（过期、从站静默或连接断开）时没有占用总线，不计入耗时估计
+    if (busTimeUs > 0) {
+        target.busTimeUs += BUS_TIME_WEIGHT * (busTimeUs - target.busTimeUs);
+    }
+
+    rebalance();
+}
+
+qint64 ModbusPollScheduler::nextDeadlineUs() const
+{
+    qint64 next = -1;
+    for (const auto& group : m_groups) {
+        if (group.busy) {
+            continue;
+        }
+        if (next < 0 || group.deadlineUs < next) {
+            next = group.deadlineUs;
+        }
+    }
+    return next;
+}
+
+qint64 ModbusPollScheduler::groupDeadlineUs(int group) const
+{
+    if (group < 0 || group >= m_groups.size()) {
+        return -1;
+    }
+    return m_groups[group].deadlineUs;
+}
+
+const QList<ModbusReadRequest>& ModbusPollScheduler::groupRequests(int group) const
+{
+    static const QList<ModbusReadRequest> empty;
+    if (group < 0 || group >= m_groups.size()) {
+        return empty;
+    }
+    return m_groups[group].requests;
+}
+
+double ModbusPollScheduler::busUtilization() const
+{
+    double utilization = 0.0;
+    for (const auto& group : m_groups) {
+        utilization += group.busTimeUs / effectivePeriodUs(group);
+    }
+    return utilization;
+}
+
+QList<ModbusPollScheduler::GroupStatistics> ModbusPollScheduler::takeStatistics()
+{
+    QList<GroupStatistics> result;
+    for (auto& group : m_groups) {
+        group.statistics.effectiveCycleMs = effectivePeriodUs(group) / 1000.0;
+        group.statistics.busTimeMs = group.busTimeUs / 1000.0;
+        result.append(group.statistics);
+
+        group.statistics.polls = 0;
+        group.statistics.latePolls = 0;
+        group.statistics.missedCycles = 0;
+        group.statistics.maxLatenessMs = 0.0;
+    }
+    return result;
+}
+
+qint64 ModbusPollScheduler::effectivePeriodUs(const Group& group) const
+{
+    return group.periodUs * group.degradeFactor;
+}
+
+void ModbusPollScheduler::rebalance()
+{
+    bool changed = false;
+
+    // 总线过载：从最低优先级的组开始降级
+    while (busUtilization() > TARGET_UTILIZATION) {
+        int victim = -1;
+        for (int i = 0; i < m_groups.size(); ++i) {
+            const Group& group = m_groups[i];
+            if (group.degradeFactor >= MAX_DEGRADE_FACTOR) {
+                continue;
+            }
+            if (victim < 0 || group.priority < m_groups[victim].priority
+                || (group.priority == m_groups[victim].priority
+                    && group.busTimeUs / effectivePeriodUs(group)
+                       > m_groups[victim].busTimeUs / effectivePeriodUs(m_groups[victim]))) {
+                victim = i;
+            }
+        }
+        if (victim < 0) {
+            break;
+        }
+        m_groups[victim].degradeFactor *= 2;
+        changed = true;
+    }
+
+    // 总线有余量：按优先级从高到低逐级恢复
+    for (;;) {
+        int candidate = -1;
+        for (int i = 0; i < m_groups.size(); ++i) {
+            if (m_groups[i].degradeFactor > 1
+                && (candidate < 0 || m_groups[i].priority > m_groups[candidate].priority)) {
+                candidate = i;
+            }
+        }
+        if (candidate < 0) {
+            break;
+        }
+
+        Group& group = m_groups[candidate];
+        const double current = group.busTimeUs / effectivePeriodUs(group);
+        if (busUtilization() + current > RESTORE_UTILIZATION) {
+            break;
+        }
+        group.degradeFactor /= 2;
+        changed = true;
+    }
+
+    if (changed) {
+        for (const auto& group : m_groups) {
+            if (group.degradeFactor > 1) {
+                qDebug() << "Modbus总线饱和，轮询组" << (group.name.isEmpty() ? QStringLiteral("default") : group.name)
+                         << "降级为" << effectivePeriodUs(group) / 1000.0 << "毫秒，设备:" << m_deviceName;
+            }
+        }
+    }
+}
+
+} // namespace Device
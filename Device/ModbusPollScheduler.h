@@ -0,0 +1,131 @@
+#ifndef MODBUSPOLLSCHEDULER_H
+#define MODBUSPOLLSCHEDULER_H
+
+#include <QString>
+#include <QList>
+#include <QVector>
+#include "ModbusRequestPlanner.h"
+#include "../Core/DataTypes.h"
+
+namespace Device {
+
+/**
+ * @brief Modbus轮询调度器
+ * 按轮询组调度一条总线上的读请求：每组有自己的周期和优先级，
+ * 请求队列空闲时选择截止时间最早的到期组（同时到期时优先级高者优先）提交该组的全部请求，
+ * 同一组在上一次轮询结束前不会再次提交。
+ * 每组的总线占用时间先用规划器估算，之后用实测值的滑动平均修正；
+ * 各组占用率之和超过总线容量时，从最低优先级的组开始把周期加倍，总线有余量时再按优先级逐级恢复。
+ * 调度器只做决策，不收发数据，时间由调用方传入（单调时钟，微秒）。
+ */
+class ModbusPollScheduler
+{
+public:
+    /**
+     * @brief 轮询组统计
+     */
+    struct GroupStatistics {
+        QString name;                 // 组名称
+        int priority = 0;             // 优先级
+        double configuredCycleMs = 0; // 配置周期（毫秒）
+        double effectiveCycleMs = 0;  // 当前实际周期（降级后，毫秒）
+        double busTimeMs = 0;         // 每次轮询的总线占用时间（毫秒）
+        quint64 polls = 0;            // 轮询次数
+        quint64 latePolls = 0;        // 晚于截止时间超过容差（1毫秒与10%周期的较大者）的轮询次数
+        quint64 missedCycles = 0;     // 因总线繁忙丢失的周期数
+        double maxLatenessMs = 0;     // 最大延迟（毫秒）
+    };
+
+    /**
+     * @brief 构造函数，按配置为每个轮询组生成读请求计划
+     * @param config Modbus设备配置
+     * @param planner 请求规划器
+     */
+    ModbusPollScheduler(const Core::ModbusDeviceConfig& config, const ModbusRequestPlanner& planner);
+
+    /**
+     * @brief 重置调度（所有组在now时到期）
+     * @param nowUs 当前时间（微秒）
+     */
+    void reset(qint64 nowUs);
+
+    /**
+     * @brief 选择下一个要轮询的组，该组在completeGroup之前不会再被选中
+     * @param nowUs 当前时间（微秒）
+     * @return 组索引，没有到期的组时返回-1
+     */
+    int takeDueGroup(qint64 nowUs);
+
+    /**
+     * @brief 一次轮询结束
+     * @param group 组索引
+     * @param busTimeUs 本次轮询实际占用的总线时间（微秒）
+     */
+    void completeGroup(int group, qint64 busTimeUs);
+
+    /**
+     * @brief 下一个截止时间（不含正在轮询的组）
+     * @return 最早的截止时间（微秒），没有可调度的组时返回-1
+     */
+    qint64 nextDeadlineUs() const;
+
+    /**
+     * @brief 组的下一次截止时间，本次轮询尚未发出的请求到此时间后过期
+     * @param group 组索引
+     * @return 截止时间（微秒）
+     */
+    qint64 groupDeadlineUs(int group) const;
+
+    /**
+     * @brief 组的读请求计划
+     * @param group 组索引
+     * @return 读请求列表
+     */
+    const QList<ModbusReadRequest>& groupRequests(int group) const;
+
+    /**
+     * @brief 轮询组数量
+     */
+    int groupCount() const { return m_groups.size(); }
+
+    /**
+     * @brief 当前总线占用率（各组总线时间/实际周期之和）
+     */
+    double busUtilization() const;
+
+    /**
+     * @brief 获取并清零统计（周期和总线时间不清零）
+     * @return 每组的统计
+     */
+    QList<GroupStatistics> takeStatistics();
+
+    static constexpr double TARGET_UTILIZATION = 0.9;    // 超过此占用率开始降级
+    static constexpr double RESTORE_UTILIZATION = 0.75;  // 恢复后占用率不超过此值时才恢复
+    static constexpr int MAX_DEGRADE_FACTOR = 64;        // 最大降级倍数
+
+private:
+    struct Group {
+        QString name;
+        int priority;
+        qint64 periodUs;              // 配置周期
+        int degradeFactor;            // 降级倍数（1表示未降级）
+        qint64 deadlineUs;            // 下一次截止时间
+        bool busy;                    // 是否正在轮询
+        double busTimeUs;             // 每次轮询的总线时间（估算值/实测滑动平均）
+        QList<ModbusReadRequest> requests;
+        GroupStatistics statistics;
+    };
+
+    qint64 effectivePeriodUs(const Group& group) const;
+    void rebalance();
+
+    QVector<Group> m_groups;
+    QString m_deviceName;
+
+    static constexpr double BUS_TIME_WEIGHT = 0.2;       // 实测总线时间的滑动平均权重
+    static constexpr qint64 LATE_TOLERANCE_MIN_US = 1000; // 延迟计数的最小容差（微秒）
+};
+
+} // namespace Device
+
+#endif // MODBUSPOLLSCHEDULER_H
@@ -0,0 +1,275 @@
+#include "ModbusRequestPipeline.h"
+#include <QDebug>
+
+namespace Device {
+
+ModbusRequestPipeline::ModbusRequestPipeline(QObject *parent)
+    : QObject(parent)
+    , m_client(nullptr)
+    , m_generation(0)
+    , m_pumping(false)
+{
+}
+
+void ModbusRequestPipeline::setClient(QModbusClient *client)
+{
+    if (m_client) {
+        disconnect(m_client, nullptr, this, nullptr);
+    }
+
+    // 旧客户端的应答随客户端一起销毁，不会再发出finished
+    m_inFlight.clear();
+    clear();
+
+    m_client = client;
+    if (m_client) {
+        connect(m_client, &QObject::destroyed, this, [this]() {
+            m_client = nullptr;
+            m_inFlight.clear();
+            clear();
+        });
+        setOptions(m_options);
+    }
+}
+
+void ModbusRequestPipeline::setOptions(const Options &options)
+{
+    m_options = options;
+    m_options.maxInFlight = qMax(1, m_options.maxInFlight);
+    m_options.timeoutMs = qMax(10, m_options.timeoutMs);
+    m_options.retries = qMax(0, m_options.retries);
+    m_options.silentThreshold = qMax(1, m_options.silentThreshold);
+
+    if (m_client) {
+        // 超时和重试由流水线统一处理，客户端只负责单次收发
+        m_client->setTimeout(m_options.timeoutMs);
+        m_client->setNumberOfRetries(0);
+    }
+}
+
+void ModbusRequestPipeline::submit(const ModbusReadRequest &request, int tag, const QDeadlineTimer &staleDeadline)
+{
+    submitGroup({request}, tag, staleDeadline);
+}
+
+void ModbusRequestPipeline::submitGroup(const QList<ModbusReadRequest> &requests, int tag, const QDeadlineTimer &staleDeadline)
+{
+    if (requests.isEmpty()) {
+        return;
+    }
+
+    // 计数在发送前一次加满，组内请求同步结束时计数不会提前归零
+    m_outstanding[tag] += requests.size();
+    for (const auto &request : requests) {
+        Entry entry;
+        entry.request = request;
+        entry.tag = tag;
+        entry.staleDeadline = staleDeadline;
+        entry.generation = m_generation;
+        m_queue.append(entry);
+    }
+    pump();
+}
+
+void ModbusRequestPipeline::clear()
+{
+    ++m_generation;
+    m_queue.clear();
+    m_outstanding.clear();
+    m_tagBusTimeUs.clear();
+}
+
+QMap<int, ModbusRequestPipeline::SlaveStatistics> ModbusRequestPipeline::takeStatistics()
+{
+    QMap<int, SlaveStatistics> result;
+    for (auto it = m_slaves.begin(); it != m_slaves.end(); ++it) {
+        SlaveState &slave = it.value();
+        SlaveStatistics statistics = slave.statistics;
+        statistics.silent = !slave.silentUntil.hasExpired();
+        statistics.averageRttMs = statistics.responses > 0 ? slave.rttSumMs / statistics.responses : 0.0;
+        result.insert(it.key(), statistics);
+
+        slave.statistics = SlaveStatistics();
+        slave.rttSumMs = 0.0;
+    }
+    return result;
+}
+
+void ModbusRequestPipeline::onReplyFinished()
+{
+    QModbusReply *reply = qobject_cast<QModbusReply *>(sender());
+    if (!reply) {
+        return;
+    }
+
+    auto it = m_inFlight.find(reply);
+    if (it == m_inFlight.end()) {
+        reply->deleteLater();
+        return;
+    }
+
+    Entry entry = it.value();
+    m_inFlight.erase(it);
+
+    // clear()之前发出的请求只释放在途名额，不再上报结果
+    if (entry.generation == m_generation) {
+        handleReply(entry, reply);
+    }
+    reply->deleteLater();
+
+    pump();
+}
+
+void ModbusRequestPipeline::pump()
+{
+    if (!m_client || m_pumping) {
+        return;
+    }
+    m_pumping = true;
+
+    while (m_inFlight.size() < m_options.maxInFlight && !m_queue.isEmpty()) {
+        Entry entry = m_queue.takeFirst();
+        SlaveState &slave = m_slaves[entry.request.slaveId];
+
+        // 下一周期的同一请求即将提交，过期的请求不再占用总线
+        if (entry.staleDeadline.hasExpired()) {
+            ++slave.statistics.staleSkipped;
+            resolve(entry, 0);
+            continue;
+        }
+
+        // 从站静默退避期间跳过
+        if (!slave.silentUntil.hasExpired()) {
+            ++slave.statistics.silentSkipped;
+            resolve(entry, 0);
+            continue;
+        }
+
+        send(entry);
+    }
+
+    m_pumping = false;
+}
+
+bool ModbusRequestPipeline::send(Entry &entry)
+{
+    const ModbusReadRequest &request = entry.request;
+    SlaveState &slave = m_slaves[request.slaveId];
+
+    QModbusDataUnit::RegisterType type = registerType(request.functionCode);
+    if (type == QModbusDataUnit::Invalid) {
+        ++slave.statistics.errors;
+        emit requestFailed(request.slaveId, QString("不支持的功能码: %1").arg(request.functionCode));
+        resolve(entry, 0);
+        return false;
+    }
+
+    ++entry.attempts;
+    ++slave.statistics.requests;
+    entry.sentTimer.start();
+
+    QModbusReply *reply = m_client->sendReadRequest(QModbusDataUnit(type, request.startAddress, request.count),
+                                                    request.slaveId);
+    if (!reply) {
+        ++slave.statistics.errors;
+        emit requestFailed(request.slaveId, QString("发送Modbus请求失败: %1").arg(m_client->errorString()));
+        resolve(entry, 0);
+        return false;
+    }
+
+    // 请求已同步完成（通常是错误）
+    if (reply->isFinished()) {
+        handleReply(entry, reply);
+        reply->deleteLater();
+        return true;
+    }
+
+    m_inFlight.insert(reply, entry);
+    connect(reply, &QModbusReply::finished, this, &ModbusRequestPipeline::onReplyFinished);
+    return true;
+}
+
+void ModbusRequestPipeline::handleReply(Entry &entry, QModbusReply *reply)
+{
+    const int slaveId = entry.request.slaveId;
+    SlaveState &slave = m_slaves[slaveId];
+    const qint64 rttUs = entry.sentTimer.nsecsElapsed() / 1000;
+
+    if (reply->error() == QModbusDevice::NoError) {
+        const double rttMs = rttUs / 1000.0;
+        if (slave.statistics.responses == 0 || rttMs < slave.statistics.minRttMs) {
+            slave.statistics.minRttMs = rttMs;
+        }
+        slave.statistics.maxRttMs = qMax(slave.statistics.maxRttMs, rttMs);
+        slave.rttSumMs += rttMs;
+        ++slave.statistics.responses;
+        slave.consecutiveTimeouts = 0;
+        slave.backoffMs = 0;
+
+        emit replyReady(slaveId, reply->result());
+        resolve(entry, rttUs);
+        return;
+    }
+
+    if (reply->error() == QModbusDevice::TimeoutError) {
+        ++slave.statistics.timeouts;
+        ++slave.consecutiveTimeouts;
+
+        if (slave.consecutiveTimeouts >= m_options.silentThreshold) {
+            // 从站静默：退避一段时间，退避结束后再超时一次就继续加倍
+            slave.backoffMs = slave.backoffMs == 0
+                ? m_options.silentBackoffMs
+                : qMin(slave.backoffMs * 2, m_options.maxSilentBackoffMs);
+            slave.silentUntil = QDeadlineTimer(slave.backoffMs);
+            slave.consecutiveTimeouts = m_options.silentThreshold - 1;
+            qDebug() << "Modbus从站" << slaveId << "连续超时，暂停轮询" << slave.backoffMs << "毫秒";
+        } else if (entry.attempts <= m_options.retries && !entry.staleDeadline.hasExpired()) {
+            // 重试排在队首，超时占用的总线时间计入所属标签
+            ++slave.statistics.retries;
+            m_tagBusTimeUs[entry.tag] += rttUs;
+            m_queue.prepend(entry);
+            return;
+        }
+
+        emit requestFailed(slaveId, QString("Modbus请求超时 - 从站: %1").arg(slaveId));
+        resolve(entry, rttUs);
+        return;
+    }
+
+    ++slave.statistics.errors;
+    emit requestFailed(slaveId, QString("Modbus响应错误: %1 - 从站: %2").arg(reply->errorString()).arg(slaveId));
+    resolve(entry, rttUs);
+}
+
+void ModbusRequestPipeline::resolve(const Entry &entry, qint64 busTimeUs)
+{
+    if (entry.generation != m_generation) {
+        return;
+    }
+
+    m_tagBusTimeUs[entry.tag] += busTimeUs;
+
+    auto it = m_outstanding.find(entry.tag);
+    if (it == m_outstanding.end()) {
+        return;
+    }
+    if (--it.value() > 0) {
+        return;
+    }
+
+    m_outstanding.erase(it);
+    emit tagFinished(entry.tag, m_tagBusTimeUs.take(entry.tag));
+}
+
+QModbusDataUnit::RegisterType ModbusRequestPipeline::registerType(int functionCode)
+{
+    switch (functionCode) {
+        case 1: return QModbusDataUnit::Coils;
+        case 2: return QModbusDataUnit::DiscreteInputs;
+        case 3: return QModbusDataUnit::HoldingRegisters;
+        case 4: return QModbusDataUnit::InputRegisters;
+        default: return QModbusDataUnit::Invalid;
+    }
+}
+
+} // namespace Device
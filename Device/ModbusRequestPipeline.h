@@ -0,0 +1,179 @@
+#ifndef MODBUSREQUESTPIPELINE_H
+#define MODBUSREQUESTPIPELINE_H
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QMap>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QModbusClient>
+#include <QModbusDataUnit>
+#include <QModbusReply>
+#include "ModbusRequestPlanner.h"
+
+namespace Device {
+
+/**
+ * @brief Modbus请求流水线
+ * 在设备与QModbusClient之间限制同时在途的请求数，其余请求在流水线队列中等待：
+ * - 每个请求带一个过期时间，发出前已过期（同一轮询组的下一周期已到）的请求直接丢弃；
+ * - 超时按配置重试，从站连续超时达到阈值后进入静默退避，期间跳过它的请求，避免拖慢同一总线上的其他从站；
+ * - 按从站统计请求数、应答数、超时、错误、重试、丢弃数和往返时间。
+ * 请求按标签（轮询组）归并，一个标签的全部请求结束（成功、失败或丢弃）时发出tagFinished。
+ */
+class ModbusRequestPipeline : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 流水线参数
+     */
+    struct Options {
+        int maxInFlight = 1;            // 同时在途的最大请求数
+        int timeoutMs = 200;            // 单次请求超时（毫秒）
+        int retries = 1;                // 超时后的重试次数
+        int silentThreshold = 3;        // 连续超时多少次后认为从站静默
+        int silentBackoffMs = 1000;     // 静默退避的初始时间（毫秒）
+        int maxSilentBackoffMs = 10000; // 静默退避的最长时间（毫秒）
+    };
+
+    /**
+     * @brief 从站统计
+     */
+    struct SlaveStatistics {
+        quint64 requests = 0;           // 发出的请求数（含重试）
+        quint64 responses = 0;          // 成功应答数
+        quint64 timeouts = 0;           // 超时次数
+        quint64 errors = 0;             // 其他错误次数
+        quint64 retries = 0;            // 重试次数
+        quint64 staleSkipped = 0;       // 因过期丢弃的请求数
+        quint64 silentSkipped = 0;      // 因从站静默跳过的请求数
+        double minRttMs = 0.0;          // 最小往返时间（毫秒）
+        double averageRttMs = 0.0;      // 平均往返时间（毫秒）
+        double maxRttMs = 0.0;          // 最大往返时间（毫秒）
+        bool silent = false;            // 当前是否处于静默退避
+    };
+
+    explicit ModbusRequestPipeline(QObject *parent = nullptr);
+
+    /**
+     * @brief 设置Modbus客户端（客户端重建时需要重新设置）
+     * @param client 客户端
+     */
+    void setClient(QModbusClient *client);
+
+    /**
+     * @brief 设置流水线参数，并把超时写入客户端（客户端自身不再重试）
+     * @param options 参数
+     */
+    void setOptions(const Options &options);
+
+    /**
+     * @brief 获取流水线参数
+     */
+    Options options() const { return m_options; }
+
+    /**
+     * @brief 提交读请求
+     * @param request 读请求
+     * @param tag 标签（轮询组）
+     * @param staleDeadline 过期时间，过期后尚未发出的请求会被丢弃
+     */
+    void submit(const ModbusReadRequest &request, int tag, const QDeadlineTimer &staleDeadline);
+
+    /**
+     * @brief 提交一组读请求（同一标签）
+     * 先把全部请求入队并计数，再统一发送；组内请求即使同步结束（过期、发送失败），
+     * 标签也只会在整组结束后发出一次tagFinished
+     * @param requests 读请求
+     * @param tag 标签（轮询组）
+     * @param staleDeadline 过期时间，过期后尚未发出的请求会被丢弃
+     */
+    void submitGroup(const QList<ModbusReadRequest> &requests, int tag, const QDeadlineTimer &staleDeadline);
+
+    /**
+     * @brief 清空队列；在途请求的结果将被忽略
+     */
+    void clear();
+
+    /**
+     * @brief 队列中尚未发出的请求数
+     */
+    int queuedCount() const { return m_queue.size(); }
+
+    /**
+     * @brief 在途请求数
+     */
+    int inFlightCount() const { return m_inFlight.size(); }
+
+    /**
+     * @brief 获取并清零从站统计（静默状态保留）
+     * @return 从站ID -> 统计
+     */
+    QMap<int, SlaveStatistics> takeStatistics();
+
+signals:
+    /**
+     * @brief 读请求成功
+     * @param slaveId 从站ID
+     * @param unit 读取结果
+     */
+    void replyReady(int slaveId, const QModbusDataUnit &unit);
+
+    /**
+     * @brief 读请求最终失败（重试用尽或非超时错误）
+     * @param slaveId 从站ID
+     * @param error 错误信息
+     */
+    void requestFailed(int slaveId, const QString &error);
+
+    /**
+     * @brief 一个标签的全部请求已结束
+     * @param tag 标签
+     * @param busTimeUs 这些请求在总线上的累计往返时间（微秒）
+     */
+    void tagFinished(int tag, qint64 busTimeUs);
+
+private slots:
+    void onReplyFinished();
+
+private:
+    struct Entry {
+        ModbusReadRequest request;
+        int tag = 0;
+        QDeadlineTimer staleDeadline;
+        int attempts = 0;               // 已发送次数
+        quint64 generation = 0;         // 提交时的代数
+        QElapsedTimer sentTimer;        // 发送计时
+    };
+
+    struct SlaveState {
+        SlaveStatistics statistics;
+        int consecutiveTimeouts = 0;
+        int backoffMs = 0;
+        QDeadlineTimer silentUntil;     // 静默退避结束时间
+        double rttSumMs = 0.0;
+    };
+
+    void pump();
+    bool send(Entry &entry);
+    void handleReply(Entry &entry, QModbusReply *reply);
+    void resolve(const Entry &entry, qint64 busTimeUs);
+    static QModbusDataUnit::RegisterType registerType(int functionCode);
+
+    QModbusClient *m_client;
+    Options m_options;
+    QList<Entry> m_queue;                   // 等待发送的请求
+    QHash<QModbusReply *, Entry> m_inFlight; // 在途请求
+    QHash<int, int> m_outstanding;          // 标签 -> 未结束的请求数
+    QHash<int, qint64> m_tagBusTimeUs;      // 标签 -> 累计往返时间
+    QMap<int, SlaveState> m_slaves;         // 从站ID -> 状态
+    quint64 m_generation;                   // 代数，clear()时递增
+    bool m_pumping;                         // 防止pump重入
+};
+
+} // namespace Device
+
+#endif // MODBUSREQUESTPIPELINE_H
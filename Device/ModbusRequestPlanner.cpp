@@ -0,0 +1,151 @@
+#include "ModbusRequestPlanner.h"
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace Device {
+
+namespace {
+
+constexpr int REQUEST_FRAME_BYTES = 8;     // 从站地址 + 功能码 + 起始地址(2) + 数量(2) + CRC(2)
+constexpr int RESPONSE_HEADER_BYTES = 5;   // 从站地址 + 功能码 + 字节数 + CRC(2)
+constexpr double DEFAULT_TURNAROUND_US = 5000.0;
+constexpr double TCP_BYTE_TIME_US = 0.08;
+
+} // namespace
+
+ModbusRequestPlanner::ModbusRequestPlanner(const Core::SerialConfig& serialConfig)
+    : m_turnaroundUs(DEFAULT_TURNAROUND_US)
+{
+    int baudrate = serialConfig.baudrate > 0 ? serialConfig.baudrate : 9600;
+    m_characterTimeUs = serialConfig.characterTimeUs();
+
+    // Modbus RTU规范：波特率高于19200时帧间静默固定为1.75毫秒
+    m_frameSilenceUs = baudrate > 19200 ? 1750.0 : 3.5 * m_characterTimeUs;
+}
+
+ModbusRequestPlanner::ModbusRequestPlanner(double characterTimeUs, double frameSilenceUs, double turnaroundUs)
+    : m_characterTimeUs(characterTimeUs)
+    , m_frameSilenceUs(frameSilenceUs)
+    , m_turnaroundUs(turnaroundUs)
+{
+}
+
+ModbusRequestPlanner ModbusRequestPlanner::forTcp(double roundTripMs)
+{
+    // 按100Mbit/s估算字节时间，TCP没有帧间静默
+    return ModbusRequestPlanner(TCP_BYTE_TIME_US, 0.0, qMax(0.0, roundTripMs * 1000.0));
+}
+
+void ModbusRequestPlanner::setSlaveTurnaroundMs(double turnaroundMs)
+{
+    m_turnaroundUs = qMax(0.0, turnaroundMs * 1000.0);
+}
+
+int ModbusRequestPlanner::maxReadCount(int functionCode)
+{
+    return (functionCode == 1 || functionCode == 2) ? MAX_READ_BITS : MAX_READ_REGISTERS;
+}
+
+double ModbusRequestPlanner::requestCostUs(int functionCode, int count) const
+{
+    int payloadBytes = (functionCode == 1 || functionCode == 2) ? (count + 7) / 8 : count * 2;
+    int bytes = REQUEST_FRAME_BYTES + RESPONSE_HEADER_BYTES + payloadBytes;
+
+    return bytes * m_characterTimeUs + 2.0 * m_frameSilenceUs + m_turnaroundUs;
+}
+
+QList<ModbusReadRequest> ModbusRequestPlanner::plan(const QList<Core::ModbusSlaveConfig>& slaves) const
+{
+    QList<ModbusReadRequest> requests;
+    double totalCostUs = 0.0;
+    int registerCount = 0;
+
+    for (const auto& slave : slaves) {
+        // 线圈和离散输入每个通道占一位，寄存器按数据类型占1/2/4个
+        const bool bitAccess = slave.operationCommand == 1 || slave.operationCommand == 2;
+        QVector<ModbusRegisterSpan> spans;
+        spans.reserve(slave.registers.size());
+        for (const auto& reg : slave.registers) {
+            ModbusRegisterSpan span;
+            span.address = reg.registerAddress;
+            span.count = bitAccess ? 1 : reg.registerCount();
+            spans.append(span);
+        }
+
+        const QList<ModbusReadRequest> slaveRequests = planSlave(slave.slaveId, slave.operationCommand, spans);
+        for (const auto& request : slaveRequests) {
+            totalCostUs += request.costUs;
+            registerCount += request.usedCount;
+        }
+        requests.append(slaveRequests);
+    }
+
+    qDebug() << "Modbus读请求计划 - 寄存器数:" << registerCount
+             << "请求数:" << requests.size()
+             << "估算每周期总线时间:" << totalCostUs / 1000.0 << "毫秒";
+
+    return requests;
+}
+
+QList<ModbusReadRequest> ModbusRequestPlanner::planSlave(int slaveId, int functionCode, QVector<ModbusRegisterSpan> spans) const
+{
+    QList<ModbusReadRequest> requests;
+
+    std::sort(spans.begin(), spans.end(), [](const ModbusRegisterSpan& a, const ModbusRegisterSpan& b) {
+        return a.address < b.address || (a.address == b.address && a.count > b.count);
+    });
+    spans.erase(std::unique(spans.begin(), spans.end(), [](const ModbusRegisterSpan& a, const ModbusRegisterSpan& b) {
+        return a.address == b.address;
+    }), spans.end());
+    const int n = spans.size();
+    if (n == 0) {
+        return requests;
+    }
+
+    const int maxCount = maxReadCount(functionCode);
+
+    // best[i]：前i个区间的最小代价；split[i]：最后一个请求覆盖的第一个区间下标
+    QVector<double> best(n + 1, std::numeric_limits<double>::infinity());
+    QVector<int> split(n + 1, 0);
+    QVector<int> end(n + 1, 0);
+    best[0] = 0.0;
+
+    for (int i = 1; i <= n; ++i) {
+        // 最后一个请求覆盖spans[j..i-1]，跨度受PDU上限约束
+        int last = spans[i - 1].address + spans[i - 1].count - 1;
+        for (int j = i - 1; j >= 0; --j) {
+            last = qMax(last, spans[j].address + spans[j].count - 1);
+            const int count = last - spans[j].address + 1;
+            if (count > maxCount) {
+                break;
+            }
+            const double cost = best[j] + requestCostUs(functionCode, count);
+            if (cost < best[i]) {
+                best[i] = cost;
+                split[i] = j;
+                end[i] = last;
+            }
+        }
+    }
+
+    // 回溯得到请求区间
+    for (int i = n; i > 0; i = split[i]) {
+        const int j = split[i];
+        ModbusReadRequest request;
+        request.slaveId = slaveId;
+        request.functionCode = functionCode;
+        request.startAddress = spans[j].address;
+        request.count = end[i] - spans[j].address + 1;
+        request.usedCount = 0;
+        for (int k = j; k < i; ++k) {
+            request.usedCount += spans[k].count;
+        }
+        request.costUs = requestCostUs(functionCode, request.count);
+        requests.prepend(request);
+    }
+
+    return requests;
+}
+
+} // namespace Device
@@ -0,0 +1,112 @@
+#ifndef MODBUSREQUESTPLANNER_H
+#define MODBUSREQUESTPLANNER_H
+
+#include <QList>
+#include <QVector>
+#include "../Core/DataTypes.h"
+
+namespace Device {
+
+/**
+ * @brief Modbus读请求
+ * 一次读请求覆盖的寄存器区间
+ */
+struct ModbusReadRequest {
+    int slaveId = 0;          // 从站ID
+    int functionCode = 3;     // 功能码
+    int startAddress = 0;     // 起始地址
+    int count = 0;            // 读取数量（含被桥接的空隙）
+    int usedCount = 0;        // 其中配置了通道的寄存器数量
+    double costUs = 0.0;      // 估算的总线占用时间（微秒）
+};
+
+/**
+ * @brief Modbus寄存器区间
+ * 一个通道占用的连续寄存器（32/64位数据占2/4个），规划时不会被拆到两次请求中
+ */
+struct ModbusRegisterSpan {
+    int address = 0;          // 起始地址
+    int count = 1;            // 寄存器数量
+};
+
+/**
+ * @brief Modbus请求规划器
+ * 在配置阶段为每个从站计算一次读请求计划：
+ * 在总线上每多一次请求要付出请求帧、应答帧头尾、两段帧间静默和从站响应时间，
+ * 而多读一个寄存器只多两个字节，因此当空隙较小时把相邻区间合并读取更快。
+ * 代价模型按SerialConfig的波特率、数据位、校验位、停止位计算字符时间，
+ * 用动态规划在单次请求的PDU上限（寄存器125个，线圈/离散输入2000个）内求总代价最小的划分。
+ */
+class ModbusRequestPlanner
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param serialConfig 串口配置（用于计算字符时间）
+     */
+    explicit ModbusRequestPlanner(const Core::SerialConfig& serialConfig);
+
+    /**
+     * @brief 创建Modbus TCP的请求规划器
+     * 以太网上传输时间可以忽略，每次请求的代价主要是一次网络往返，因此空隙几乎总是合并读取
+     * @param roundTripMs 估算的请求往返时间（毫秒）
+     * @return 请求规划器
+     */
+    static ModbusRequestPlanner forTcp(double roundTripMs);
+
+    /**
+     * @brief 设置从站响应时间（收到请求到开始应答的时间）
+     * @param turnaroundMs 响应时间（毫秒）
+     */
+    void setSlaveTurnaroundMs(double turnaroundMs);
+
+    /**
+     * @brief 为所有从站生成读请求计划
+     * @param slaves 从站配置列表
+     * @return 读请求列表（按从站、地址排序）
+     */
+    QList<ModbusReadRequest> plan(const QList<Core::ModbusSlaveConfig>& slaves) const;
+
+    /**
+     * @brief 为单个从站生成读请求计划
+     * @param slaveId 从站ID
+     * @param functionCode 功能码
+     * @param spans 通道占用的寄存器区间（可无序、可重叠）
+     * @return 读请求列表
+     */
+    QList<ModbusReadRequest> planSlave(int slaveId, int functionCode, QVector<ModbusRegisterSpan> spans) const;
+
+    /**
+     * @brief 估算一次读请求的总线占用时间
+     * @param functionCode 功能码
+     * @param count 读取数量
+     * @return 时间（微秒）
+     */
+    double requestCostUs(int functionCode, int count) const;
+
+    /**
+     * @brief 单次请求允许读取的最大数量
+     * @param functionCode 功能码
+     * @return 最大数量
+     */
+    static int maxReadCount(int functionCode);
+
+    /**
+     * @brief 字符时间（微秒）
+     */
+    double characterTimeUs() const { return m_characterTimeUs; }
+
+    static constexpr int MAX_READ_REGISTERS = 125;   // 功能码3/4单次最多读取的寄存器数
+    static constexpr int MAX_READ_BITS = 2000;       // 功能码1/2单次最多读取的位数
+
+private:
+    ModbusRequestPlanner(double characterTimeUs, double frameSilenceUs, double turnaroundUs);
+
+    double m_characterTimeUs;     // 一个字符（起始位+数据位+校验位+停止位）的传输时间
+    double m_frameSilenceUs;      // 帧间静默时间（3.5个字符，波特率高于19200时固定1750微秒）
+    double m_turnaroundUs;        // 从站响应时间
+};
+
+} // namespace Device
+
+#endif // MODBUSREQUESTPLANNER_H
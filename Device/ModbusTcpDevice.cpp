@@ -0,0 +1,463 @@
+#include "ModbusTcpDevice.h"
+#include "../Core/Log.h"
+#include "../Core/Metrics.h"
+#ifdef DAQ_SIMULATED_PEERS
+#include "../Simulation/ModbusTcpServerSimulator.h"
+#endif
+#include <QThread>
+#include <QDateTime>
+#include <QMap>
+
+namespace Device {
+
+namespace {
+
+constexpr double TCP_ROUND_TRIP_MS = 2.0;       // 规划读请求时估算的网络往返时间
+constexpr int RECONNECT_INTERVAL_MS = 5000;     // 断开连接的重连间隔
+
+} // namespace
+
+ModbusTcpDevice::ModbusTcpDevice(const Core::ModbusDeviceConfig& config, QObject *parent)
+    : AbstractDevice(parent)
+    , m_config(config)
+    , m_channelMap(config.slaves)
+    , m_pollScheduler(config, ModbusRequestPlanner::forTcp(TCP_ROUND_TRIP_MS))
+    , m_simulator(nullptr)
+    , m_timer(new QTimer(this))
+    , m_lastStatisticsUs(0)
+    , m_isAcquiring(false)
+{
+    // 单次定时器，由轮询调度器按最早截止时间重新启动
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(0);
+    connect(m_timer, &QTimer::timeout, this, &ModbusTcpDevice::readModbusData);
+
+    m_clock.start();
+
+    qDebug() << "创建Modbus TCP设备:" << m_config.instanceName
+             << "地址:" << (m_config.tcpConfig.simulated ? QStringLiteral("模拟服务器") : m_config.tcpConfig.host)
+             << "端口:" << m_config.tcpConfig.port
+             << "连接数:" << m_config.tcpConfig.connections
+             << "每连接在途请求:" << m_config.maxInFlight
+             << "从站数量:" << m_config.slaves.size();
+}
+
+ModbusTcpDevice::~ModbusTcpDevice()
+{
+    stopAcquisition();
+    disconnectDevice();
+
+    qDebug() << "销毁Modbus TCP设备:" << m_config.instanceName;
+}
+
+bool ModbusTcpDevice::connectDevice()
+{
+    // 客户端和socket必须在设备线程中创建
+    if (QThread::currentThread() != thread()) {
+        bool result = false;
+        QMetaObject::invokeMethod(this, [this, &result]() {
+            result = connectDevice();
+        }, Qt::BlockingQueuedConnection);
+        return result;
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    // 首次连接时创建模拟服务器和各连接
+#ifdef DAQ_SIMULATED_PEERS
+    if (m_config.tcpConfig.simulated && !m_simulator) {
+        m_simulator = new Simulation::ModbusTcpServerSimulator(this);
+        if (!m_simulator->listen(QHostAddress::LocalHost, 0)) {
+            setStatus(Core::StatusCode::ERROR_CONNECTION, "Modbus TCP模拟服务器启动失败");
+            delete m_simulator;
+            m_simulator = nullptr;
+            return false;
+        }
+    }
+#else
+    if (m_config.tcpConfig.simulated) {
+        setStatus(Core::StatusCode::ERROR_CONFIG, "未启用模拟对端，无法使用simulated服务器（构建时开启DAQ_SIMULATED_PEERS）");
+        return false;
+    }
+#endif
+
+    if (m_connections.isEmpty()) {
+        ModbusRequestPipeline::Options options;
+        options.maxInFlight = m_config.maxInFlight;
+        options.timeoutMs = m_config.timeoutMs;
+        options.retries = m_config.retries;
+
+        for (int i = 0; i < qMax(1, m_config.tcpConfig.connections); ++i) {
+            Connection connection;
+            connection.client = new QModbusTcpClient(this);
+            connection.pipeline = new ModbusRequestPipeline(this);
+            connection.pipeline->setOptions(options);
+            connection.pipeline->setClient(connection.client);
+
+            // connectDevice()/disconnectDevice()会同步发出stateChanged，而调用方持有m_mutex，
+            // 排队到事件循环处理，避免onConnectionStateChanged重复加锁造成死锁
+            connect(connection.client, &QModbusClient::stateChanged, this, &ModbusTcpDevice::onConnectionStateChanged,
+                    Qt::QueuedConnection);
+            connect(connection.pipeline, &ModbusRequestPipeline::replyReady, this, &ModbusTcpDevice::processModbusResponse);
+            connect(connection.pipeline, &ModbusRequestPipeline::requestFailed, this, &ModbusTcpDevice::onRequestFailed);
+            connect(connection.pipeline, &ModbusRequestPipeline::tagFinished, this, &ModbusTcpDevice::onPollGroupFinished,
+                    Qt::QueuedConnection);
+
+            m_connections.append(connection);
+        }
+    }
+
+    const QString host = m_simulator ? QStringLiteral("127.0.0.1") : m_config.tcpConfig.host;
+    const int port = serverPort();
+
+    int started = 0;
+    for (const auto& connection : m_connections) {
+        if (connection.client->state() != QModbusDevice::UnconnectedState) {
+            ++started;
+            continue;
+        }
+
+        connection.client->setConnectionParameter(QModbusDevice::NetworkAddressParameter, host);
+        connection.client->setConnectionParameter(QModbusDevice::NetworkPortParameter, port);
+        if (connection.client->connectDevice()) {
+            ++started;
+        } else {
+            qDebug() << "Modbus TCP连接失败:" << host << port << connection.client->errorString()
+                     << "设备:" << getDeviceId();
+        }
+    }
+    m_sinceReconnect.start();
+
+    if (started == 0) {
+        setStatus(Core::StatusCode::ERROR_CONNECTION, QString("Modbus TCP连接失败: %1:%2").arg(host).arg(port));
+        return false;
+    }
+
+    // 连接建立是异步的，全部或部分连接成功后在onConnectionStateChanged中更新状态
+    if (connectedCount() == 0) {
+        setStatus(Core::StatusCode::CONNECTING, "Modbus TCP设备正在连接");
+    } else if (!m_isAcquiring) {
+        setStatus(Core::StatusCode::CONNECTED, "Modbus TCP设备已连接");
+    }
+    return true;
+}
+
+bool ModbusTcpDevice::disconnectDevice()
+{
+    stopAcquisition();
+
+    QMutexLocker locker(&m_mutex);
+    for (const auto& connection : m_connections) {
+        if (connection.client->state() != QModbusDevice::UnconnectedState) {
+            connection.client->disconnectDevice();
+        }
+    }
+
+    setStatus(Core::StatusCode::DISCONNECTED, "Modbus TCP设备已断开连接");
+    return true;
+}
+
+void ModbusTcpDevice::startAcquisition()
+{
+    if (m_status != Core::StatusCode::CONNECTED && m_status != Core::StatusCode::STOPPED
+        && m_status != Core::StatusCode::CONNECTING) {
+        if (!connectDevice()) {
+            emit errorOccurred(getDeviceId(), "无法开始采集：设备连接失败");
+            return;
+        }
+    }
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_isAcquiring) {
+        qDebug() << "设备已经在采集数据，忽略重复启动:" << getDeviceId();
+        return;
+    }
+
+    m_isAcquiring = true;
+
+    // 所有轮询组从现在开始到期
+    for (const auto& connection : m_connections) {
+        connection.pipeline->clear();
+    }
+    m_groupPending.clear();
+    m_groupBusTimeUs.clear();
+    m_pollScheduler.reset(monotonicUs());
+    m_lastStatisticsUs = monotonicUs();
+
+    QMetaObject::invokeMethod(m_timer, "start", Qt::QueuedConnection);
+
+    setStatus(Core::StatusCode::ACQUIRING, "Modbus TCP设备正在采集数据");
+    qDebug() << "Modbus TCP设备" << m_config.instanceName << "开始采集数据";
+}
+
+void ModbusTcpDevice::stopAcquisition()
+{
+    QMutexLocker locker(&m_mutex);
+    m_isAcquiring = false;
+
+    for (const auto& connection : m_connections) {
+        connection.pipeline->clear();
+    }
+    m_groupPending.clear();
+    m_groupBusTimeUs.clear();
+
+    if (m_timer && m_timer->isActive()) {
+        QMetaObject::invokeMethod(m_timer, "stop", Qt::QueuedConnection);
+    }
+
+    if (m_status == Core::StatusCode::ACQUIRING) {
+        setStatus(Core::StatusCode::STOPPED, "Modbus TCP设备已停止采集");
+        qDebug() << "Modbus TCP设备" << m_config.instanceName << "停止采集数据";
+    }
+}
+
+QString ModbusTcpDevice::getDeviceId() const
+{
+    return m_config.deviceId;
+}
+
+Core::DeviceType ModbusTcpDevice::getDeviceType() const
+{
+    return Core::DeviceType::MODBUS;
+}
+
+int ModbusTcpDevice::serverPort() const
+{
+#ifdef DAQ_SIMULATED_PEERS
+    if (m_simulator) {
+        return m_simulator->serverPort();
+    }
+#endif
+    return m_config.tcpConfig.port;
+}
+
+void ModbusTcpDevice::readModbusData()
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (!m_isAcquiring) {
+        return;
+    }
+
+    // 定期重连断开的连接
+    if (m_sinceReconnect.isValid() && m_sinceReconnect.elapsed() >= RECONNECT_INTERVAL_MS) {
+        const QString host = m_simulator ? QStringLiteral("127.0.0.1") : m_config.tcpConfig.host;
+        const int port = serverPort();
+        for (const auto& connection : m_connections) {
+            if (connection.client->state() == QModbusDevice::UnconnectedState) {
+                qDebug() << "尝试重新连接Modbus TCP服务器:" << host << port << "设备:" << getDeviceId();
+                connection.client->setConnectionParameter(QModbusDevice::NetworkAddressParameter, host);
+                connection.client->setConnectionParameter(QModbusDevice::NetworkPortParameter, port);
+                connection.client->connectDevice();
+            }
+        }
+        m_sinceReconnect.restart();
+    }
+
+    // 没有可用连接时按读取周期重试
+    if (connectedCount() == 0) {
+        m_timer->start(m_config.readCycleMs);
+        return;
+    }
+
+    pollDueGroups();
+}
+
+void ModbusTcpDevice::pollDueGroups()
+{
+    // 流水线队列中还有未发出的请求时不再提交，等组结束后再调度
+    while (queuedCount() == 0) {
+        const qint64 nowUs = monotonicUs();
+        const int group = m_pollScheduler.takeDueGroup(nowUs);
+        if (group < 0) {
+            scheduleNextPoll();
+            return;
+        }
+
+        const qint64 staleMs = qMax<qint64>(0, (m_pollScheduler.groupDeadlineUs(group) - nowUs) / 1000);
+        const QDeadlineTimer staleDeadline(staleMs, Qt::PreciseTimer);
+
+        // 每个请求分给负载最轻的已连接连接（计入本组已分配的请求），再按连接整组提交
+        QMap<int, QList<ModbusReadRequest>> assigned;
+        for (const auto& request : m_pollScheduler.groupRequests(group)) {
+            int selected = -1;
+            int selectedLoad = 0;
+            for (int i = 0; i < m_connections.size(); ++i) {
+                const Connection& connection = m_connections[i];
+                if (connection.client->state() != QModbusDevice::ConnectedState) {
+                    continue;
+                }
+                const int load = connection.pipeline->queuedCount() + connection.pipeline->inFlightCount()
+                                 + assigned.value(i).size();
+                if (selected < 0 || load < selectedLoad) {
+                    selected = i;
+                    selectedLoad = load;
+                }
+            }
+            if (selected < 0) {
+                break;
+            }
+            assigned[selected].append(request);
+        }
+
+        if (assigned.isEmpty()) {
+            // 连接全部断开
+            m_pollScheduler.completeGroup(group, 0);
+            m_timer->start(m_config.readCycleMs);
+            return;
+        }
+
+        // 先登记待完成的连接数再提交，tagFinished为排队连接，不会在登记前到达
+        m_groupPending[group] = assigned.size();
+        m_groupBusTimeUs[group] = 0;
+        for (auto it = assigned.constBegin(); it != assigned.constEnd(); ++it) {
+            m_connections[it.key()].pipeline->submitGroup(it.value(), group, staleDeadline);
+        }
+    }
+}
+
+void ModbusTcpDevice::onPollGroupFinished(int group, qint64 busTimeUs)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_groupPending.find(group);
+    if (it == m_groupPending.end()) {
+        return;
+    }
+
+    // 各连接并行工作，组的耗时取各连接中最长的
+    m_groupBusTimeUs[group] = qMax(m_groupBusTimeUs.value(group), busTimeUs);
+    if (--it.value() > 0) {
+        return;
+    }
+
+    m_groupPending.erase(it);
+    m_pollScheduler.completeGroup(group, m_groupBusTimeUs.take(group));
+    reportStatistics();
+
+    if (m_isAcquiring) {
+        pollDueGroups();
+    }
+}
+
+void ModbusTcpDevice::onRequestFailed(int slaveId, const QString &error)
+{
+    // 从站离线时每个周期都会失败，限频输出
+    DAQ_LOG_EVERY_MS(1000, QtWarningMsg, lcDevice, "%s 从站: %d 设备: %s",
+                     qUtf8Printable(error), slaveId, qUtf8Printable(getDeviceId()));
+    emit errorOccurred(getDeviceId(), error);
+}
+
+void ModbusTcpDevice::onConnectionStateChanged(QModbusDevice::State state)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (state == QModbusDevice::ConnectedState) {
+        qDebug() << "Modbus TCP连接已建立，已连接:" << connectedCount() << "/" << m_connections.size()
+                 << "设备:" << getDeviceId();
+        if (m_isAcquiring) {
+            // 新连接可用，立即调度
+            m_timer->start(0);
+        } else if (m_status != Core::StatusCode::CONNECTED && m_status != Core::StatusCode::STOPPED) {
+            setStatus(Core::StatusCode::CONNECTED, "Modbus TCP设备已连接");
+        }
+    } else if (state == QModbusDevice::UnconnectedState && connectedCount() == 0 && m_isAcquiring) {
+        QString errorMsg = "Modbus TCP连接全部断开";
+        qDebug() << errorMsg << "设备:" << getDeviceId();
+        emit errorOccurred(getDeviceId(), errorMsg);
+    }
+}
+
+void ModbusTcpDevice::processModbusResponse(int slaveId, const QModbusDataUnit &unit)
+{
+    Core::Metrics::ScopedTimer readTimer(Core::Metrics::DeviceRead);
+
+    // 获取当前时间戳
+    qint64 timestamp = Core::Timebase::nowNs();
+
+    // 处理配置了通道的寄存器（合并读取的空隙寄存器已跳过）
+    for (const auto& value : m_channelMap.extract(slaveId, unit)) {
+        emit rawDataPointReady(getDeviceId(), value.hardwareChannel, applyFilter(value.rawValue), timestamp);
+        Core::Metrics::increment(Core::Metrics::RawSamples);
+    }
+}
+
+void ModbusTcpDevice::scheduleNextPoll()
+{
+    if (!m_isAcquiring) {
+        return;
+    }
+
+    const qint64 deadlineUs = m_pollScheduler.nextDeadlineUs();
+    if (deadlineUs < 0) {
+        return;
+    }
+
+    const qint64 delayUs = deadlineUs - monotonicUs();
+    m_timer->start(delayUs > 0 ? static_cast<int>((delayUs + 999) / 1000) : 0);
+}
+
+void ModbusTcpDevice::reportStatistics()
+{
+    const qint64 nowUs = monotonicUs();
+    if (nowUs - m_lastStatisticsUs < 5000000) {
+        return;
+    }
+    m_lastStatisticsUs = nowUs;
+
+    qDebug() << "Modbus TCP轮询统计 - 设备:" << getDeviceId()
+             << "已连接:" << connectedCount() << "/" << m_connections.size()
+             << "负载率:" << m_pollScheduler.busUtilization();
+    for (const auto& stats : m_pollScheduler.takeStatistics()) {
+        qDebug() << "  轮询组:" << stats.name
+                 << "周期:" << stats.configuredCycleMs << "->" << stats.effectiveCycleMs << "毫秒"
+                 << "耗时:" << stats.busTimeMs << "毫秒"
+                 << "轮询次数:" << stats.polls
+                 << "延迟次数:" << stats.latePolls
+                 << "丢失周期:" << stats.missedCycles;
+    }
+
+    for (int i = 0; i < m_connections.size(); ++i) {
+        const auto slaveStatistics = m_connections[i].pipeline->takeStatistics();
+        for (auto it = slaveStatistics.constBegin(); it != slaveStatistics.constEnd(); ++it) {
+            const auto& stats = it.value();
+            qDebug() << "  连接:" << i
+                     << "从站:" << it.key()
+                     << "请求:" << stats.requests
+                     << "应答:" << stats.responses
+                     << "超时:" << stats.timeouts
+                     << "错误:" << stats.errors
+                     << "过期丢弃:" << stats.staleSkipped
+                     << "往返时间(最小/平均/最大):" << stats.minRttMs << "/" << stats.averageRttMs << "/" << stats.maxRttMs << "毫秒";
+        }
+    }
+}
+
+int ModbusTcpDevice::connectedCount() const
+{
+    int count = 0;
+    for (const auto& connection : m_connections) {
+        if (connection.client->state() == QModbusDevice::ConnectedState) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+int ModbusTcpDevice::queuedCount() const
+{
+    int count = 0;
+    for (const auto& connection : m_connections) {
+        count += connection.pipeline->queuedCount();
+    }
+    return count;
+}
+
+qint64 ModbusTcpDevice::monotonicUs() const
+{
+    return m_clock.nsecsElapsed() / 1000;
+}
+
+} // namespace Device
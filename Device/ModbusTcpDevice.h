@@ -0,0 +1,143 @@
+#ifndef MODBUSTCPDEVICE_H
+#define MODBUSTCPDEVICE_H
+
+#include "AbstractDevice.h"
+#include "ModbusPollScheduler.h"
+#include "ModbusRequestPipeline.h"
+#include "ModbusChannelMap.h"
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QModbusTcpClient>
+#include <QModbusDataUnit>
+#include <QVector>
+#include <QHash>
+#include <QMutex>
+
+namespace Simulation {
+class ModbusTcpServerSimulator;
+}
+
+namespace Device {
+
+/**
+ * @brief Modbus TCP设备类
+ * 与服务器保持多个并发连接，每个连接一条请求流水线；
+ * QModbusTcpClient用事务号匹配应答，同一连接上可以同时有多个请求在途。
+ * 轮询组调度、读请求规划和通道映射与串口ModbusDevice共用。
+ */
+class ModbusTcpDevice : public AbstractDevice
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 构造函数
+     * @param config Modbus设备配置（transport为tcp）
+     * @param parent 父对象
+     */
+    explicit ModbusTcpDevice(const Core::ModbusDeviceConfig& config, QObject *parent = nullptr);
+
+    /**
+     * @brief 析构函数
+     */
+    ~ModbusTcpDevice() override;
+
+    /**
+     * @brief 连接设备（建立全部连接）
+     * @return 是否成功发起连接
+     */
+    bool connectDevice() override;
+
+    /**
+     * @brief 断开设备连接
+     * @return 是否成功断开
+     */
+    bool disconnectDevice() override;
+
+    /**
+     * @brief 开始数据采集
+     */
+    void startAcquisition() override;
+
+    /**
+     * @brief 停止数据采集
+     */
+    void stopAcquisition() override;
+
+    /**
+     * @brief 获取设备ID
+     * @return 设备ID
+     */
+    QString getDeviceId() const override;
+
+    /**
+     * @brief 获取设备类型
+     * @return 设备类型
+     */
+    Core::DeviceType getDeviceType() const override;
+
+private slots:
+    /**
+     * @brief 定时器触发时提交到期的轮询组，并重连断开的连接
+     */
+    void readModbusData();
+
+    /**
+     * @brief 处理Modbus响应
+     * @param slaveId 从站ID
+     * @param unit 读取结果
+     */
+    void processModbusResponse(int slaveId, const QModbusDataUnit &unit);
+
+    /**
+     * @brief 某个连接上轮询组的请求已结束
+     * @param group 组索引
+     * @param busTimeUs 该连接上这些请求的累计往返时间（微秒）
+     */
+    void onPollGroupFinished(int group, qint64 busTimeUs);
+
+    /**
+     * @brief 请求最终失败
+     * @param slaveId 从站ID
+     * @param error 错误信息
+     */
+    void onRequestFailed(int slaveId, const QString &error);
+
+    /**
+     * @brief 连接状态变化
+     * @param state 新状态
+     */
+    void onConnectionStateChanged(QModbusDevice::State state);
+
+private:
+    struct Connection {
+        QModbusTcpClient* client = nullptr;
+        ModbusRequestPipeline* pipeline = nullptr;
+    };
+
+    void pollDueGroups();
+    void scheduleNextPoll();
+    void reportStatistics();
+    int connectedCount() const;
+    int queuedCount() const;
+    qint64 monotonicUs() const;
+    int serverPort() const;             // 连接的服务器端口（模拟时为模拟服务器端口）
+
+    Core::ModbusDeviceConfig m_config;                // 设备配置
+    ModbusChannelMap m_channelMap;                    // 从站ID/寄存器地址 -> 通道
+    ModbusPollScheduler m_pollScheduler;              // 轮询调度器
+    QVector<Connection> m_connections;                // 并发连接
+    QHash<int, int> m_groupPending;                   // 组 -> 尚未结束的连接数
+    QHash<int, qint64> m_groupBusTimeUs;              // 组 -> 各连接往返时间的最大值
+    Simulation::ModbusTcpServerSimulator* m_simulator; // 进程内模拟服务器（以DAQ_SIMULATED_PEERS构建且simulated为true时）
+    QTimer* m_timer;                                  // 单次调度定时器
+    QElapsedTimer m_clock;                            // 调度用单调时钟
+    QElapsedTimer m_sinceReconnect;                   // 距上次重连
+    qint64 m_lastStatisticsUs;                        // 上次输出统计的时间
+    QMutex m_mutex;                                   // 互斥锁，用于保护数据访问
+    bool m_isAcquiring;                               // 是否正在采集
+};
+
+} // namespace Device
+
+#endif // MODBUSTCPDEVICE_H
@@ -0,0 +1,245 @@
+#include "SignalGenerator.h"
+#include <QtMath>
+#include <cmath>
+
+namespace Device {
+
+namespace {
+
+// 通道间错开的相位（周），让多通道曲线可以区分
+constexpr double CHANNEL_PHASE_STEP = 0.125;
+
+// 四个[0,1)均匀数之和的方差为1/3，乘以sqrt(3)得到单位方差
+constexpr double NOISE_SCALE = 1.7320508075688772;
+
+// sin(a)在[-π/2, π/2]上的泰勒系数（a^1 .. a^11）
+constexpr double S1 = -1.0 / 6.0;
+constexpr double S2 = 1.0 / 120.0;
+constexpr double S3 = -1.0 / 5040.0;
+constexpr double S4 = 1.0 / 362880.0;
+constexpr double S5 = -1.0 / 39916800.0;
+
+} // namespace
+
+SignalGenerator::SignalGenerator(const Core::VirtualDeviceConfig& config)
+    : m_shape(parseShape(config.signalType))
+    , m_amplitude(config.amplitude)
+    , m_frequency(config.frequency)
+    , m_sampleRate(qBound(1.0, config.sampleRate, MAX_SAMPLE_RATE))
+    , m_channelCount(qMax(1, config.channelCount))
+    , m_noise(qMax(0.0, config.noise))
+    , m_harmonics(config.harmonics)
+    , m_chirpEndFrequency(config.chirpEndFrequency)
+    , m_chirpPeriodScans(0)
+    , m_steps(config.steps)
+    , m_stepPeriodSec(qMax(0.0, config.stepPeriodSec))
+    , m_position(0)
+    , m_randomState(0x9E3779B97F4A7C15ULL)
+{
+    if (config.chirpEndFrequency > 0.0 && config.chirpPeriodSec > 0.0) {
+        m_chirpPeriodScans = qMax<qint64>(1, qRound64(config.chirpPeriodSec * m_sampleRate));
+    }
+}
+
+SignalGenerator::Shape SignalGenerator::parseShape(const QString& signalType)
+{
+    const QString type = signalType.trimmed().toLower();
+    if (type == "square") {
+        return Shape::Square;
+    } else if (type == "triangle") {
+        return Shape::Triangle;
+    } else if (type == "sawtooth") {
+        return Shape::Sawtooth;
+    } else if (type == "random") {
+        return Shape::Random;
+    }
+    return Shape::Sine;
+}
+
+void SignalGenerator::reset()
+{
+    m_position = 0;
+}
+
+void SignalGenerator::skip(quint64 scans)
+{
+    m_position += scans;
+}
+
+void SignalGenerator::generate(int scans, double *output)
+{
+    if (scans <= 0) {
+        return;
+    }
+
+    m_cycles.resize(scans);
+    m_scratch.resize(scans);
+    m_channel.resize(scans);
+    double *cycles = m_cycles.data();
+    double *scratch = m_scratch.data();
+    double *channel = m_channel.data();
+
+    for (int c = 0; c < m_channelCount; ++c) {
+        computeCycles(scans, c * CHANNEL_PHASE_STEP, cycles);
+        applyShape(cycles, channel, scans);
+
+        // 谐波：amplitude * sin(2π * order * cycles + phase)
+        for (const Core::VirtualHarmonicConfig& harmonic : m_harmonics) {
+            const double order = harmonic.order;
+            const double offset = harmonic.phase / (2.0 * M_PI);
+            for (int i = 0; i < scans; ++i) {
+                scratch[i] = order * cycles[i] + offset;
+            }
+            sinCycles(scratch, scratch, scans);
+            const double amplitude = harmonic.amplitude;
+            for (int i = 0; i < scans; ++i) {
+                channel[i] += amplitude * scratch[i];
+            }
+        }
+
+        addSteps(scans, channel);
+
+        if (m_noise > 0.0) {
+            addNoise(channel, scans, m_noise);
+        }
+
+        // 按扫描交错写入输出
+        for (int i = 0; i < scans; ++i) {
+            output[i * m_channelCount + c] = channel[i];
+        }
+    }
+
+    m_position += scans;
+}
+
+void SignalGenerator::sinCycles(const double *cycles, double *output, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        // 归约到[-1/2, 1/2)周，再利用sin(π - a) = sin(a)反射到[-1/4, 1/4]
+        double y = cycles[i] - std::floor(cycles[i] + 0.5);
+        y = y > 0.25 ? 0.5 - y : y;
+        y = y < -0.25 ? -0.5 - y : y;
+
+        const double a = 2.0 * M_PI * y;
+        const double a2 = a * a;
+        output[i] = a * (1.0 + a2 * (S1 + a2 * (S2 + a2 * (S3 + a2 * (S4 + a2 * S5)))));
+    }
+}
+
+void SignalGenerator::computeCycles(int scans, double channelOffset, double *cycles) const
+{
+    if (m_chirpPeriodScans == 0) {
+        // 固定频率：块起点相位取小数部分，块内按每样本相位增量递推
+        const double step = m_frequency / m_sampleRate;
+        double base = static_cast<double>(m_position) * step;
+        base = base - std::floor(base) + channelOffset;
+        for (int i = 0; i < scans; ++i) {
+            cycles[i] = base + i * step;
+        }
+        return;
+    }
+
+    // 线性扫频：每个周期内频率从f0线性变到f1，相位为f0*t + (f1-f0)*t²/(2T)。
+    // 每个完整周期累计(f0+f1)*T/2周，加上它的小数部分保证周期边界处相位连续
+    const double f0 = m_frequency;
+    const double f1 = m_chirpEndFrequency;
+    const double periodSec = m_chirpPeriodScans / m_sampleRate;
+    const double sweep = (f1 - f0) / (2.0 * periodSec);
+    double cyclesPerPeriod = (f0 + f1) * periodSec / 2.0;
+    cyclesPerPeriod -= std::floor(cyclesPerPeriod);
+
+    for (int i = 0; i < scans; ++i) {
+        const qint64 scan = static_cast<qint64>(m_position) + i;
+        const qint64 period = scan / m_chirpPeriodScans;
+        const double t = (scan - period * m_chirpPeriodScans) / m_sampleRate;
+        double carried = period * cyclesPerPeriod;
+        carried -= std::floor(carried);
+        cycles[i] = carried + t * (f0 + sweep * t) + channelOffset;
+    }
+}
+
+void SignalGenerator::applyShape(const double *cycles, double *output, int count)
+{
+    const double amplitude = m_amplitude;
+
+    switch (m_shape) {
+    case Shape::Sine:
+        sinCycles(cycles, output, count);
+        for (int i = 0; i < count; ++i) {
+            output[i] *= amplitude;
+        }
+        break;
+    case Shape::Square:
+        for (int i = 0; i < count; ++i) {
+            const double f = cycles[i] - std::floor(cycles[i]);
+            output[i] = f < 0.5 ? amplitude : -amplitude;
+        }
+        break;
+    case Shape::Triangle:
+        // 与正弦同相：0周为0，1/4周为峰值，3/4周为谷值
+        for (int i = 0; i < count; ++i) {
+            const double g = cycles[i] + 0.25 - std::floor(cycles[i] + 0.25);
+            output[i] = amplitude * (1.0 - 4.0 * std::fabs(g - 0.5));
+        }
+        break;
+    case Shape::Sawtooth:
+        for (int i = 0; i < count; ++i) {
+            const double f = cycles[i] - std::floor(cycles[i]);
+            output[i] = amplitude * (2.0 * f - 1.0);
+        }
+        break;
+    case Shape::Random:
+        for (int i = 0; i < count; ++i) {
+            output[i] = amplitude * (2.0 * nextUniform() - 1.0);
+        }
+        break;
+    }
+}
+
+void SignalGenerator::addSteps(int scans, double *output) const
+{
+    if (m_steps.isEmpty()) {
+        return;
+    }
+
+    const double firstTime = static_cast<double>(m_position) / m_sampleRate;
+    const double dt = 1.0 / m_sampleRate;
+
+    for (const Core::VirtualStepConfig& step : m_steps) {
+        const double level = step.level;
+        if (m_stepPeriodSec > 0.0) {
+            // 周期性阶跃：每个周期内从timeSec起叠加level
+            const double period = m_stepPeriodSec;
+            for (int i = 0; i < scans; ++i) {
+                const double t = firstTime + i * dt;
+                const double inPeriod = t - std::floor(t / period) * period;
+                output[i] += inPeriod >= step.timeSec ? level : 0.0;
+            }
+        } else {
+            for (int i = 0; i < scans; ++i) {
+                output[i] += (firstTime + i * dt) >= step.timeSec ? level : 0.0;
+            }
+        }
+    }
+}
+
+void SignalGenerator::addNoise(double *output, int count, double deviation)
+{
+    const double scale = deviation * NOISE_SCALE;
+    for (int i = 0; i < count; ++i) {
+        const double sum = nextUniform() + nextUniform() + nextUniform() + nextUniform();
+        output[i] += scale * (sum - 2.0);
+    }
+}
+
+double SignalGenerator::nextUniform()
+{
+    // xorshift64*：周期2^64-1，取高53位作为[0,1)的双精度数
+    m_randomState ^= m_randomState >> 12;
+    m_randomState ^= m_randomState << 25;
+    m_randomState ^= m_randomState >> 27;
+    const quint64 value = m_randomState * 0x2545F4914F6CDD1DULL;
+    return static_cast<double>(value >> 11) * (1.0 / 9007199254740992.0);
+}
+
+} // namespace Device
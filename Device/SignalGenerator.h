@@ -0,0 +1,101 @@
+#ifndef SIGNALGENERATOR_H
+#define SIGNALGENERATOR_H
+
+#include <QString>
+#include <QVector>
+#include "../Core/DataTypes.h"
+
+namespace Device {
+
+/**
+ * @brief 虚拟设备的块信号发生器
+ * 构造时把配置编译为波形枚举和分量表，生成时不再比较字符串。每块先按样本算出基波相位数组
+ * （单位：周，含扫频），再对整个数组套用波形函数并叠加谐波、阶跃和噪声；
+ * 正弦用多项式近似代替qSin，相位和波形循环没有分支和库函数调用，编译器可以向量化；
+ * 噪声用xorshift随机数的四项和近似高斯分布。
+ */
+class SignalGenerator
+{
+public:
+    /**
+     * @brief 基波波形
+     */
+    enum class Shape {
+        Sine,
+        Square,
+        Triangle,
+        Sawtooth,
+        Random
+    };
+
+    static constexpr double MAX_SAMPLE_RATE = 100000.0; // 每通道最高采样率 (Hz)
+
+    explicit SignalGenerator(const Core::VirtualDeviceConfig& config);
+
+    /**
+     * @brief 解析信号类型（不区分大小写，未知类型为正弦波）
+     */
+    static Shape parseShape(const QString& signalType);
+
+    Shape shape() const { return m_shape; }
+    int channelCount() const { return m_channelCount; }
+    double sampleRate() const { return m_sampleRate; }
+
+    /**
+     * @brief 已生成（或跳过）的扫描数
+     */
+    quint64 position() const { return m_position; }
+
+    /**
+     * @brief 回到第0个扫描
+     */
+    void reset();
+
+    /**
+     * @brief 跳过若干扫描（处理落后时丢弃）
+     */
+    void skip(quint64 scans);
+
+    /**
+     * @brief 生成下一块
+     * @param scans 每通道样本数
+     * @param output 输出，按扫描交错，大小为scans * channelCount()
+     */
+    void generate(int scans, double *output);
+
+    /**
+     * @brief 批量计算sin(2π * cycles[i])
+     * 相位归约到[-1/4, 1/4]周后用11阶多项式计算，最大误差约6e-8
+     */
+    static void sinCycles(const double *cycles, double *output, int count);
+
+private:
+    void computeCycles(int scans, double channelOffset, double *cycles) const;
+    void applyShape(const double *cycles, double *output, int count);
+    void addSteps(int scans, double *output) const;
+    void addNoise(double *output, int count, double deviation);
+    double nextUniform();
+
+    Shape m_shape;
+    double m_amplitude;
+    double m_frequency;
+    double m_sampleRate;
+    int m_channelCount;
+    double m_noise;
+    QList<Core::VirtualHarmonicConfig> m_harmonics;
+    double m_chirpEndFrequency;
+    qint64 m_chirpPeriodScans;            // 扫频周期（扫描数），0表示不扫频
+    QList<Core::VirtualStepConfig> m_steps;
+    double m_stepPeriodSec;
+
+    quint64 m_position;                   // 下一个扫描的序号
+    quint64 m_randomState;                // xorshift64*状态
+
+    QVector<double> m_cycles;             // 当前通道的基波相位（周）
+    QVector<double> m_scratch;            // 谐波相位等临时数组
+    QVector<double> m_channel;            // 当前通道的样本
+};
+
+} // namespace Device
+
+#endif // SIGNALGENERATOR_H
@@ -1,4 +1,6 @@
 #include "VirtualDevice.h"
+#include "../Core/Log.h"
+#include "../Core/Metrics.h"
 #include <QThread>
 
 namespace Device {
@@ -6,25 +8,31 @@ namespace Device {
 VirtualDevice::VirtualDevice(const Core::VirtualDeviceConfig& config, QObject *parent)
     : AbstractDevice(parent)
     , m_config(config)
+    , m_generator(config)
     , m_timer(nullptr)
-    , m_startTime(QDateTime::currentMSecsSinceEpoch())
-    , m_phase(0.0)
+    , m_startTime(Core::Timebase::nowNs())
 {
+    for (int c = 0; c < m_generator.channelCount(); ++c) {
+        m_hardwareChannels.append(QString::number(c));
+    }
+
     // 创建定时器（延迟到线程启动后）
     m_timer = new QTimer();
     m_timer->setParent(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
 
-    // 连接定时器信号到生成数据点的槽
-    connect(m_timer, &QTimer::timeout, this, &VirtualDevice::generateDataPoint);
+    // 连接定时器信号到生成数据块的槽
+    connect(m_timer, &QTimer::timeout, this, &VirtualDevice::generateBlock);
 
-    // 设置定时器间隔（默认为10ms，即100Hz）
-    int interval = 10; // 毫秒
-    m_timer->setInterval(interval);
+    // 设置块间隔（默认为10ms），每块包含间隔内到期的全部扫描
+    m_timer->setInterval(qMax(1, m_config.blockIntervalMs));
 
     qDebug() << "创建虚拟设备:" << m_config.instanceName
              << "信号类型:" << m_config.signalType
              << "振幅:" << m_config.amplitude
-             << "频率:" << m_config.frequency;
+             << "频率:" << m_config.frequency
+             << "采样率:" << m_generator.sampleRate()
+             << "通道数:" << m_generator.channelCount();
 }
 
 VirtualDevice::~VirtualDevice()
@@ -70,9 +78,9 @@ void VirtualDevice::startAcquisition()
         return;
     }
 
-    // 重置开始时间和相位
-    m_startTime = QDateTime::currentMSecsSinceEpoch();
-    m_phase = 0.0;
+    // 重置开始时间和发生器位置
+    m_startTime = Core::Timebase::nowNs();
+    m_generator.reset();
 
     // 确保定时器在当前线程中启动
     QMetaObject::invokeMethod(m_timer, "start", Qt::QueuedConnection);
@@ -105,60 +113,38 @@ Core::DeviceType VirtualDevice::getDeviceType() const
     return Core::DeviceType::VIRTUAL;
 }
 
-void VirtualDevice::generateDataPoint()
+void VirtualDevice::generateBlock()
 {
-    // 获取当前时间戳
-    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
-
-    // 根据信号类型生成数据
-    double rawValue = 0.0;
-
-    if (m_config.signalType.toLower() == "sine") {
-        rawValue = generateSineWave();
-    } else if (m_config.signalType.toLower() == "square") {
-        rawValue = generateSquareWave();
-    } else if (m_config.signalType.toLower() == "triangle") {
-        rawValue = generateTriangleWave();
-    } else if (m_config.signalType.toLower() == "random") {
-        rawValue = generateRandomValue();
-    } else {
-        // 默认使用正弦波
-        rawValue = generateSineWave();
-    }
-
-    // 应用滤波器
-    double filteredValue = applyFilter(rawValue);
+    Core::Metrics::ScopedTimer readTimer(Core::Metrics::DeviceRead);
 
-    // 发送原始数据点就绪信号
-    emit rawDataPointReady(getDeviceId(), "0", filteredValue, timestamp);
-
-    // 更新相位
-    double deltaTime = (timestamp - m_startTime) / 1000.0; // 转换为秒
-    m_phase = fmod(2.0 * M_PI * m_config.frequency * deltaTime, 2.0 * M_PI);
-}
+    // 按绝对时间计算到期的扫描数，定时器抖动不会累积成采样率误差
+    const double sampleRate = m_generator.sampleRate();
+    const qint64 now = Core::Timebase::nowNs();
+    const quint64 due = static_cast<quint64>(Core::Timebase::secondsBetween(m_startTime, now) * sampleRate);
+    if (due <= m_generator.position()) {
+        return;
+    }
 
-double VirtualDevice::generateSineWave()
-{
-    // 生成正弦波：amplitude * sin(phase)
-    return m_config.amplitude * qSin(m_phase);
-}
+    quint64 scans = due - m_generator.position();
 
-double VirtualDevice::generateSquareWave()
-{
-    // 生成方波：amplitude * sign(sin(phase))
-    return m_config.amplitude * (qSin(m_phase) >= 0 ? 1.0 : -1.0);
-}
+    // 落后超过1秒（线程被长时间阻塞）时丢弃多余的扫描，避免一次生成过大的块
+    const quint64 maxScans = static_cast<quint64>(qMax(1.0, sampleRate));
+    if (scans > maxScans) {
+        DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcDevice, "[VirtualDevice] %s 落后 %llu 个扫描，丢弃至1秒",
+                         qPrintable(m_config.instanceName), static_cast<unsigned long long>(scans));
+        m_generator.skip(scans - maxScans);
+        scans = maxScans;
+    }
 
-double VirtualDevice::generateTriangleWave()
-{
-    // 生成三角波：amplitude * (2/pi) * asin(sin(phase))
-    return m_config.amplitude * (2.0 / M_PI) * qAsin(qSin(m_phase));
-}
+    Core::RawSampleBlock block;
+    block.hardwareChannels = m_hardwareChannels;
+    block.intervalNs = 1e9 / sampleRate;
+    block.firstTimestamp = m_startTime + static_cast<qint64>(m_generator.position() * block.intervalNs);
+    block.values.resize(static_cast<int>(scans) * m_generator.channelCount());
+    m_generator.generate(static_cast<int>(scans), block.values.data());
 
-double VirtualDevice::generateRandomValue()
-{
-    // 生成随机值：amplitude * random(-1, 1)
-    return m_config.amplitude * (QRandomGenerator::global()->generateDouble() * 2.0 - 1.0);
+    emit rawDataBlockReady(getDeviceId(), block);
+    Core::Metrics::increment(Core::Metrics::RawSamples, block.values.size());
 }
 
 } // namespace Device
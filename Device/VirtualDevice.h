@@ -2,16 +2,15 @@
 #define VIRTUALDEVICE_H
 
 #include "AbstractDevice.h"
+#include "SignalGenerator.h"
 #include <QTimer>
-#include <QDateTime>
-#include <QRandomGenerator>
-#include <QtMath>
+#include <QStringList>
 
 namespace Device {
 
 /**
  * @brief 虚拟设备类
- * 用于测试和仿真的虚拟设备
+ * 用于测试和仿真的虚拟设备，按采样率成块生成多通道数据并通过rawDataBlockReady发送
  */
 class VirtualDevice : public AbstractDevice
 {
@@ -66,41 +65,17 @@ public:
 
 private slots:
     /**
-     * @brief 生成数据点
-     * 定时器触发时生成一个新的数据点
+     * @brief 生成数据块
+     * 定时器触发时按开始采集以来的绝对时间补齐到期的扫描，整块发送
      */
-    void generateDataPoint();
-
-private:
-    /**
-     * @brief 生成正弦波数据
-     * @return 正弦波数据值
-     */
-    double generateSineWave();
-    
-    /**
-     * @brief 生成方波数据
-     * @return 方波数据值
-     */
-    double generateSquareWave();
-    
-    /**
-     * @brief 生成三角波数据
-     * @return 三角波数据值
-     */
-    double generateTriangleWave();
-    
-    /**
-     * @brief 生成随机数据
-     * @return 随机数据值
-     */
-    double generateRandomValue();
+    void generateBlock();
 
 private:
     Core::VirtualDeviceConfig m_config;  // 设备配置
+    SignalGenerator m_generator;         // 块信号发生器
+    QStringList m_hardwareChannels;      // 硬件通道标识（"0".."N-1"）
     QTimer* m_timer;                     // 定时器
-    qint64 m_startTime;                  // 开始时间
-    double m_phase;                      // 相位（用于波形生成）
+    qint64 m_startTime;                  // 开始时间（纳秒）
 };
 
 } // namespace Device
@@ -1,4 +1,5 @@
 #include "Channel.h"
+#include "../Core/Log.h"
 #include <QThread>
 
 namespace Processing {
@@ -58,7 +59,7 @@ Core::ProcessedDataPoint Channel::processRawData(double rawValue, qint64 timesta
     m_latestDataPoint = dataPoint;
 
     // 记录处理信息
-    qDebug() << "通道处理数据:" << m_config.channelId
+    DAQ_TRACE(lcProcessing) << "通道处理数据:" << m_config.channelId
              << "原始值:" << rawValue
              << "处理后值:" << calibratedValue
              << "线程ID:" << QThread::currentThreadId();
@@ -1,20 +1,25 @@
 #include "DataProcessor.h"
+#include "../Core/Log.h"
+#include "../Core/Metrics.h"
+#include "../Core/LatencyTrace.h"
 #include <QDateTime>
 
 namespace Processing {
 
 DataProcessor::DataProcessor(int syncIntervalMs, QObject *parent)
     : QObject(parent)
-    , m_processingTimer(new QTimer(this))
+    , m_syncClock(new SyncClock(syncIntervalMs, this))
     , m_syncIntervalMs(syncIntervalMs)
+    , m_frameSequence(0)
+    , m_gridStarted(false)
+    , m_nextGridNs(0)
+    , m_skippedGridPoints(0)
+    , m_lastAlignmentReportNs(0)
     , m_isProcessing(false)
     , m_dataStorage(new DataStorage(this))
 {
-    // 连接处理定时器信号
-    connect(m_processingTimer, &QTimer::timeout, this, &DataProcessor::performProcessing);
-
-    // 设置处理定时器间隔
-    m_processingTimer->setInterval(m_syncIntervalMs);
+    // 连接同步时钟节拍
+    connect(m_syncClock, &SyncClock::tick, this, &DataProcessor::performProcessing);
 
     // 连接数据存储器信号
     connect(m_dataStorage, &DataStorage::storageStatusChanged,
@@ -72,12 +77,19 @@ bool DataProcessor::createChannel(const Core::ChannelConfig& config)
 
     // 添加到通道映射
     m_channels[config.channelId] = channel;
+    Core::Metrics::setGauge(Core::Metrics::Channels, m_channels.size());
 
     // 为通道创建数据队列
     ProcessedDataQueue queue;
     queue.maxSize = MAX_QUEUE_SIZE;
     m_processedDataQueues[config.channelId] = queue;
 
+    // 为通道的数据源创建对齐历史
+    QPair<QString, QString> sourceKey(config.deviceId, config.hardwareChannel);
+    if (!m_alignerSources.contains(sourceKey)) {
+        m_alignerSources[sourceKey] = m_timeAligner.addSource();
+    }
+
     qDebug() << "创建通道成功:" << config.channelId << "，线程ID:" << QThread::currentThreadId();
     return true;
 }
@@ -169,18 +181,40 @@ void DataProcessor::setSyncIntervalMs(int intervalMs)
 {
     if (intervalMs > 0 && intervalMs != m_syncIntervalMs) {
         m_syncIntervalMs = intervalMs;
-        m_processingTimer->setInterval(m_syncIntervalMs);
+        m_syncClock->setIntervalMs(m_syncIntervalMs);
         qDebug() << "设置同步间隔为:" << m_syncIntervalMs << "毫秒";
     }
 }
 
+void DataProcessor::setAlignmentConfig(const Core::AlignmentConfig& config)
+{
+    QMutexLocker locker(&m_mutex);
+
+    m_alignmentConfig = config;
+    m_timeAligner.setConfig(config);
+    m_gridStarted = false;
+
+    qDebug() << "设置时间对齐:" << (config.enabled ? "启用" : "关闭")
+             << "插值方式:" << config.method
+             << "输出间隔:" << alignmentIntervalNs() / Core::Timebase::NS_PER_MS << "毫秒"
+             << "延迟预算:" << config.latencyMs << "毫秒";
+}
+
+Core::AlignmentConfig DataProcessor::getAlignmentConfig() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_alignmentConfig;
+}
+
 void DataProcessor::startProcessing()
 {
     QMutexLocker locker(&m_mutex);
 
     if (!m_isProcessing) {
-        // 启动处理定时器
-        m_processingTimer->start();
+        // 启动同步时钟，输出网格从第一个节拍重新确定起点
+        m_gridStarted = false;
+        m_lastAlignmentReportNs = Core::Timebase::nowNs();
+        m_syncClock->start();
         m_isProcessing = true;
         qDebug() << "开始数据处理，线程ID:" << QThread::currentThreadId();
     }
@@ -191,8 +225,8 @@ void DataProcessor::stopProcessing()
     QMutexLocker locker(&m_mutex);
 
     if (m_isProcessing) {
-        // 停止处理定时器
-        m_processingTimer->stop();
+        // 停止同步时钟
+        m_syncClock->stop();
         m_isProcessing = false;
         qDebug() << "停止数据处理，线程ID:" << QThread::currentThreadId();
     }
@@ -210,6 +244,17 @@ Core::SynchronizedDataFrame DataProcessor::getLatestSyncFrame() const
     return m_latestSyncFrame;
 }
 
+bool DataProcessor::readLatestFrame(Core::SynchronizedDataFrame& frame)
+{
+    if (!m_publishedFrame.fetch()) {
+        return false;
+    }
+
+    // 隐式共享，仅增加引用计数
+    frame = m_publishedFrame.readBuffer();
+    return true;
+}
+
 bool DataProcessor::getChannelData(const QString& channelId, QVector<double>& timestamps, QVector<double>& values, int maxPoints) const
 {
     QReadLocker locker(&m_dataLock);
@@ -245,7 +290,7 @@ bool DataProcessor::getChannelData(const QString& channelId, QVector<double>& ti
 
     // 复制数据
     for (int i = 0; i < pointCount; ++i) {
-        // 保持原始时间戳（毫秒）
+        // 保持原始时间戳（纳秒）
         timestamps.append(static_cast<double>(queue.timestamps[startIndex + i]));
         values.append(queue.values[startIndex + i]);
     }
@@ -253,6 +298,36 @@ bool DataProcessor::getChannelData(const QString& channelId, QVector<double>& ti
     return true;
 }
 
+bool DataProcessor::getChannelDataSince(const QString& channelId, qint64 afterTimestamp, QVector<qint64>& timestamps, QVector<double>& values) const
+{
+    QReadLocker locker(&m_dataLock);
+
+    timestamps.clear();
+    values.clear();
+
+    auto queueIt = m_processedDataQueues.constFind(channelId);
+    if (queueIt == m_processedDataQueues.constEnd()) {
+        return false;
+    }
+
+    // 新数据都在队尾，从后向前找到第一个新点
+    const ProcessedDataQueue& queue = queueIt.value();
+    int startIndex = queue.timestamps.size();
+    while (startIndex > 0 && queue.timestamps[startIndex - 1] > afterTimestamp) {
+        --startIndex;
+    }
+
+    const int pointCount = queue.timestamps.size() - startIndex;
+    timestamps.reserve(pointCount);
+    values.reserve(pointCount);
+    for (int i = startIndex; i < queue.timestamps.size(); ++i) {
+        timestamps.append(queue.timestamps[i]);
+        values.append(queue.values[i]);
+    }
+
+    return true;
+}
+
 QMap<QString, QPair<double, double>> DataProcessor::getLatestDataPoints() const
 {
     QReadLocker locker(&m_dataLock);
@@ -266,10 +341,10 @@ QMap<QString, QPair<double, double>> DataProcessor::getLatestDataPoints() const
 
         if (!queue.timestamps.isEmpty() && !queue.values.isEmpty()) {
             // 获取最新的时间戳和值
-            qint64 timestamp = queue.timestamps.last(); // 保持原始时间戳（毫秒）
+            qint64 timestamp = queue.timestamps.last(); // 保持原始时间戳（纳秒）
             double value = queue.values.last();
 
-            // 返回原始时间戳（毫秒）和值
+            // 返回原始时间戳（纳秒）和值
             result[channelId] = qMakePair(static_cast<double>(timestamp), value);
         }
     }
@@ -284,6 +359,9 @@ void DataProcessor::clearAllBuffers()
 
     // 清除原始数据缓存
     m_rawDataCache.clear();
+    m_ingestTraceCounters.clear();
+    m_timeAligner.clear();
+    m_gridStarted = false;
 
     // 清除处理后数据队列
     for (auto it = m_processedDataQueues.begin(); it != m_processedDataQueues.end(); ++it) {
@@ -365,8 +443,18 @@ void DataProcessor::setStorageDirectory(const QString& dirPath)
 
 void DataProcessor::onRawDataPointReceived(QString deviceId, QString hardwareChannel, double rawValue, qint64 timestamp)
 {
+    // 样本从设备时间戳（采集时刻）到进入处理器的延迟（含跨线程排队）
+    const qint64 receivedNs = Core::Timebase::nowNs();
+    Core::Metrics::recordLatency(Core::Metrics::Ingest, receivedNs - timestamp);
+    Core::Metrics::increment(Core::Metrics::IngestedSamples);
+
     QMutexLocker locker(&m_mutex);
 
+    // 逐样本的延迟已计入Metrics分片；LatencyTrace使用全局锁并保存跟踪事件，每设备按间隔抽样记录
+    if (m_ingestTraceCounters[deviceId]++ % INGEST_TRACE_SAMPLE_EVERY == 0) {
+        Core::LatencyTrace::record(Core::LatencyTrace::AcquisitionToIngest, deviceId, timestamp, receivedNs);
+    }
+
     // 更新原始数据缓存
     QPair<QString, QString> key(deviceId, hardwareChannel);
     RawDataPoint dataPoint;
@@ -374,11 +462,69 @@ void DataProcessor::onRawDataPointReceived(QString deviceId, QString hardwareCha
     dataPoint.timestamp = timestamp;
     m_rawDataCache[key] = dataPoint;
 
-    qDebug() << "接收原始数据点 - 设备:" << deviceId << "通道:" << hardwareChannel
+    // 写入对齐历史
+    auto sourceIt = m_alignerSources.constFind(key);
+    if (sourceIt != m_alignerSources.constEnd()) {
+        m_timeAligner.push(sourceIt.value(), timestamp, rawValue);
+    }
+
+    DAQ_TRACE(lcProcessing) << "接收原始数据点 - 设备:" << deviceId << "通道:" << hardwareChannel
              << "值:" << rawValue << "时间戳:" << timestamp
              << "线程ID:" << QThread::currentThreadId();
 }
 
+void DataProcessor::onRawDataBlockReceived(QString deviceId, Core::RawSampleBlock block)
+{
+    const int channelCount = block.channelCount();
+    const int scanCount = block.scanCount();
+    if (channelCount == 0 || scanCount == 0) {
+        return;
+    }
+
+    // 块内最后一次扫描最接近当前时刻，用它记录进入处理器的延迟
+    const qint64 lastTimestamp = block.timestampAt(scanCount - 1);
+    const qint64 receivedNs = Core::Timebase::nowNs();
+    Core::Metrics::recordLatency(Core::Metrics::Ingest, receivedNs - lastTimestamp);
+    Core::Metrics::increment(Core::Metrics::IngestedSamples, block.values.size());
+    Core::LatencyTrace::record(Core::LatencyTrace::AcquisitionToIngest, deviceId, lastTimestamp, receivedNs);
+
+    const double *values = block.values.constData();
+
+    QMutexLocker locker(&m_mutex);
+
+    const int stride = alignerStride(block.intervalNs);
+
+    for (int c = 0; c < channelCount; ++c) {
+        QPair<QString, QString> key(deviceId, block.hardwareChannels.at(c));
+
+        // 写入对齐历史
+        auto sourceIt = m_alignerSources.constFind(key);
+        if (sourceIt != m_alignerSources.constEnd()) {
+            const int source = sourceIt.value();
+            for (int i = 0; i < scanCount; i += stride) {
+                // 每stride次扫描取均值，时间戳取窗口中点
+                const int n = qMin(stride, scanCount - i);
+                double sum = 0.0;
+                for (int k = 0; k < n; ++k) {
+                    sum += values[(i + k) * channelCount + c];
+                }
+                const qint64 centerNs = block.timestampAt(i) + (n - 1) * block.intervalNs / 2;
+                m_timeAligner.push(source, centerNs, sum / n);
+            }
+        }
+
+        // 更新原始数据缓存（只保留最后一个样本）
+        RawDataPoint dataPoint;
+        dataPoint.value = values[(scanCount - 1) * channelCount + c];
+        dataPoint.timestamp = lastTimestamp;
+        m_rawDataCache[key] = dataPoint;
+    }
+
+    DAQ_TRACE(lcProcessing) << "接收原始样本块 - 设备:" << deviceId << "通道数:" << channelCount
+             << "扫描数:" << scanCount << "首个时间戳:" << block.firstTimestamp
+             << "线程ID:" << QThread::currentThreadId();
+}
+
 void DataProcessor::onDeviceStatusChanged(QString deviceId, Core::StatusCode status, QString message)
 {
     QMutexLocker locker(&m_mutex);
@@ -396,20 +542,88 @@ void DataProcessor::onDeviceStatusChanged(QString deviceId, Core::StatusCode sta
              << "线程ID:" << QThread::currentThreadId();
 }
 
-void DataProcessor::performProcessing()
+void DataProcessor::performProcessing(qint64 deadlineNs, qint64 latenessNs)
 {
     QMutexLocker locker(&m_mutex);
 
-    // 处理数据并创建同步数据帧
-    Core::SynchronizedDataFrame frame = processData();
+    Core::Metrics::setGauge(Core::Metrics::SyncLatenessUs, latenessNs / 1000);
+    if (latenessNs > m_syncClock->intervalNs()) {
+        DAQ_LOG_EVERY_MS(1000, QtWarningMsg, lcProcessing, "同步节拍迟到 %lld 微秒",
+                         static_cast<long long>(latenessNs / 1000));
+    }
+
+    if (m_alignmentConfig.enabled) {
+        processAlignedFrames(deadlineNs);
+        return;
+    }
+
+    // 处理数据并创建同步数据帧，帧时间戳取节拍截止时刻，保证帧严格等间隔
+    Core::SynchronizedDataFrame frame = processData(deadlineNs, false);
+    publishFrame(frame);
+}
+
+void DataProcessor::processAlignedFrames(qint64 deadlineNs)
+{
+    const qint64 intervalNs = alignmentIntervalNs();
+
+    // 只输出早于延迟预算的网格点，慢速设备的数据在此之前到达即可参与插值
+    const qint64 readyNs = deadlineNs - static_cast<qint64>(m_alignmentConfig.latencyMs) * Core::Timebase::NS_PER_MS;
+    if (readyNs < 0) {
+        return;
+    }
+
+    if (!m_gridStarted) {
+        // 网格点取间隔的整数倍，不同次采集的帧时间戳可直接比较
+        m_nextGridNs = readyNs - readyNs % intervalNs;
+        m_gridStarted = true;
+    }
+
+    // 处理器线程被阻塞过久时跳过最旧的网格点，避免一次补发过多帧
+    const qint64 pending = readyNs >= m_nextGridNs ? (readyNs - m_nextGridNs) / intervalNs + 1 : 0;
+    if (pending > MAX_ALIGNED_FRAMES_PER_TICK) {
+        const qint64 skipped = pending - MAX_ALIGNED_FRAMES_PER_TICK;
+        m_nextGridNs += skipped * intervalNs;
+        m_skippedGridPoints += static_cast<quint64>(skipped);
+    }
+
+    while (m_nextGridNs <= readyNs) {
+        Core::SynchronizedDataFrame frame = processData(m_nextGridNs, true);
+        publishFrame(frame);
+        m_nextGridNs += intervalNs;
+    }
+
+    // 早于下一个网格点的历史不再需要（保留其左侧一个样本用于插值）
+    m_timeAligner.discardBefore(m_nextGridNs);
+
+    if (deadlineNs - m_lastAlignmentReportNs >= ALIGNMENT_REPORT_INTERVAL_MS * Core::Timebase::NS_PER_MS) {
+        TimeAligner::Statistics statistics = m_timeAligner.takeStatistics();
+        qDebug() << "时间对齐统计 - 样本数:" << statistics.pushed
+                 << "乱序丢弃:" << statistics.outOfOrder
+                 << "历史溢出:" << statistics.overwritten
+                 << "跳过网格点:" << m_skippedGridPoints;
+        m_skippedGridPoints = 0;
+        m_lastAlignmentReportNs = deadlineNs;
+    }
+}
+
+void DataProcessor::publishFrame(Core::SynchronizedDataFrame& frame)
+{
+    frame.sequence = ++m_frameSequence;
+    frame.builtTimestamp = Core::Timebase::nowNs();
+    Core::Metrics::increment(Core::Metrics::Frames);
+    Core::LatencyTrace::recordFrame(Core::LatencyTrace::AcquisitionToFrame, frame, frame.builtTimestamp);
 
     // 更新最新的同步数据帧
     m_latestSyncFrame = frame;
 
+    // 发布给UI线程
+    m_publishedFrame.writeBuffer() = frame;
+    m_publishedFrame.publish();
+
     // 发送同步数据帧就绪信号
     emit syncFrameReady(frame);
 
-    qDebug() << "执行数据处理 - 时间戳:" << frame.timestamp
+    DAQ_TRACE(lcProcessing) << "执行数据处理 - 时间戳:" << frame.timestamp
              << "通道数:" << frame.channelData.size()
              << "线程ID:" << QThread::currentThreadId();
 }
@@ -448,10 +662,30 @@ Channel* DataProcessor::findChannel(const QString& deviceId, const QString& hard
     return nullptr;
 }
 
-Core::SynchronizedDataFrame DataProcessor::processData()
+qint64 DataProcessor::alignmentIntervalNs() const
+{
+    int intervalMs = m_alignmentConfig.outputIntervalMs > 0 ? m_alignmentConfig.outputIntervalMs : m_syncIntervalMs;
+    return static_cast<qint64>(qMax(1, intervalMs)) * Core::Timebase::NS_PER_MS;
+}
+
+int DataProcessor::alignerStride(qint64 sampleIntervalNs) const
+{
+    if (sampleIntervalNs <= 0 || m_alignmentConfig.historySize <= 0) {
+        return 1;
+    }
+
+    // 对齐历史至少要覆盖延迟预算加一个输出间隔，留一倍余量；
+    // 高速块（如100kHz）逐点写入会在网格点就绪前覆盖掉所需的样本
+    const qint64 windowNs = 2 * (static_cast<qint64>(m_alignmentConfig.latencyMs) * Core::Timebase::NS_PER_MS
+                                 + alignmentIntervalNs());
+    const qint64 minSpacingNs = windowNs / m_alignmentConfig.historySize;
+    return static_cast<int>(qMax<qint64>(1, (minSpacingNs + sampleIntervalNs - 1) / sampleIntervalNs));
+}
+
+Core::SynchronizedDataFrame DataProcessor::processData(qint64 frameTimestamp, bool aligned)
 {
-    // 创建同步数据帧，使用当前时间戳
-    Core::SynchronizedDataFrame frame(QDateTime::currentMSecsSinceEpoch());
+    Core::SynchronizedDataFrame frame(frameTimestamp);
+    const qint64 buildStartNs = Core::Timebase::nowNs();
 
     // 处理每个通道的数据
     for (auto it = m_channels.constBegin(); it != m_channels.constEnd(); ++it) {
@@ -462,18 +696,43 @@ Core::SynchronizedDataFrame DataProcessor::processData()
 
         // 查找该通道对应的原始数据
         QPair<QString, QString> key(deviceId, hardwareChannel);
-        auto dataIt = m_rawDataCache.find(key);
-
-        if (dataIt != m_rawDataCache.end()) {
-            // 处理原始数据
-            double rawValue = dataIt.value().value;
-            qint64 timestamp = dataIt.value().timestamp;
+        double rawValue = 0.0;
+        qint64 timestamp = 0;
+        qint64 acquisitionTimestamp = 0;
+        bool stale = false;
+        bool hasData = false;
+
+        if (aligned) {
+            // 取该网格时刻的插值
+            TimeAligner::Sample sample;
+            int source = m_alignerSources.value(key, -1);
+            if (source >= 0 && m_timeAligner.sample(source, frameTimestamp, sample)) {
+                rawValue = sample.value;
+                timestamp = frameTimestamp;
+                acquisitionTimestamp = sample.sourceTimestamp;
+                stale = sample.stale;
+                hasData = true;
+            }
+        } else {
+            auto dataIt = m_rawDataCache.constFind(key);
+            if (dataIt != m_rawDataCache.constEnd()) {
+                rawValue = dataIt.value().value;
+                timestamp = dataIt.value().timestamp;
+                acquisitionTimestamp = timestamp;
+                hasData = true;
+            }
+        }
 
+        if (hasData) {
             // 应用通道处理（增益、偏移和校准）
             Core::ProcessedDataPoint processedPoint = channel->processRawData(rawValue, timestamp);
+            if (stale) {
+                processedPoint.status = Core::StatusCode::STALE;
+            }
 
-            // 添加到同步数据帧
+            // 添加到同步数据帧，并记录该设备数据的采集时刻用于端到端延迟统计
             frame.addChannelData(channelId, processedPoint);
+            frame.noteAcquisition(deviceId, acquisitionTimestamp);
 
             // 添加到数据队列
             {
@@ -499,7 +758,7 @@ Core::SynchronizedDataFrame DataProcessor::processData()
                 }
             }
 
-            qDebug() << "处理通道数据 - 通道:" << channelId
+            DAQ_TRACE(lcProcessing) << "处理通道数据 - 通道:" << channelId
                      << "原始值:" << rawValue
                      << "处理后值:" << processedPoint.value
                      << "线程ID:" << QThread::currentThreadId();
@@ -509,8 +768,12 @@ Core::SynchronizedDataFrame DataProcessor::processData()
         }
     }
 
+    Core::Metrics::recordLatency(Core::Metrics::FrameBuild, Core::Timebase::nowNs() - buildStartNs);
+
     // 处理二次计算仪器数据
     if (!m_secondaryInstruments.isEmpty()) {
+        Core::Metrics::ScopedTimer secondaryTimer(Core::Metrics::SecondaryEval);
+
         // 创建通道值映射，用于二次计算
         QMap<QString, double> channelValues;
 
@@ -554,7 +817,7 @@ Core::SynchronizedDataFrame DataProcessor::processData()
                 }
             }
 
-            qDebug() << "处理二次计算仪器数据 - 通道:" << channelId
+            DAQ_TRACE(lcProcessing) << "处理二次计算仪器数据 - 通道:" << channelId
                      << "计算值:" << processedPoint.value
                      << "线程ID:" << QThread::currentThreadId();
 
@@ -3,8 +3,8 @@
 
 #include <QObject>
 #include <QMap>
+#include <QHash>
 #include <QMutex>
-#include <QTimer>
 #include <QDebug>
 #include <QThread>
 #include <QQueue>
@@ -12,9 +12,12 @@
 #include <QReadWriteLock>
 #include "../Core/Constants.h"
 #include "../Core/DataTypes.h"
+#include "../Core/TripleBuffer.h"
 #include "Channel.h"
 #include "DataStorage.h"
 #include "SecondaryInstrument.h"
+#include "TimeAligner.h"
+#include "SyncClock.h"
 
 namespace Processing {
 
@@ -98,6 +101,19 @@ public:
      */
     void setSyncIntervalMs(int intervalMs);
 
+    /**
+     * @brief 设置时间对齐配置
+     * 启用时按固定输出网格对各通道历史数据插值生成同步帧，关闭时每个节拍取各通道最新值
+     * @param config 时间对齐配置
+     */
+    void setAlignmentConfig(const Core::AlignmentConfig& config);
+
+    /**
+     * @brief 获取时间对齐配置
+     * @return 时间对齐配置
+     */
+    Core::AlignmentConfig getAlignmentConfig() const;
+
     /**
      * @brief 开始处理
      */
@@ -120,16 +136,35 @@ public:
      */
     Core::SynchronizedDataFrame getLatestSyncFrame() const;
 
+    /**
+     * @brief 读取最新发布的同步数据帧（无锁，供UI线程直接调用）
+     * 不经过处理器线程的事件循环；只允许一个读线程调用
+     * @param frame 同步数据帧（输出，仅在有新帧时更新）
+     * @return 自上次读取以来是否有新帧
+     */
+    bool readLatestFrame(Core::SynchronizedDataFrame& frame);
+
     /**
      * @brief 获取通道的处理后数据
      * @param channelId 通道ID
-     * @param timestamps 时间戳向量（输出）
+     * @param timestamps 时间戳向量（输出，Core::Timebase纳秒）
      * @param values 值向量（输出）
      * @param maxPoints 最大点数
      * @return 是否成功获取数据
      */
     bool getChannelData(const QString& channelId, QVector<double>& timestamps, QVector<double>& values, int maxPoints = -1) const;
 
+    /**
+     * @brief 获取通道在指定时刻之后的处理后数据（按时间升序）
+     * 供UI在每次刷新时取走上次刷新以来的全部数据点，最多为队列长度
+     * @param channelId 通道ID
+     * @param afterTimestamp 只返回晚于该时刻的点（Core::Timebase纳秒）
+     * @param timestamps 时间戳向量（输出，Core::Timebase纳秒）
+     * @param values 值向量（输出）
+     * @return 通道是否有数据队列
+     */
+    bool getChannelDataSince(const QString& channelId, qint64 afterTimestamp, QVector<qint64>& timestamps, QVector<double>& values) const;
+
     /**
      * @brief 获取所有通道的最新数据点
      * @return 通道ID到最新数据点的映射
@@ -143,7 +178,7 @@ public:
 
     /**
      * @brief 开始数据存储
-     * @param startTimestamp 采集开始的时间戳（毫秒）
+     * @param startTimestamp 采集开始的时间戳（Core::Timebase纳秒）
      * @return 是否成功开始存储
      */
     bool startDataStorage(qint64 startTimestamp);
@@ -181,6 +216,14 @@ public slots:
      */
     void onRawDataPointReceived(QString deviceId, QString hardwareChannel, double rawValue, qint64 timestamp);
 
+    /**
+     * @brief 处理原始样本块
+     * 每个通道只查找一次缓存键和对齐源，整块写入对齐历史，缓存保留每个通道的最后一个样本
+     * @param deviceId 设备ID
+     * @param block 样本块
+     */
+    void onRawDataBlockReceived(QString deviceId, Core::RawSampleBlock block);
+
     /**
      * @brief 处理设备状态变化
      * @param deviceId 设备ID
@@ -233,9 +276,11 @@ signals:
 private slots:
     /**
      * @brief 执行同步和处理
-     * 定时器触发时同步和处理数据
+     * 同步时钟每个节拍触发一次
+     * @param deadlineNs 节拍截止时刻（Timebase纳秒，严格等间隔）
+     * @param latenessNs 节拍迟到（纳秒）
      */
-    void performProcessing();
+    void performProcessing(qint64 deadlineNs, qint64 latenessNs);
 
     /**
      * @brief 处理通道状态变化
@@ -265,9 +310,35 @@ private:
     /**
      * @brief 处理原始数据
      * 对原始数据进行处理并生成同步数据帧
+     * @param frameTimestamp 帧时间戳（Timebase纳秒）
+     * @param aligned 是否从时间对齐器取该时刻的插值（否则取各通道最新值）
      * @return 同步数据帧
      */
-    Core::SynchronizedDataFrame processData();
+    Core::SynchronizedDataFrame processData(qint64 frameTimestamp, bool aligned);
+
+    /**
+     * @brief 生成所有已到期的对齐网格点对应的同步帧
+     * @param deadlineNs 当前节拍截止时刻（Timebase纳秒）
+     */
+    void processAlignedFrames(qint64 deadlineNs);
+
+    /**
+     * @brief 编号并发布同步数据帧
+     * @param frame 同步数据帧
+     */
+    void publishFrame(Core::SynchronizedDataFrame& frame);
+
+    /**
+     * @brief 输出网格间隔（纳秒）
+     */
+    qint64 alignmentIntervalNs() const;
+
+    /**
+     * @brief 样本块写入对齐历史时的聚合步长（扫描数）
+     * 保证历史长度覆盖延迟预算和输出间隔，步长为1时逐点写入
+     * @param sampleIntervalNs 块内扫描间隔（纳秒）
+     */
+    int alignerStride(qint64 sampleIntervalNs) const;
 
 private:
     // 通道管理
@@ -280,6 +351,16 @@ private:
         qint64 timestamp;
     };
     QMap<QPair<QString, QString>, RawDataPoint> m_rawDataCache; // 原始数据缓存 (设备ID,硬件通道) -> 原始数据点
+    QHash<QString, quint32> m_ingestTraceCounters;       // 设备ID -> 逐点样本计数（用于采样记录进入处理器的延迟）
+
+    // 时间对齐
+    Core::AlignmentConfig m_alignmentConfig;             // 时间对齐配置
+    TimeAligner m_timeAligner;                           // 时间对齐重采样器
+    QMap<QPair<QString, QString>, int> m_alignerSources; // (设备ID,硬件通道) -> 对齐器数据源索引
+    bool m_gridStarted;                                  // 输出网格是否已确定起点
+    qint64 m_nextGridNs;                                 // 下一个待输出的网格时刻（Timebase纳秒）
+    quint64 m_skippedGridPoints;                         // 统计周期内因处理落后而跳过的网格点数
+    qint64 m_lastAlignmentReportNs;                      // 上次输出对齐统计的时间（Timebase纳秒）
 
     // 处理后数据缓存
     struct ProcessedDataQueue {
@@ -290,9 +371,11 @@ private:
     QMap<QString, ProcessedDataQueue> m_processedDataQueues; // 处理后数据队列 (通道ID -> 数据队列)
 
     // 同步和处理
-    QTimer* m_processingTimer;                           // 处理定时器
+    SyncClock* m_syncClock;                              // 同步时钟（绝对截止时刻，无漂移）
     int m_syncIntervalMs;                                // 同步间隔（毫秒）
     Core::SynchronizedDataFrame m_latestSyncFrame;       // 最新的同步数据帧
+    Core::TripleBuffer<Core::SynchronizedDataFrame> m_publishedFrame; // 发布给UI的最新帧（无锁三缓冲）
+    quint64 m_frameSequence;                             // 帧序号
 
     // 线程安全
     mutable QMutex m_mutex;                              // 互斥锁
@@ -301,6 +384,9 @@ private:
 
     // 常量
     static const int MAX_QUEUE_SIZE = 1000;              // 最大队列长度
+    static const int MAX_ALIGNED_FRAMES_PER_TICK = 200;  // 每个节拍最多输出的对齐帧数
+    static const int ALIGNMENT_REPORT_INTERVAL_MS = 5000; // 对齐统计输出周期
+    static const int INGEST_TRACE_SAMPLE_EVERY = 256;    // 逐点样本每设备每隔多少个记录一次LatencyTrace
 
     // 数据存储
     DataStorage* m_dataStorage;                          // 数据存储器
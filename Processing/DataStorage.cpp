@@ -1,4 +1,6 @@
 #include "DataStorage.h"
+#include "../Core/Metrics.h"
+#include "../Core/LatencyTrace.h"
 #include <QDir>
 #include <QDebug>
 #include <QCoreApplication>
@@ -110,11 +112,18 @@ void DataStorage::onSyncFrameReady(Core::SynchronizedDataFrame frame)
         return;
     }
 
+    Core::Metrics::ScopedTimer writeTimer(Core::Metrics::StorageWrite);
+
     // 写入数据行
     if (!writeDataRow(frame)) {
         qDebug() << "写入数据行失败!";
         emit storageError("写入数据行失败: " + m_file.errorString());
+        return;
     }
+    Core::Metrics::increment(Core::Metrics::StoredRows);
+
+    // 采集到写入文件（进入文件缓冲区）的延迟
+    Core::LatencyTrace::recordFrame(Core::LatencyTrace::AcquisitionToDisk, frame, Core::Timebase::nowNs());
 }
 
 void DataStorage::onProcessedDataPointReady(QString channelId, Core::ProcessedDataPoint dataPoint)
@@ -150,7 +159,7 @@ bool DataStorage::createStorageFile(qint64 startTimestamp)
     }
 
     // 根据开始时间戳创建文件名
-    QString timeStr = QDateTime::fromMSecsSinceEpoch(startTimestamp).toString("yyyyMMdd_HHmmss");
+    QString timeStr = Core::Timebase::toDateTime(startTimestamp).toString("yyyyMMdd_HHmmss");
     m_currentFilePath = m_storageDirectory + "/" + timeStr + ".csv";
 
     // 打开文件
@@ -177,8 +186,14 @@ bool DataStorage::createStorageFile(qint64 startTimestamp)
 
 bool DataStorage::writeHeader(const QStringList& channelIds)
 {
+    // 记录时间基准锚点：MonotonicTime列为单调时钟纳秒数，加上锚点即为UTC纳秒
+    m_stream << "# timebase_anchor_utc_ns=" << Core::Timebase::anchorWallNs()
+             << ",start_monotonic_ns=" << m_startTimestamp
+             << ",start_utc=" << Core::Timebase::toDateTime(m_startTimestamp).toUTC().toString(Qt::ISODateWithMs)
+             << "\n";
+
     // 写入文件头
-    m_stream << "ReadableTime,RelativeTime(s)";
+    m_stream << "ReadableTime,RelativeTime(s),MonotonicTime(ns)";
 
     // 写入通道ID
     for (const QString& channelId : channelIds) {
@@ -193,12 +208,13 @@ bool DataStorage::writeHeader(const QStringList& channelIds)
 bool DataStorage::writeDataRow(const Core::SynchronizedDataFrame& frame)
 {
     // 写入可读时间格式
-    QString timeStr = QDateTime::fromMSecsSinceEpoch(frame.timestamp).toString("hh:mm:ss.zzz");
+    QString timeStr = Core::Timebase::toDateTime(frame.timestamp).toString("hh:mm:ss.zzz");
     m_stream << timeStr;
 
-    // 写入相对时间（秒）
-    double relativeTime = (frame.timestamp - m_startTimestamp) / 1000.0;
-    m_stream << "," << QString::number(relativeTime, 'f', 3);
+    // 写入相对时间（秒，微秒精度）和单调时钟时间戳
+    double relativeTime = Core::Timebase::secondsBetween(m_startTimestamp, frame.timestamp);
+    m_stream << "," << QString::number(relativeTime, 'f', 6);
+    m_stream << "," << frame.timestamp;
 
     // 写入各通道的值
     for (const QString& channelId : m_channelIds) {
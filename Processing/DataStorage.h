@@ -35,7 +35,7 @@ public:
 
     /**
      * @brief 开始数据存储
-     * @param startTimestamp 采集开始的时间戳（毫秒）
+     * @param startTimestamp 采集开始的时间戳（Core::Timebase纳秒）
      * @return 是否成功开始存储
      */
     bool startStorage(qint64 startTimestamp);
@@ -95,7 +95,7 @@ signals:
 private:
     /**
      * @brief 创建存储文件
-     * @param startTimestamp 采集开始的时间戳（毫秒）
+     * @param startTimestamp 采集开始的时间戳（Core::Timebase纳秒）
      * @return 是否成功创建文件
      */
     bool createStorageFile(qint64 startTimestamp);
@@ -128,7 +128,7 @@ private:
     bool m_isStoraging;                  // 是否正在存储
     QStringList m_channelIds;            // 通道ID列表
     mutable QMutex m_mutex;              // 互斥锁
-    qint64 m_startTimestamp;             // 采集开始的时间戳（毫秒）
+    qint64 m_startTimestamp;             // 采集开始的时间戳（Core::Timebase纳秒）
     QMap<QString, Core::ProcessedDataPoint> m_latestDataPoints; // 最新的处理后数据点
 };
 
@@ -1,4 +1,5 @@
 #include "SecondaryInstrument.h"
+#include "../Core/Log.h"
 #include <QThread>
 #include <QRegularExpression>
 
@@ -67,7 +68,7 @@ Core::ProcessedDataPoint SecondaryInstrument::calculate(const QMap<QString, doub
     m_latestDataPoint = dataPoint;
 
     // 记录处理信息
-    qDebug() << "二次计算仪器处理数据:" << m_config.channelName
+    DAQ_TRACE(lcProcessing) << "二次计算仪器处理数据:" << m_config.channelName
              << "结果:" << result
              << "线程ID:" << QThread::currentThreadId();
 
@@ -248,7 +249,8 @@ double SecondaryInstrument::evaluateFormula(const QMap<QString, double>& channel
 
     // 结果应该在值栈的顶部
     if (values.isEmpty()) {
-        qDebug() << "公式计算错误，结果栈为空";
+        DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcProcessing, "公式计算错误，结果栈为空: %s",
+                         qUtf8Printable(m_config.channelName));
         return 0.0;
     }
 
@@ -259,7 +261,8 @@ bool SecondaryInstrument::checkInputChannelsAvailable(const QMap<QString, double
 {
     for (const QString& channel : m_config.inputChannels) {
         if (!channelValues.contains(channel)) {
-            qDebug() << "输入通道不可用:" << channel;
+            DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcProcessing, "二次计算仪器 %s 的输入通道不可用: %s",
+                             qUtf8Printable(m_config.channelName), qUtf8Printable(channel));
             return false;
         }
     }
@@ -284,12 +287,13 @@ double SecondaryInstrument::applyOperator(const QChar& op, double a, double b) c
     case '*': return a * b;
     case '/':
         if (b == 0.0) {
-            qDebug() << "除零错误";
+            DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcProcessing, "二次计算仪器 %s 除零错误",
+                             qUtf8Printable(m_config.channelName));
             return 0.0;
         }
         return a / b;
     default:
-        qDebug() << "未知操作符:" << op;
+        DAQ_LOG_EVERY_MS(5000, QtWarningMsg, lcProcessing, "未知操作符: %s", qUtf8Printable(QString(op)));
         return 0.0;
     }
 }
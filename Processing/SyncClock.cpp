@@ -0,0 +1,160 @@
+#include "SyncClock.h"
+#include <QThread>
+#include <QDebug>
+
+namespace Processing {
+
+SyncClock::SyncClock(int intervalMs, QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+    , m_intervalNs(static_cast<qint64>(qMax(1, intervalMs)) * Core::Timebase::NS_PER_MS)
+    , m_spinNs(static_cast<qint64>(DEFAULT_SPIN_US) * 1000)
+    , m_deadlineNs(0)
+    , m_active(false)
+    , m_latenessSumUs(0.0)
+    , m_lastReportNs(0)
+{
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &SyncClock::onTimeout);
+}
+
+void SyncClock::setIntervalMs(int intervalMs)
+{
+    qint64 intervalNs = static_cast<qint64>(qMax(1, intervalMs)) * Core::Timebase::NS_PER_MS;
+    if (intervalNs == m_intervalNs) {
+        return;
+    }
+
+    m_intervalNs = intervalNs;
+    if (m_active) {
+        // 从当前时刻重新对齐到新间隔
+        qint64 nowNs = Core::Timebase::nowNs();
+        m_deadlineNs = nowNs - nowNs % m_intervalNs + m_intervalNs;
+        scheduleNext();
+    }
+}
+
+int SyncClock::intervalMs() const
+{
+    return static_cast<int>(m_intervalNs / Core::Timebase::NS_PER_MS);
+}
+
+qint64 SyncClock::intervalNs() const
+{
+    return m_intervalNs;
+}
+
+void SyncClock::setSpinUs(int spinUs)
+{
+    m_spinNs = static_cast<qint64>(qMax(0, spinUs)) * 1000;
+}
+
+qint64 SyncClock::spinWindowNs() const
+{
+    // 自旋在处理器线程上进行，期间事件循环无法接收数据，最多占间隔的一小部分
+    return qMin(m_spinNs, m_intervalNs / MAX_SPIN_FRACTION);
+}
+
+void SyncClock::start()
+{
+    qint64 nowNs = Core::Timebase::nowNs();
+
+    // 截止时刻取间隔的整数倍，便于不同数据流按时间戳对齐
+    m_deadlineNs = nowNs - nowNs % m_intervalNs + m_intervalNs;
+    m_active = true;
+
+    m_statistics = Statistics();
+    m_latenessSumUs = 0.0;
+    m_lastReportNs = nowNs;
+
+    scheduleNext();
+}
+
+void SyncClock::stop()
+{
+    m_active = false;
+    m_timer->stop();
+}
+
+bool SyncClock::isActive() const
+{
+    return m_active;
+}
+
+void SyncClock::onTimeout()
+{
+    if (!m_active) {
+        return;
+    }
+
+    qint64 nowNs = Core::Timebase::nowNs();
+    qint64 remainingNs = m_deadlineNs - nowNs;
+
+    if (remainingNs > spinWindowNs()) {
+        // 定时器提前唤醒（定时器余量），剩余时间仍在自旋窗口之外时重新设定定时器
+        scheduleNext();
+        return;
+    }
+
+    // 最后一小段时间自旋等待，避免定时器的毫秒粒度带来的误差
+    while (remainingNs > 0) {
+        QThread::yieldCurrentThread();
+        nowNs = Core::Timebase::nowNs();
+        remainingNs = m_deadlineNs - nowNs;
+    }
+
+    qint64 deadlineNs = m_deadlineNs;
+    qint64 latenessNs = nowNs - deadlineNs;
+
+    // 落后超过一个间隔时跳过错过的节拍，下一个截止时刻仍在原网格上
+    qint64 missed = latenessNs / m_intervalNs;
+    m_deadlineNs += (missed + 1) * m_intervalNs;
+    m_statistics.missedTicks += static_cast<quint64>(missed);
+
+    ++m_statistics.ticks;
+    double latenessUs = latenessNs / 1000.0;
+    m_latenessSumUs += latenessUs;
+    m_statistics.maxLatenessUs = qMax(m_statistics.maxLatenessUs, latenessUs);
+
+    // 先设定下一个节拍，处理耗时不影响截止时刻
+    scheduleNext();
+
+    emit tick(deadlineNs, latenessNs);
+
+    if (nowNs - m_lastReportNs >= REPORT_INTERVAL_MS * Core::Timebase::NS_PER_MS) {
+        reportStatistics(nowNs);
+    }
+}
+
+void SyncClock::scheduleNext()
+{
+    if (!m_active) {
+        return;
+    }
+
+    // 定时器睡到自旋窗口开始，向上取整到毫秒：在窗口之外时至少睡1毫秒，不会以0毫秒反复重设定时器；
+    // 取整余量超过自旋窗口时节拍会迟到不到1毫秒，计入迟到统计
+    qint64 sleepNs = m_deadlineNs - Core::Timebase::nowNs() - spinWindowNs();
+    int sleepMs = sleepNs > 0
+        ? static_cast<int>((sleepNs + Core::Timebase::NS_PER_MS - 1) / Core::Timebase::NS_PER_MS)
+        : 0;
+    m_timer->start(sleepMs);
+}
+
+void SyncClock::reportStatistics(qint64 nowNs)
+{
+    m_statistics.meanLatenessUs = m_statistics.ticks > 0 ? m_latenessSumUs / m_statistics.ticks : 0.0;
+
+    qDebug() << "同步时钟统计 - 间隔:" << m_intervalNs / 1000.0 << "微秒"
+             << "节拍数:" << m_statistics.ticks
+             << "跳过节拍:" << m_statistics.missedTicks
+             << "平均迟到:" << m_statistics.meanLatenessUs << "微秒"
+             << "最大迟到:" << m_statistics.maxLatenessUs << "微秒";
+
+    m_statistics = Statistics();
+    m_latenessSumUs = 0.0;
+    m_lastReportNs = nowNs;
+}
+
+} // namespace Processing
@@ -0,0 +1,110 @@
+#ifndef SYNCCLOCK_H
+#define SYNCCLOCK_H
+
+#include <QObject>
+#include <QTimer>
+#include "../Core/Timebase.h"
+
+namespace Processing {
+
+/**
+ * @brief 同步时钟
+ * 按Core::Timebase计算绝对截止时刻（起点 + 序号 × 间隔）驱动同步帧生成，
+ * 每个节拍按剩余时间重新设定单次定时器，定时器的舍入误差和事件循环延迟不会累积；
+ * 截止时刻前的最后一小段时间（不超过间隔的1/10）自旋等待，提前唤醒时重新设定定时器，支持1毫秒的间隔。
+ * 落后超过一个间隔的节拍被跳过并计数，而不是连续补发。
+ */
+class SyncClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 节拍统计
+     */
+    struct Statistics {
+        quint64 ticks = 0;             // 统计周期内的节拍数
+        quint64 missedTicks = 0;       // 统计周期内因落后被跳过的节拍数
+        double meanLatenessUs = 0.0;   // 平均迟到（微秒）
+        double maxLatenessUs = 0.0;    // 最大迟到（微秒）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param intervalMs 节拍间隔（毫秒）
+     * @param parent 父对象
+     */
+    explicit SyncClock(int intervalMs = 100, QObject *parent = nullptr);
+
+    /**
+     * @brief 设置节拍间隔，运行中修改时从下一个节拍开始以新间隔重新对齐
+     * @param intervalMs 节拍间隔（毫秒，不小于1）
+     */
+    void setIntervalMs(int intervalMs);
+
+    /**
+     * @brief 节拍间隔（毫秒）
+     */
+    int intervalMs() const;
+
+    /**
+     * @brief 节拍间隔（纳秒）
+     */
+    qint64 intervalNs() const;
+
+    /**
+     * @brief 设置自旋等待时长：截止时刻前剩余时间不超过该值时不再交给定时器
+     * 实际自旋时长不超过节拍间隔的1/MAX_SPIN_FRACTION
+     * @param spinUs 自旋时长（微秒，0表示不自旋）
+     */
+    void setSpinUs(int spinUs);
+
+    /**
+     * @brief 开始计时，第一个截止时刻为当前时刻对齐到间隔整数倍后的下一个时刻
+     */
+    void start();
+
+    /**
+     * @brief 停止计时
+     */
+    void stop();
+
+    /**
+     * @brief 是否正在计时
+     */
+    bool isActive() const;
+
+signals:
+    /**
+     * @brief 节拍信号
+     * @param deadlineNs 本节拍的截止时刻（Timebase纳秒，严格等间隔）
+     * @param latenessNs 实际触发时刻相对截止时刻的迟到（纳秒）
+     */
+    void tick(qint64 deadlineNs, qint64 latenessNs);
+
+private slots:
+    void onTimeout();
+
+private:
+    void scheduleNext();
+    void reportStatistics(qint64 nowNs);
+    qint64 spinWindowNs() const;
+
+    QTimer *m_timer;
+    qint64 m_intervalNs;
+    qint64 m_spinNs;               // 配置的自旋时长
+    qint64 m_deadlineNs;           // 下一个截止时刻
+    bool m_active;
+
+    Statistics m_statistics;       // 当前统计周期
+    double m_latenessSumUs;        // 当前统计周期的迟到和
+    qint64 m_lastReportNs;         // 上次输出统计的时刻
+
+    static constexpr int REPORT_INTERVAL_MS = 5000;   // 统计输出周期
+    static constexpr int DEFAULT_SPIN_US = 300;       // 默认自旋时长
+    static constexpr int MAX_SPIN_FRACTION = 10;      // 自旋时长不超过间隔的1/10
+};
+
+} // namespace Processing
+
+#endif // SYNCCLOCK_H
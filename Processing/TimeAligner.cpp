@@ -0,0 +1,184 @@
+#include "TimeAligner.h"
+#include <QDebug>
+
+namespace Processing {
+
+TimeAligner::TimeAligner(const Core::AlignmentConfig& config)
+    : m_method(Method::Linear)
+    , m_staleNs(0)
+    , m_historySize(2)
+{
+    setConfig(config);
+}
+
+void TimeAligner::setConfig(const Core::AlignmentConfig& config)
+{
+    m_method = methodFromString(config.method);
+    m_staleNs = static_cast<qint64>(qMax(1, config.staleMs)) * Core::Timebase::NS_PER_MS;
+    m_historySize = qMax(2, config.historySize);
+
+    for (History& history : m_histories) {
+        history.points.resize(m_historySize);
+        history.head = 0;
+        history.count = 0;
+    }
+}
+
+int TimeAligner::addSource()
+{
+    History history;
+    history.points.resize(m_historySize);
+    m_histories.append(history);
+    return m_histories.size() - 1;
+}
+
+int TimeAligner::sourceCount() const
+{
+    return m_histories.size();
+}
+
+void TimeAligner::push(int source, qint64 timestampNs, double value)
+{
+    if (source < 0 || source >= m_histories.size()) {
+        return;
+    }
+
+    History& history = m_histories[source];
+    const int capacity = history.points.size();
+
+    // 时间戳倒退的样本无法插入有序历史，直接丢弃
+    if (history.count > 0 && timestampNs < history.at(history.count - 1).timestamp) {
+        ++m_statistics.outOfOrder;
+        return;
+    }
+
+    if (history.count == capacity) {
+        history.head = (history.head + 1) % capacity;
+        --history.count;
+        ++m_statistics.overwritten;
+    }
+
+    history.points[(history.head + history.count) % capacity] = Point{timestampNs, value};
+    ++history.count;
+    ++m_statistics.pushed;
+}
+
+bool TimeAligner::sample(int source, qint64 timeNs, Sample& sample) const
+{
+    if (source < 0 || source >= m_histories.size()) {
+        return false;
+    }
+
+    const History& history = m_histories[source];
+    const int next = upperBound(history, timeNs);
+    if (next == 0) {
+        // 早于最旧样本（或没有样本）
+        return false;
+    }
+
+    const Point& before = history.at(next - 1);
+
+    // 晚于最新样本，或两侧样本间隔过大（数据源中断过），保持前值
+    if (next == history.count || history.at(next).timestamp - before.timestamp > m_staleNs) {
+        sample.value = before.value;
+        sample.sourceTimestamp = before.timestamp;
+        sample.stale = timeNs - before.timestamp > m_staleNs;
+        return true;
+    }
+
+    const Point& after = history.at(next);
+    sample.stale = false;
+
+    switch (m_method) {
+    case Method::Previous:
+        sample.value = before.value;
+        sample.sourceTimestamp = before.timestamp;
+        break;
+    case Method::Nearest:
+        if (timeNs - before.timestamp <= after.timestamp - timeNs) {
+            sample.value = before.value;
+            sample.sourceTimestamp = before.timestamp;
+        } else {
+            sample.value = after.value;
+            sample.sourceTimestamp = after.timestamp;
+        }
+        break;
+    case Method::Linear:
+    default: {
+        const qint64 span = after.timestamp - before.timestamp;
+        const double ratio = span > 0 ? static_cast<double>(timeNs - before.timestamp) / span : 0.0;
+        sample.value = before.value + (after.value - before.value) * ratio;
+        sample.sourceTimestamp = after.timestamp;
+        break;
+    }
+    }
+
+    return true;
+}
+
+void TimeAligner::discardBefore(qint64 timeNs)
+{
+    const int capacity = m_historySize;
+    for (History& history : m_histories) {
+        // 保留不晚于timeNs的最后一个样本，作为下一个网格点的左侧样本
+        int drop = upperBound(history, timeNs) - 1;
+        if (drop > 0) {
+            history.head = (history.head + drop) % capacity;
+            history.count -= drop;
+        }
+    }
+}
+
+void TimeAligner::clear()
+{
+    for (History& history : m_histories) {
+        history.head = 0;
+        history.count = 0;
+    }
+    m_statistics = Statistics();
+}
+
+void TimeAligner::reset()
+{
+    m_histories.clear();
+    m_statistics = Statistics();
+}
+
+TimeAligner::Statistics TimeAligner::takeStatistics()
+{
+    Statistics statistics = m_statistics;
+    m_statistics = Statistics();
+    return statistics;
+}
+
+TimeAligner::Method TimeAligner::methodFromString(const QString& method)
+{
+    if (method.compare("previous", Qt::CaseInsensitive) == 0) {
+        return Method::Previous;
+    }
+    if (method.compare("nearest", Qt::CaseInsensitive) == 0) {
+        return Method::Nearest;
+    }
+    if (method.compare("linear", Qt::CaseInsensitive) != 0) {
+        qDebug() << "未知的插值方式:" << method << "，使用linear";
+    }
+    return Method::Linear;
+}
+
+int TimeAligner::upperBound(const History& history, qint64 timeNs) const
+{
+    // 第一个时间戳大于timeNs的样本位置
+    int low = 0;
+    int high = history.count;
+    while (low < high) {
+        const int mid = (low + high) / 2;
+        if (history.at(mid).timestamp <= timeNs) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+} // namespace Processing
@@ -0,0 +1,142 @@
+#ifndef TIMEALIGNER_H
+#define TIMEALIGNER_H
+
+#include <QVector>
+#include <QString>
+#include "../Core/DataTypes.h"
+
+namespace Processing {
+
+/**
+ * @brief 时间对齐重采样器
+ * 为每个数据源（设备通道）保留一段按时间戳排序的历史样本，
+ * 在任意时刻按配置的插值方式取值，使不同采样率的设备在同一输出网格点上对齐。
+ * 只在处理器线程中使用，不做加锁。
+ */
+class TimeAligner
+{
+public:
+    /**
+     * @brief 插值方式
+     */
+    enum class Method {
+        Linear,     // 两侧样本线性插值
+        Previous,   // 取不晚于该时刻的最近样本（前值保持）
+        Nearest     // 取时间上最近的样本
+    };
+
+    /**
+     * @brief 取样结果
+     */
+    struct Sample {
+        double value = 0.0;          // 对齐后的值
+        qint64 sourceTimestamp = 0;  // 参与取值的最新样本时间戳（Timebase纳秒）
+        bool stale = false;          // 数据源是否已过期
+    };
+
+    /**
+     * @brief 统计信息
+     */
+    struct Statistics {
+        quint64 pushed = 0;          // 写入的样本数
+        quint64 outOfOrder = 0;      // 因时间戳倒退被丢弃的样本数
+        quint64 overwritten = 0;     // 历史已满时被覆盖的最旧样本数
+    };
+
+    /**
+     * @brief 构造函数
+     * @param config 时间对齐配置
+     */
+    explicit TimeAligner(const Core::AlignmentConfig& config = Core::AlignmentConfig());
+
+    /**
+     * @brief 设置配置（清空全部历史）
+     * @param config 时间对齐配置
+     */
+    void setConfig(const Core::AlignmentConfig& config);
+
+    /**
+     * @brief 添加数据源
+     * @return 数据源索引
+     */
+    int addSource();
+
+    /**
+     * @brief 数据源数量
+     */
+    int sourceCount() const;
+
+    /**
+     * @brief 写入一个样本，时间戳早于该源最新样本的样本被丢弃
+     * @param source 数据源索引
+     * @param timestampNs 样本时间戳（Timebase纳秒）
+     * @param value 样本值
+     */
+    void push(int source, qint64 timestampNs, double value);
+
+    /**
+     * @brief 在指定时刻取值
+     * 该时刻位于两样本之间时按插值方式取值；晚于最新样本时保持最新值，
+     * 超过过期时间或两侧样本间隔超过过期时间时标记为过期；早于最旧样本时无值
+     * @param source 数据源索引
+     * @param timeNs 取值时刻（Timebase纳秒）
+     * @param sample 取样结果（输出）
+     * @return 是否有值
+     */
+    bool sample(int source, qint64 timeNs, Sample& sample) const;
+
+    /**
+     * @brief 丢弃不再需要的历史：每个源只保留不晚于该时刻的最后一个样本及之后的样本
+     * @param timeNs 下一个要取值的时刻（Timebase纳秒）
+     */
+    void discardBefore(qint64 timeNs);
+
+    /**
+     * @brief 清空全部历史（保留数据源）
+     */
+    void clear();
+
+    /**
+     * @brief 清除数据源和历史
+     */
+    void reset();
+
+    /**
+     * @brief 获取并清零统计信息
+     */
+    Statistics takeStatistics();
+
+    /**
+     * @brief 从配置字符串解析插值方式
+     * @param method "linear"、"previous"或"nearest"
+     * @return 插值方式，未知字符串返回Linear
+     */
+    static Method methodFromString(const QString& method);
+
+private:
+    struct Point {
+        qint64 timestamp;
+        double value;
+    };
+
+    // 每个数据源的环形历史
+    struct History {
+        QVector<Point> points;
+        int head = 0;       // 最旧样本位置
+        int count = 0;      // 样本数
+
+        const Point& at(int i) const { return points[(head + i) % points.size()]; }
+    };
+
+    int upperBound(const History& history, qint64 timeNs) const;
+
+    QVector<History> m_histories;
+    Method m_method;
+    qint64 m_staleNs;
+    int m_historySize;
+    Statistics m_statistics;
+};
+
+} // namespace Processing
+
+#endif // TIMEALIGNER_H
@@ -0,0 +1,774 @@
+#include "ArtDAQSimulator.h"
+#include "../Include/Art_DAQ.h"
+#include <QMap>
+#include <QVector>
+#include <QStringList>
+#include <QRegularExpression>
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace Simulation {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double MAX_SAMPLE_RATE = 2.0e6;        // 每通道最高采样率
+constexpr int IDLE_WAKE_PER_SECOND = 100;        // 未注册回调时驱动线程的唤醒频率
+constexpr int ERROR_MESSAGE_SIZE = 512;
+
+struct GlobalState {
+    std::mutex mutex;
+    ArtDAQSimulator::Waveform defaultWaveform;
+    QMap<int, ArtDAQSimulator::Waveform> channelWaveforms;
+    bool environmentLoaded = false;
+    ArtDAQSimulator::Statistics statistics;
+    double callbackSumUs = 0.0;
+    std::set<TaskHandle> tasks;                  // 有效的任务句柄
+};
+
+GlobalState& globalState()
+{
+    static GlobalState state;
+    return state;
+}
+
+// 与真实驱动一样，扩展错误信息按线程保存
+thread_local char t_lastError[ERROR_MESSAGE_SIZE] = "";
+
+int32 fail(int32 code, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    char message[ERROR_MESSAGE_SIZE];
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    snprintf(t_lastError, sizeof(t_lastError), "模拟Art_DAQ错误 %ld: %s", static_cast<long>(code), message);
+    return code;
+}
+
+int32 succeed()
+{
+    t_lastError[0] = '\0';
+    return ArtDAQSuccess;
+}
+
+void loadEnvironmentLocked(GlobalState& state)
+{
+    if (state.environmentLoaded) {
+        return;
+    }
+    state.environmentLoaded = true;
+
+    const QString text = qEnvironmentVariable("ARTDAQ_SIM_WAVEFORM");
+    if (!text.isEmpty()) {
+        ArtDAQSimulator::Waveform waveform;
+        if (ArtDAQSimulator::parseWaveform(text, waveform)) {
+            state.defaultWaveform = waveform;
+        } else {
+            qDebug() << "[ArtDAQSimulator] 无法解析ARTDAQ_SIM_WAVEFORM:" << text;
+        }
+    }
+}
+
+// 连续采集的缓冲区大小（每通道样本数），与真实驱动的自动配置规则一致
+quint64 continuousBufferScans(double rate, int sampsPerChan)
+{
+    quint64 scans = 1000;
+    if (rate > 1.0e6) {
+        scans = 1000000;
+    } else if (rate > 10000.0) {
+        scans = 100000;
+    } else if (rate > 100.0) {
+        scans = 10000;
+    }
+    return qMax<quint64>(scans, static_cast<quint64>(qMax(0, sampsPerChan)));
+}
+
+// 解析物理通道字符串（"Dev1/ai0,Dev1/ai1"或"Dev1/ai0:3"），返回通道数，格式错误时返回0
+int countPhysicalChannels(const QString& physicalChannel)
+{
+    int count = 0;
+    const QStringList parts = physicalChannel.split(',', Qt::SkipEmptyParts);
+    for (const QString& part : parts) {
+        const QString name = part.trimmed().section('/', -1);
+        const int digits = name.indexOf(QRegularExpression("[0-9]"));
+        if (!name.startsWith("ai", Qt::CaseInsensitive) || digits < 0) {
+            return 0;
+        }
+
+        const QStringList range = name.mid(digits).split(':');
+        bool firstOk = false;
+        bool lastOk = true;
+        const int first = range[0].toInt(&firstOk);
+        const int last = range.size() > 1 ? range[1].remove(QRegularExpression("^[A-Za-z]+")).toInt(&lastOk) : first;
+        if (!firstOk || !lastOk || range.size() > 2) {
+            return 0;
+        }
+        count += qAbs(last - first) + 1;
+    }
+    return count;
+}
+
+/**
+ * 模拟的采集任务
+ * 驱动线程持有m_mutex时只操作缓冲区和状态，调用回调前释放
+ */
+class SimulatedTask
+{
+public:
+    explicit SimulatedTask(const QString& name)
+        : m_name(name)
+    {
+    }
+
+    ~SimulatedTask()
+    {
+        stop();
+    }
+
+    bool isDriverThread() const
+    {
+        return std::this_thread::get_id() == m_threadId;
+    }
+
+    int32 addChannels(int count, double minVal, double maxVal)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return fail(ArtDAQError_CanNotPerformOpWhileTaskRunning, "任务运行中不能添加通道");
+        }
+        if (minVal >= maxVal) {
+            return fail(ArtDAQError_MinNotLessThanMax, "最小值 %g 不小于最大值 %g", minVal, maxVal);
+        }
+        m_channelCount += count;
+        m_minVal = minVal;
+        m_maxVal = maxVal;
+        return succeed();
+    }
+
+    int32 configureTiming(double rate, int32 sampleMode, int32 sampsPerChan)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return fail(ArtDAQError_CannotSetPropertyWhenTaskRunning, "任务运行中不能修改采样时钟");
+        }
+        if (rate <= 0.0) {
+            return fail(ArtDAQError_SampRateTooLow, "采样率 %g 无效", rate);
+        }
+        if (rate > MAX_SAMPLE_RATE) {
+            return fail(ArtDAQError_SampRateTooHigh, "采样率 %g 超过上限 %g", rate, MAX_SAMPLE_RATE);
+        }
+        if (sampleMode != ArtDAQ_Val_ContSamps && sampleMode != ArtDAQ_Val_FiniteSamps) {
+            return fail(ArtDAQError_InvalidAttributeValue, "不支持的采样模式 %ld", static_cast<long>(sampleMode));
+        }
+        m_rate = rate;
+        m_sampleMode = sampleMode;
+        m_sampsPerChan = sampsPerChan;
+        return succeed();
+    }
+
+    int32 registerEveryN(int32 eventType, uInt32 nSamples, ArtDAQ_EveryNSamplesEventCallbackPtr callback, void* data)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return fail(ArtDAQError_CannotRegisterArtDAQSoftwareEventWhileTaskIsRunning, "任务运行中不能注册事件");
+        }
+        if (eventType != ArtDAQ_Val_Acquired_Into_Buffer) {
+            return fail(ArtDAQError_EveryNSampsTransferredFromBufferNotForInput, "模拟输入只支持Acquired_Into_Buffer事件");
+        }
+        if (callback && nSamples == 0) {
+            return fail(ArtDAQError_InvalidAttributeValue, "回调样本数不能为0");
+        }
+        m_everyN = callback ? nSamples : 0;
+        m_everyNCallback = callback;
+        m_everyNData = data;
+        return succeed();
+    }
+
+    int32 registerDone(ArtDAQ_DoneEventCallbackPtr callback, void* data)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return fail(ArtDAQError_CannotRegisterArtDAQSoftwareEventWhileTaskIsRunning, "任务运行中不能注册事件");
+        }
+        m_doneCallback = callback;
+        m_doneData = data;
+        return succeed();
+    }
+
+    int32 start()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_running) {
+            return fail(ArtDAQError_CanNotPerformOpWhileTaskRunning, "任务已在运行");
+        }
+        if (m_channelCount <= 0) {
+            return fail(ArtDAQError_CanNotPerformOpWhenNoChansInTask, "任务中没有通道");
+        }
+        if (m_rate <= 0.0) {
+            return fail(ArtDAQError_InvalidTimingType, "未配置采样时钟");
+        }
+
+        // 上一次运行的驱动线程（已停止或已完成）
+        if (m_thread.joinable()) {
+            if (isDriverThread()) {
+                return fail(ArtDAQError_CanNotPerformOpWhileTaskRunning, "不能在回调中重新启动任务");
+            }
+            lock.unlock();
+            m_thread.join();
+            lock.lock();
+        }
+
+        m_waveforms.clear();
+        for (int i = 0; i < m_channelCount; ++i) {
+            m_waveforms.append(ArtDAQSimulator::waveform(i));
+        }
+
+        m_capacityScans = m_sampleMode == ArtDAQ_Val_FiniteSamps
+                              ? static_cast<quint64>(qMax(1, static_cast<int>(m_sampsPerChan)))
+                              : continuousBufferScans(m_rate, m_sampsPerChan);
+        m_buffer.assign(m_capacityScans * m_channelCount, 0.0);
+        m_writeScan = 0;
+        m_readScan = 0;
+        m_pendingError = ArtDAQSuccess;
+        m_stopRequested = false;
+        m_running = true;
+        m_random.seed(static_cast<unsigned int>(reinterpret_cast<quintptr>(this)));
+        m_thread = std::thread(&SimulatedTask::run, this);
+        m_threadId = m_thread.get_id();
+
+        GlobalState& state = globalState();
+        std::lock_guard<std::mutex> stateLock(state.mutex);
+        ++state.statistics.tasksStarted;
+        return succeed();
+    }
+
+    int32 stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable()) {
+                return succeed();
+            }
+            m_stopRequested = true;
+        }
+        m_wakeCondition.notify_all();
+        m_dataCondition.notify_all();
+
+        // 在回调中停止：驱动线程在回调返回后自行退出
+        if (isDriverThread()) {
+            return succeed();
+        }
+
+        m_thread.join();
+        qDebug() << "[ArtDAQSimulator] 任务已停止:" << m_name << "扫描数:" << m_writeScan;
+        return succeed();
+    }
+
+    // 在驱动线程中清除任务：驱动线程退出时删除自身
+    void releaseFromDriverThread()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+        m_deleteOnExit = true;
+        m_thread.detach();
+    }
+
+    int32 read(int32 numSampsPerChan, float64 timeout, bool32 fillMode,
+               float64 readArray[], uInt32 arraySizeInSamps, int32* sampsPerChanRead)
+    {
+        if (sampsPerChanRead) {
+            *sampsPerChanRead = 0;
+        }
+        if (!readArray) {
+            return fail(ArtDAQError_NULLPtr, "读取缓冲区为空");
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_pendingError != ArtDAQSuccess) {
+            return fail(m_pendingError, "未读样本已被覆盖，请提高读取频率或增大缓冲区");
+        }
+        if (m_channelCount <= 0) {
+            return fail(ArtDAQError_ReadNoInputChansInTask, "任务中没有输入通道");
+        }
+
+        if (numSampsPerChan < 0 && numSampsPerChan != ArtDAQ_Val_Auto) {
+            return fail(ArtDAQError_InvalidNumberSamplesToRead, "读取样本数 %ld 无效", static_cast<long>(numSampsPerChan));
+        }
+        quint64 wanted = numSampsPerChan == ArtDAQ_Val_Auto
+                             ? m_writeScan - m_readScan
+                             : static_cast<quint64>(numSampsPerChan);
+        if (wanted > m_capacityScans) {
+            return fail(ArtDAQError_SamplesWillNeverBeAvailable, "读取样本数超过缓冲区大小");
+        }
+        if (wanted * m_channelCount > arraySizeInSamps) {
+            return fail(ArtDAQError_ReadBufferTooSmall, "读取缓冲区太小: 需要 %llu，提供 %lu",
+                        static_cast<unsigned long long>(wanted * m_channelCount),
+                        static_cast<unsigned long>(arraySizeInSamps));
+        }
+
+        // 数据不足时等待（回调中读取时数据总是已就绪，不能等待）
+        const auto enough = [this, wanted]() {
+            return m_writeScan - m_readScan >= wanted || !m_running || m_pendingError != ArtDAQSuccess;
+        };
+        if (!enough() && !isDriverThread()) {
+            if (timeout < 0.0) {
+                m_dataCondition.wait(lock, enough);
+            } else {
+                m_dataCondition.wait_for(lock, std::chrono::duration<double>(timeout), enough);
+            }
+        }
+
+        int32 result = ArtDAQSuccess;
+        const quint64 available = m_writeScan - m_readScan;
+        if (available < wanted) {
+            wanted = available;
+            result = fail(ArtDAQError_SamplesNotYetAvailable, "超时前只读到 %llu 个样本",
+                          static_cast<unsigned long long>(available));
+        }
+
+        const int channels = m_channelCount;
+        for (quint64 s = 0; s < wanted; ++s) {
+            const double* scan = m_buffer.data() + ((m_readScan + s) % m_capacityScans) * channels;
+            for (int ch = 0; ch < channels; ++ch) {
+                const quint64 index = fillMode == ArtDAQ_Val_GroupByScanNumber ? s * channels + ch : ch * wanted + s;
+                readArray[index] = scan[ch];
+            }
+        }
+        m_readScan += wanted;
+
+        if (sampsPerChanRead) {
+            *sampsPerChanRead = static_cast<int32>(wanted);
+        }
+        return result == ArtDAQSuccess ? succeed() : result;
+    }
+
+private:
+    Clock::time_point scanTime(quint64 scan) const
+    {
+        return m_startTime + std::chrono::nanoseconds(static_cast<qint64>(scan * 1e9 / m_rate));
+    }
+
+    double sample(int channel, quint64 scan)
+    {
+        const ArtDAQSimulator::Waveform& waveform = m_waveforms[channel];
+        const double t = scan / m_rate;
+        const double cycles = waveform.frequency * t + channel / 8.0;   // 通道间错开相位
+        const double fraction = cycles - std::floor(cycles);
+
+        double shape = 0.0;
+        switch (waveform.shape) {
+            case ArtDAQSimulator::Shape::Sine: shape = qSin(2.0 * M_PI * fraction); break;
+            case ArtDAQSimulator::Shape::Square: shape = fraction < 0.5 ? 1.0 : -1.0; break;
+            case ArtDAQSimulator::Shape::Triangle: shape = 1.0 - 4.0 * qAbs(fraction - 0.5); break;
+            case ArtDAQSimulator::Shape::Sawtooth: shape = 2.0 * fraction - 1.0; break;
+            case ArtDAQSimulator::Shape::Noise: shape = m_normal(m_random); break;
+            case ArtDAQSimulator::Shape::Constant: shape = 1.0; break;
+        }
+
+        double value = waveform.offset + waveform.amplitude * shape;
+        if (waveform.noise > 0.0) {
+            value += waveform.noise * m_normal(m_random);
+        }
+        return qBound(m_minVal, value, m_maxVal);
+    }
+
+    // 调用方持有m_mutex；返回false表示缓冲区溢出
+    bool generateLocked(quint64 dueScan)
+    {
+        if (dueScan <= m_writeScan) {
+            return true;
+        }
+
+        // 未读样本超过缓冲区：真实驱动停止任务并在下次读取时报错
+        if (dueScan - m_readScan > m_capacityScans) {
+            m_pendingError = ArtDAQError_SamplesNoLongerAvailable;
+            return false;
+        }
+
+        const int channels = m_channelCount;
+        for (quint64 scan = m_writeScan; scan < dueScan; ++scan) {
+            double* slot = m_buffer.data() + (scan % m_capacityScans) * channels;
+            for (int ch = 0; ch < channels; ++ch) {
+                slot[ch] = sample(ch, scan);
+            }
+        }
+        m_writeScan = dueScan;
+        return true;
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_startTime = Clock::now();
+
+        const quint64 totalScans = m_sampleMode == ArtDAQ_Val_FiniteSamps
+                                       ? m_capacityScans
+                                       : std::numeric_limits<quint64>::max();
+        const quint64 idleStep = qMax<quint64>(1, static_cast<quint64>(m_rate / IDLE_WAKE_PER_SECOND));
+        quint64 nextEvent = m_everyN;
+        quint64 generatedScans = 0;
+        bool finished = false;
+        int32 doneStatus = ArtDAQSuccess;
+
+        while (!m_stopRequested) {
+            // 睡到下一个回调边界（按绝对时间，不累积误差）
+            const quint64 target = qMin(m_everyN > 0 ? nextEvent : m_writeScan + idleStep, totalScans);
+            m_wakeCondition.wait_until(lock, scanTime(target), [this]() { return m_stopRequested; });
+            if (m_stopRequested) {
+                break;
+            }
+
+            const double elapsed = std::chrono::duration<double>(Clock::now() - m_startTime).count();
+            const quint64 due = qMin(static_cast<quint64>(elapsed * m_rate), totalScans);
+            const quint64 before = m_writeScan;
+            const bool ok = generateLocked(due);
+            generatedScans += m_writeScan - before;
+            m_dataCondition.notify_all();
+            if (!ok) {
+                finished = true;
+                doneStatus = m_pendingError;
+                qDebug() << "[ArtDAQSimulator] 缓冲区溢出，任务停止:" << m_name
+                         << "未读扫描数超过" << m_capacityScans;
+                GlobalState& state = globalState();
+                std::lock_guard<std::mutex> stateLock(state.mutex);
+                ++state.statistics.overruns;
+                break;
+            }
+
+            // 每凑满N个样本调用一次回调，回调中读取数据
+            while (m_everyN > 0 && m_writeScan >= nextEvent && !m_stopRequested) {
+                const Clock::time_point boundary = scanTime(nextEvent);
+                const ArtDAQ_EveryNSamplesEventCallbackPtr callback = m_everyNCallback;
+                void* data = m_everyNData;
+                const uInt32 everyN = static_cast<uInt32>(m_everyN);
+                lock.unlock();
+
+                const Clock::time_point begin = Clock::now();
+                callback(this, ArtDAQ_Val_Acquired_Into_Buffer, everyN, data);
+                const Clock::time_point end = Clock::now();
+                recordCallback(std::chrono::duration<double, std::micro>(end - begin).count(),
+                               std::chrono::duration<double, std::micro>(begin - boundary).count());
+
+                lock.lock();
+                nextEvent += m_everyN;
+            }
+
+            if (m_writeScan >= totalScans) {
+                finished = true;
+                break;
+            }
+        }
+
+        m_running = false;
+        const ArtDAQ_DoneEventCallbackPtr doneCallback = finished ? m_doneCallback : nullptr;
+        void* doneData = m_doneData;
+        lock.unlock();
+        m_dataCondition.notify_all();
+
+        {
+            GlobalState& state = globalState();
+            std::lock_guard<std::mutex> stateLock(state.mutex);
+            state.statistics.scans += generatedScans;
+        }
+
+        if (doneCallback) {
+            doneCallback(this, doneStatus, doneData);
+        }
+
+        lock.lock();
+        const bool deleteOnExit = m_deleteOnExit;
+        lock.unlock();
+        if (deleteOnExit) {
+            delete this;
+        }
+    }
+
+    static void recordCallback(double durationUs, double latenessUs)
+    {
+        GlobalState& state = globalState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        ArtDAQSimulator::Statistics& statistics = state.statistics;
+        ++statistics.callbacks;
+        state.callbackSumUs += durationUs;
+        statistics.meanCallbackUs = state.callbackSumUs / statistics.callbacks;
+        statistics.maxCallbackUs = qMax(statistics.maxCallbackUs, durationUs);
+        statistics.maxLatenessUs = qMax(statistics.maxLatenessUs, latenessUs);
+    }
+
+    QString m_name;
+    int m_channelCount = 0;
+    double m_minVal = -10.0;
+    double m_maxVal = 10.0;
+    double m_rate = 0.0;
+    int32 m_sampleMode = ArtDAQ_Val_ContSamps;
+    int32 m_sampsPerChan = 0;
+    quint64 m_everyN = 0;
+    ArtDAQ_EveryNSamplesEventCallbackPtr m_everyNCallback = nullptr;
+    void* m_everyNData = nullptr;
+    ArtDAQ_DoneEventCallbackPtr m_doneCallback = nullptr;
+    void* m_doneData = nullptr;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;     // 唤醒驱动线程（停止）
+    std::condition_variable m_dataCondition;     // 通知等待数据的读取方
+    std::thread m_thread;
+    std::thread::id m_threadId;
+    bool m_running = false;
+    bool m_stopRequested = false;
+    bool m_deleteOnExit = false;
+    int32 m_pendingError = ArtDAQSuccess;
+
+    Clock::time_point m_startTime;
+    std::vector<double> m_buffer;                // 环形缓冲区（按扫描交错）
+    quint64 m_capacityScans = 0;
+    quint64 m_writeScan = 0;                     // 已产生的扫描数
+    quint64 m_readScan = 0;                      // 已读取的扫描数
+    QVector<ArtDAQSimulator::Waveform> m_waveforms;
+    std::mt19937 m_random;
+    std::normal_distribution<double> m_normal;
+};
+
+SimulatedTask* findTask(TaskHandle handle)
+{
+    GlobalState& state = globalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.tasks.count(handle) ? static_cast<SimulatedTask*>(handle) : nullptr;
+}
+
+} // namespace
+
+void ArtDAQSimulator::setWaveform(const Waveform& waveform)
+{
+    GlobalState& state = globalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.environmentLoaded = true;   // 显式设置优先于环境变量
+    state.defaultWaveform = waveform;
+}
+
+void ArtDAQSimulator::setChannelWaveform(int channelIndex, const Waveform& waveform)
+{
+    GlobalState& state = globalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.channelWaveforms.insert(channelIndex, waveform);
+}
+
+void ArtDAQSimulator::clearChannelWaveforms()
+{
+    GlobalState& state = globalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.channelWaveforms.clear();
+}
+
+ArtDAQSimulator::Waveform ArtDAQSimulator::waveform(int channelIndex)
+{
+    GlobalState& state = globalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    loadEnvironmentLocked(state);
+    return state.channelWaveforms.value(channelIndex, state.defaultWaveform);
+}
+
+bool ArtDAQSimulator::parseWaveform(const QString& text, Waveform& waveform)
+{
+    const QStringList parts = text.split(',');
+    const QString shape = parts.value(0).trimmed().toLower();
+
+    Waveform result;
+    if (shape == "sine") {
+        result.shape = Shape::Sine;
+    } else if (shape == "square") {
+        result.shape = Shape::Square;
+    } else if (shape == "triangle") {
+        result.shape = Shape::Triangle;
+    } else if (shape == "sawtooth") {
+        result.shape = Shape::Sawtooth;
+    } else if (shape == "noise") {
+        result.shape = Shape::Noise;
+    } else if (shape == "constant") {
+        result.shape = Shape::Constant;
+    } else {
+        return false;
+    }
+
+    double* fields[] = {&result.amplitude, &result.frequency, &result.offset, &result.noise};
+    for (int i = 1; i < parts.size(); ++i) {
+        bool ok = false;
+        const double value = parts[i].trimmed().toDouble(&ok);
+        if (!ok || i > 4) {
+            return false;
+        }
+        *fields[i - 1] = value;
+    }
+
+    waveform = result;
+    return true;
+}
+
+ArtDAQSimulator::Statistics ArtDAQSimulator::statistics()
+{
+    GlobalState& state = globalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.statistics;
+}
+
+void ArtDAQSimulator::resetStatistics()
+{
+    GlobalState& state = globalState();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.statistics = Statistics();
+    state.callbackSumUs = 0.0;
+}
+
+} // namespace Simulation
+
+using Simulation::SimulatedTask;
+
+// ---- Art_DAQ.h中声明的驱动函数 ----
+
+int32 ART_API ArtDAQ_CreateTask(const char taskName[], TaskHandle *taskHandle)
+{
+    if (!taskHandle) {
+        return Simulation::fail(ArtDAQError_NULLPtr, "任务句柄指针为空");
+    }
+
+    SimulatedTask* task = new SimulatedTask(QString::fromLocal8Bit(taskName ? taskName : ""));
+    Simulation::GlobalState& state = Simulation::globalState();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        Simulation::loadEnvironmentLocked(state);
+        state.tasks.insert(task);
+    }
+    *taskHandle = task;
+    return Simulation::succeed();
+}
+
+int32 ART_API ArtDAQ_CreateAIVoltageChan(TaskHandle taskHandle, const char physicalChannel[], const char nameToAssignToChannel[],
+                                         int32 terminalConfig, float64 minVal, float64 maxVal, int32 units, const char customScaleName[])
+{
+    Q_UNUSED(nameToAssignToChannel);
+    Q_UNUSED(terminalConfig);
+    Q_UNUSED(units);
+    Q_UNUSED(customScaleName);
+
+    SimulatedTask* task = Simulation::findTask(taskHandle);
+    if (!task) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+
+    const int channels = Simulation::countPhysicalChannels(QString::fromLocal8Bit(physicalChannel ? physicalChannel : ""));
+    if (channels <= 0) {
+        return Simulation::fail(ArtDAQError_InvalidPhysChanString, "无效的物理通道: %s", physicalChannel ? physicalChannel : "");
+    }
+    return task->addChannels(channels, minVal, maxVal);
+}
+
+int32 ART_API ArtDAQ_CfgSampClkTiming(TaskHandle taskHandle, const char source[], float64 rate, int32 activeEdge,
+                                      int32 sampleMode, int32 sampsPerChan)
+{
+    Q_UNUSED(source);
+    Q_UNUSED(activeEdge);
+
+    SimulatedTask* task = Simulation::findTask(taskHandle);
+    if (!task) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+    return task->configureTiming(rate, sampleMode, sampsPerChan);
+}
+
+int32 ART_API ArtDAQ_RegisterEveryNSamplesEvent(TaskHandle task, int32 everyNsamplesEventType, uInt32 nSamples, uInt32 options,
+                                                ArtDAQ_EveryNSamplesEventCallbackPtr callbackFunction, void *callbackData)
+{
+    Q_UNUSED(options);
+
+    SimulatedTask* simulatedTask = Simulation::findTask(task);
+    if (!simulatedTask) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+    return simulatedTask->registerEveryN(everyNsamplesEventType, nSamples, callbackFunction, callbackData);
+}
+
+int32 ART_API ArtDAQ_RegisterDoneEvent(TaskHandle task, uInt32 options, ArtDAQ_DoneEventCallbackPtr callbackFunction, void *callbackData)
+{
+    Q_UNUSED(options);
+
+    SimulatedTask* simulatedTask = Simulation::findTask(task);
+    if (!simulatedTask) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+    return simulatedTask->registerDone(callbackFunction, callbackData);
+}
+
+int32 ART_API ArtDAQ_StartTask(TaskHandle taskHandle)
+{
+    SimulatedTask* task = Simulation::findTask(taskHandle);
+    if (!task) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+    return task->start();
+}
+
+int32 ART_API ArtDAQ_StopTask(TaskHandle taskHandle)
+{
+    SimulatedTask* task = Simulation::findTask(taskHandle);
+    if (!task) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+    return task->stop();
+}
+
+int32 ART_API ArtDAQ_ClearTask(TaskHandle taskHandle)
+{
+    SimulatedTask* task = Simulation::findTask(taskHandle);
+    if (!task) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+
+    {
+        Simulation::GlobalState& state = Simulation::globalState();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.tasks.erase(taskHandle);
+    }
+
+    // 在回调中清除任务时不能等待自身退出
+    if (task->isDriverThread()) {
+        task->releaseFromDriverThread();
+    } else {
+        delete task;
+    }
+    return Simulation::succeed();
+}
+
+int32 ART_API ArtDAQ_ReadAnalogF64(TaskHandle taskHandle, int32 numSampsPerChan, float64 timeout, bool32 fillMode,
+                                   float64 readArray[], uInt32 arraySizeInSamps, int32 *sampsPerChanRead, bool32 *reserved)
+{
+    Q_UNUSED(reserved);
+
+    SimulatedTask* task = Simulation::findTask(taskHandle);
+    if (!task) {
+        return Simulation::fail(ArtDAQError_InvalidTask, "无效的任务句柄");
+    }
+    return task->read(numSampsPerChan, timeout, fillMode, readArray, arraySizeInSamps, sampsPerChanRead);
+}
+
+int32 ART_API ArtDAQ_GetExtendedErrorInfo(char errorString[], uInt32 bufferSize)
+{
+    if (!errorString || bufferSize == 0) {
+        return ArtDAQError_NULLPtr;
+    }
+    snprintf(errorString, bufferSize, "%s", Simulation::t_lastError);
+    return std::strlen(Simulation::t_lastError) < bufferSize ? ArtDAQSuccess : ArtDAQError_BufferTooSmallForString;
+}
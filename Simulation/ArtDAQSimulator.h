@@ -0,0 +1,98 @@
+#ifndef ARTDAQSIMULATOR_H
+#define ARTDAQSIMULATOR_H
+
+#include <QtGlobal>
+#include <QString>
+
+namespace Simulation {
+
+/**
+ * @brief Art_DAQ驱动模拟
+ * 以DAQ_SIMULATED_DRIVER构建时代替lib/Art_DAQ.lib，实现DAQDevice用到的ArtDAQ_*函数：
+ * CreateTask、CreateAIVoltageChan、CfgSampClkTiming、RegisterEveryNSamplesEvent、RegisterDoneEvent、
+ * ReadAnalogF64、StartTask、StopTask、ClearTask和GetExtendedErrorInfo。
+ *
+ * 每个运行中的任务有一个驱动线程，按采样率和绝对时间产生样本写入环形缓冲区，
+ * 每凑满N个样本在驱动线程上调用一次EveryNSamples回调，与真实驱动一样由回调中的ReadAnalogF64取数。
+ * 缓冲区大小按真实驱动的规则（采样率越高缓冲越大，且不小于CfgSampClkTiming给出的样本数）；
+ * 读取跟不上导致未读样本被覆盖时，任务停止并以-200279（SamplesNoLongerAvailable）调用Done回调。
+ *
+ * 波形默认每通道5V、10Hz正弦（通道间错开相位），可用setWaveform/setChannelWaveform设置，
+ * 或在创建第一个任务前设置环境变量ARTDAQ_SIM_WAVEFORM（格式见parseWaveform）。
+ */
+class ArtDAQSimulator
+{
+public:
+    /**
+     * @brief 波形形状
+     */
+    enum class Shape {
+        Sine,
+        Square,
+        Triangle,
+        Sawtooth,
+        Noise,
+        Constant
+    };
+
+    /**
+     * @brief 通道波形：offset + amplitude * shape(2π * frequency * t + phase) + 高斯噪声
+     */
+    struct Waveform {
+        Shape shape = Shape::Sine;
+        double amplitude = 5.0;      // 幅值（V）
+        double frequency = 10.0;     // 频率（Hz）
+        double offset = 0.0;         // 直流偏移（V）
+        double noise = 0.0;          // 高斯噪声标准差（V）
+    };
+
+    /**
+     * @brief 驱动统计（自上次重置以来，所有任务）
+     */
+    struct Statistics {
+        quint64 tasksStarted = 0;      // 启动的任务数
+        quint64 scans = 0;             // 产生的扫描数（每次扫描每个通道一个样本）
+        quint64 callbacks = 0;         // EveryNSamples回调次数
+        quint64 overruns = 0;          // 缓冲区溢出次数
+        double meanCallbackUs = 0.0;   // 回调平均耗时（微秒）
+        double maxCallbackUs = 0.0;    // 回调最大耗时（微秒）
+        double maxLatenessUs = 0.0;    // 回调相对第N个样本采集时刻的最大迟到（微秒）
+    };
+
+    /**
+     * @brief 设置所有通道的默认波形
+     */
+    static void setWaveform(const Waveform& waveform);
+
+    /**
+     * @brief 设置单个通道的波形（通道序号为任务中通道的顺序）
+     */
+    static void setChannelWaveform(int channelIndex, const Waveform& waveform);
+
+    /**
+     * @brief 清除单独设置的通道波形
+     */
+    static void clearChannelWaveforms();
+
+    /**
+     * @brief 通道实际使用的波形
+     */
+    static Waveform waveform(int channelIndex);
+
+    /**
+     * @brief 解析波形描述
+     * 格式为"形状[,幅值[,频率[,偏移[,噪声]]]]"，形状为sine/square/triangle/sawtooth/noise/constant，
+     * 例如"square,2.5,50"或"sine,5,10,0,0.01"
+     * @param text 波形描述
+     * @param waveform 解析结果（输出）
+     * @return 是否解析成功
+     */
+    static bool parseWaveform(const QString& text, Waveform& waveform);
+
+    static Statistics statistics();
+    static void resetStatistics();
+};
+
+} // namespace Simulation
+
+#endif // ARTDAQSIMULATOR_H
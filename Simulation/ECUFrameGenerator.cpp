@@ -0,0 +1,185 @@
+#include "ECUFrameGenerator.h"
+#include <QTimer>
+#include <QDebug>
+#include <QtMath>
+
+namespace Simulation {
+
+namespace {
+
+constexpr double FIELD_FREQUENCY_HZ = 0.5;   // 字段波形频率
+constexpr int MAX_BACKLOG_FRAMES = 2;        // 线路上最多排队的帧数，超过时跳过新帧
+
+// 按字段宽度和符号把值写入帧（补码，按字节序）
+void writeField(QByteArray &frame, const Core::ECUFieldConfig &field, qint64 value)
+{
+    const bool bigEndian = field.byteOrder.compare("big", Qt::CaseInsensitive) == 0;
+    const quint64 bits = static_cast<quint64>(value);
+    for (int i = 0; i < field.width; ++i) {
+        const int index = field.byteOffset + (bigEndian ? field.width - 1 - i : i);
+        frame[index] = static_cast<char>((bits >> (8 * i)) & 0xFF);
+    }
+}
+
+} // namespace
+
+ECUFrameGenerator::ECUFrameGenerator(const Core::ECUProtocolConfig& protocol, const Core::SerialConfig& config,
+                                     QObject *parent)
+    : QObject(parent)
+    , m_protocol(protocol)
+    , m_loopback(new SerialLoopback(config, this))
+    , m_timer(new QTimer(this))
+    , m_random(0x45435546u)
+    , m_frameRate(100.0)
+    , m_corruptionRate(0.0)
+    , m_scheduledFrames(0)
+{
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &ECUFrameGenerator::generate);
+}
+
+ECUFrameGenerator::~ECUFrameGenerator()
+{
+    stop();
+}
+
+bool ECUFrameGenerator::start()
+{
+    if (!m_loopback->open()) {
+        return false;
+    }
+
+    m_clock.start();
+    m_scheduledFrames = 0;
+    m_statistics = Statistics();
+    m_timer->start(qMax(1, qRound(1000.0 / m_frameRate)));
+
+    qDebug() << "[ECUFrameGenerator] ECU模拟帧发生器已启动，端口:" << portName()
+             << "帧长:" << m_protocol.frameSize << "字节"
+             << "帧率:" << m_frameRate << "帧/秒"
+             << "线路上限:" << maxFrameRate() << "帧/秒"
+             << "损坏比例:" << m_corruptionRate;
+    if (m_frameRate > maxFrameRate()) {
+        qDebug() << "[ECUFrameGenerator] 警告：帧率超过波特率能承载的上限，线路将饱和";
+    }
+    return true;
+}
+
+void ECUFrameGenerator::stop()
+{
+    m_timer->stop();
+    m_loopback->close();
+}
+
+void ECUFrameGenerator::setFrameRate(double framesPerSecond)
+{
+    m_frameRate = qMax(0.1, framesPerSecond);
+    if (m_timer->isActive()) {
+        m_clock.restart();
+        m_scheduledFrames = 0;
+        m_timer->start(qMax(1, qRound(1000.0 / m_frameRate)));
+    }
+}
+
+void ECUFrameGenerator::setCorruptionRate(double ratio)
+{
+    m_corruptionRate = qBound(0.0, ratio, 1.0);
+}
+
+double ECUFrameGenerator::maxFrameRate() const
+{
+    return 1e6 / (qMax(1, m_protocol.frameSize) * m_loopback->characterTimeUs());
+}
+
+ECUFrameGenerator::Statistics ECUFrameGenerator::takeStatistics()
+{
+    Statistics statistics = m_statistics;
+    statistics.line = m_loopback->takeStatistics();
+    m_statistics = Statistics();
+    return statistics;
+}
+
+void ECUFrameGenerator::generate()
+{
+    // 按绝对时间补齐到期的帧，定时器抖动不影响平均帧率
+    const double elapsed = m_clock.nsecsElapsed() / 1e9;
+    const quint64 dueFrames = static_cast<quint64>(elapsed * m_frameRate);
+
+    for (; m_scheduledFrames < dueFrames; ++m_scheduledFrames) {
+        if (m_loopback->queuedBytes() >= MAX_BACKLOG_FRAMES * m_protocol.frameSize) {
+            ++m_statistics.skippedFrames;
+            continue;
+        }
+
+        QByteArray frame = buildFrame(m_scheduledFrames / m_frameRate);
+        if (m_corruptionRate > 0.0 && m_random.generateDouble() < m_corruptionRate) {
+            corrupt(frame);
+            ++m_statistics.corruptedFrames;
+        }
+        m_loopback->write(frame);
+        ++m_statistics.frames;
+    }
+}
+
+QByteArray ECUFrameGenerator::buildFrame(double t)
+{
+    QByteArray frame(m_protocol.frameSize, '\0');
+    frame.replace(0, m_protocol.header.size(), m_protocol.header);
+
+    // 每个字段在其取值范围的10%~90%之间按正弦变化
+    for (int i = 0; i < m_protocol.fields.size(); ++i) {
+        const Core::ECUFieldConfig &field = m_protocol.fields[i];
+        if (field.width < 1 || field.width > 4 || field.byteOffset + field.width > frame.size()) {
+            continue;
+        }
+
+        const double span = std::ldexp(1.0, 8 * field.width);
+        const double minimum = field.isSigned ? -span / 2.0 : 0.0;
+        const double middle = minimum + span / 2.0;
+        const double value = middle + 0.4 * span * qSin(2.0 * M_PI * FIELD_FREQUENCY_HZ * t + i);
+        writeField(frame, field, static_cast<qint64>(std::floor(value)));
+    }
+
+    const int footerOffset = m_protocol.frameSize - m_protocol.footer.size();
+    frame.replace(footerOffset, m_protocol.footer.size(), m_protocol.footer);
+
+    if (m_protocol.checksumOffset >= 0 && m_protocol.checksumOffset < frame.size()) {
+        quint8 checksum = 0;
+        for (int i = m_protocol.checksumStart; i <= m_protocol.checksumEnd && i < frame.size(); ++i) {
+            checksum += static_cast<quint8>(frame[i]);
+        }
+        frame[m_protocol.checksumOffset] = static_cast<char>(checksum);
+    }
+    return frame;
+}
+
+void ECUFrameGenerator::corrupt(QByteArray &frame)
+{
+    const int payloadBegin = m_protocol.header.size();
+    const int payloadEnd = m_protocol.checksumOffset >= 0 ? m_protocol.checksumOffset
+                                                          : frame.size() - m_protocol.footer.size();
+
+    switch (m_random.bounded(3)) {
+        case 0:
+            // 改写一个数据字节：校验和错误
+            if (payloadEnd > payloadBegin) {
+                const int index = payloadBegin + static_cast<int>(m_random.bounded(payloadEnd - payloadBegin));
+                frame[index] = static_cast<char>(frame[index] ^ (1 + m_random.bounded(255)));
+                break;
+            }
+            Q_FALLTHROUGH();
+        case 1:
+            // 改写帧尾
+            if (!m_protocol.footer.isEmpty()) {
+                frame[frame.size() - 1] = static_cast<char>(frame[frame.size() - 1] ^ 0x5A);
+                break;
+            }
+            Q_FALLTHROUGH();
+        default:
+            // 截断帧：后一帧的帧头落在本帧的位置上
+            frame.chop(1 + static_cast<int>(m_random.bounded(qMax(1, frame.size() / 2))));
+            break;
+    }
+}
+
+} // namespace Simulation
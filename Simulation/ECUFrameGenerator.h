@@ -0,0 +1,99 @@
+#ifndef ECUFRAMEGENERATOR_H
+#define ECUFRAMEGENERATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include "SerialLoopback.h"
+#include "../Core/DataTypes.h"
+
+class QTimer;
+
+namespace Simulation {
+
+/**
+ * @brief 进程内ECU帧发生器
+ * 在模拟串口线路（SerialLoopback）上按配置的帧率持续发送ECU帧，帧格式由ECUProtocolConfig描述
+ * （默认17字节：帧头、各字段、累加校验和、帧尾），每个字段是一条相位不同的正弦波。
+ * 可按比例注入损坏帧（改写数据字节导致校验和错误、改写帧尾、截断帧），用于检验解析器的重新同步。
+ * 帧按绝对时间调度，帧率超过波特率能承载的上限时线路饱和，多出的帧被跳过并计数。
+ */
+class ECUFrameGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 发生器统计（自上次取出以来）
+     */
+    struct Statistics {
+        quint64 frames = 0;           // 发送的帧数（含损坏帧）
+        quint64 corruptedFrames = 0;  // 注入的损坏帧
+        quint64 skippedFrames = 0;    // 线路饱和跳过的帧
+        SerialLoopback::Statistics line; // 线路统计
+    };
+
+    ECUFrameGenerator(const Core::ECUProtocolConfig& protocol, const Core::SerialConfig& config,
+                      QObject *parent = nullptr);
+    ~ECUFrameGenerator() override;
+
+    /**
+     * @brief 创建模拟串口线路并开始发送
+     * @return 是否成功
+     */
+    bool start();
+
+    /**
+     * @brief 停止发送并关闭线路
+     */
+    void stop();
+
+    /**
+     * @brief 设备一侧打开的端口名
+     */
+    QString portName() const { return m_loopback->portName(); }
+
+    /**
+     * @brief 设置帧率
+     * @param framesPerSecond 每秒帧数
+     */
+    void setFrameRate(double framesPerSecond);
+
+    /**
+     * @brief 设置损坏帧比例
+     * @param ratio 0~1
+     */
+    void setCorruptionRate(double ratio);
+
+    /**
+     * @brief 波特率能承载的最大帧率
+     */
+    double maxFrameRate() const;
+
+    /**
+     * @brief 取出并清零统计
+     */
+    Statistics takeStatistics();
+
+private slots:
+    void generate();
+
+private:
+    QByteArray buildFrame(double t);
+    void corrupt(QByteArray &frame);
+
+    Core::ECUProtocolConfig m_protocol;
+    SerialLoopback *m_loopback;
+    QTimer *m_timer;
+    QElapsedTimer m_clock;               // 帧调度时间基准
+    QRandomGenerator m_random;
+    double m_frameRate;
+    double m_corruptionRate;
+    quint64 m_scheduledFrames;           // 自开始以来已调度的帧数
+    Statistics m_statistics;
+};
+
+} // namespace Simulation
+
+#endif // ECUFRAMEGENERATOR_H
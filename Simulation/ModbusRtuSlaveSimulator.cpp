@@ -0,0 +1,151 @@
+#include "ModbusRtuSlaveSimulator.h"
+#include <QTimer>
+#include <QDebug>
+
+namespace Simulation {
+
+namespace {
+
+constexpr int READ_REQUEST_SIZE = 8;      // 从站ID(1) + 功能码(1) + 地址(2) + 数量(2) + CRC(2)
+constexpr int WRITE_MULTIPLE_HEADER = 7;  // 从站ID + 功能码 + 地址 + 数量 + 字节数
+
+// 请求帧长度，帧长还不能确定时返回0，未知功能码返回-1
+int requestLength(const QByteArray &buffer)
+{
+    const quint8 functionCode = static_cast<quint8>(buffer[1]);
+    if (functionCode >= 1 && functionCode <= 6) {
+        return READ_REQUEST_SIZE;
+    }
+    if (functionCode == 15 || functionCode == 16) {
+        if (buffer.size() < WRITE_MULTIPLE_HEADER) {
+            return 0;
+        }
+        return WRITE_MULTIPLE_HEADER + static_cast<quint8>(buffer[6]) + 2;
+    }
+    return -1;
+}
+
+} // namespace
+
+ModbusRtuSlaveSimulator::ModbusRtuSlaveSimulator(const Core::SerialConfig& config, QObject *parent)
+    : QObject(parent)
+    , m_loopback(new SerialLoopback(config, this))
+    , m_responseDelayMs(0)
+{
+    connect(m_loopback, &SerialLoopback::dataReceived, this, &ModbusRtuSlaveSimulator::onDataReceived);
+}
+
+ModbusRtuSlaveSimulator::~ModbusRtuSlaveSimulator()
+{
+    close();
+}
+
+bool ModbusRtuSlaveSimulator::open()
+{
+    m_buffer.clear();
+    if (!m_loopback->open()) {
+        return false;
+    }
+
+    qDebug() << "[ModbusRtuSlaveSimulator] Modbus RTU模拟从站已启动，端口:" << portName()
+             << "从站:" << (m_slaveIds.isEmpty() ? QString("全部") : QString::number(m_slaveIds.size()) + "个")
+             << "应答延迟:" << m_responseDelayMs << "毫秒";
+    return true;
+}
+
+void ModbusRtuSlaveSimulator::close()
+{
+    m_loopback->close();
+    m_buffer.clear();
+}
+
+void ModbusRtuSlaveSimulator::setSlaveIds(const QSet<int> &slaveIds)
+{
+    m_slaveIds = slaveIds;
+}
+
+void ModbusRtuSlaveSimulator::setResponseDelayMs(int delayMs)
+{
+    m_responseDelayMs = qMax(0, delayMs);
+}
+
+void ModbusRtuSlaveSimulator::setRegister(int slaveId, int address, quint16 value)
+{
+    m_model.setRegister(slaveId, address, value);
+}
+
+ModbusRtuSlaveSimulator::Statistics ModbusRtuSlaveSimulator::takeStatistics()
+{
+    Statistics statistics = m_statistics;
+    statistics.line = m_loopback->takeStatistics();
+    m_statistics = Statistics();
+    return statistics;
+}
+
+quint16 ModbusRtuSlaveSimulator::crc16(const char *data, int size)
+{
+    quint16 crc = 0xFFFF;
+    for (int i = 0; i < size; ++i) {
+        crc ^= static_cast<quint8>(data[i]);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x0001) ? static_cast<quint16>((crc >> 1) ^ 0xA001) : static_cast<quint16>(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+void ModbusRtuSlaveSimulator::onDataReceived(const QByteArray &data)
+{
+    m_buffer.append(data);
+
+    while (m_buffer.size() >= 2) {
+        const int length = requestLength(m_buffer);
+        if (length == 0 || (length > 0 && m_buffer.size() < length)) {
+            break;
+        }
+
+        // 未知功能码或CRC错误：丢弃一个字节后重新同步
+        const quint16 crc = length > 0
+                                ? static_cast<quint16>(static_cast<quint8>(m_buffer[length - 2])
+                                                       | (static_cast<quint8>(m_buffer[length - 1]) << 8))
+                                : 0;
+        if (length < 0 || crc16(m_buffer.constData(), length - 2) != crc) {
+            m_buffer.remove(0, 1);
+            ++m_statistics.crcErrors;
+            continue;
+        }
+
+        const quint8 slaveId = static_cast<quint8>(m_buffer[0]);
+        const QByteArray pdu = m_buffer.mid(1, length - 3);
+        m_buffer.remove(0, length);
+
+        // 广播和未配置的从站不应答
+        if (slaveId == 0 || (!m_slaveIds.isEmpty() && !m_slaveIds.contains(slaveId))) {
+            ++m_statistics.ignored;
+            continue;
+        }
+
+        ++m_statistics.requests;
+        respond(slaveId, m_model.handlePdu(slaveId, pdu));
+    }
+}
+
+void ModbusRtuSlaveSimulator::respond(quint8 slaveId, const QByteArray &pdu)
+{
+    QByteArray response;
+    response.append(static_cast<char>(slaveId));
+    response.append(pdu);
+    const quint16 crc = crc16(response.constData(), response.size());
+    response.append(static_cast<char>(crc & 0xFF));
+    response.append(static_cast<char>(crc >> 8));
+
+    if (m_responseDelayMs > 0) {
+        QTimer::singleShot(m_responseDelayMs, this, [this, response]() {
+            m_loopback->write(response);
+        });
+    } else {
+        m_loopback->write(response);
+    }
+}
+
+} // namespace Simulation
@@ -0,0 +1,98 @@
+#ifndef MODBUSRTUSLAVESIMULATOR_H
+#define MODBUSRTUSLAVESIMULATOR_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QSet>
+#include "ModbusSlaveModel.h"
+#include "SerialLoopback.h"
+
+namespace Simulation {
+
+/**
+ * @brief 进程内Modbus RTU从站模拟
+ * 在模拟串口线路（SerialLoopback）上应答ModbusDevice的读请求：按RTU帧格式（从站ID + PDU + CRC16）
+ * 解析请求，CRC错误的字节丢弃后重新同步，未配置的从站不应答（与真实总线一样由客户端超时）。
+ * 寄存器表与Modbus TCP模拟服务器相同，可设置固定值和应答延迟；应答按波特率逐字节送出，
+ * 总线占用率可从线路统计中读取。
+ */
+class ModbusRtuSlaveSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 从站统计（自上次取出以来）
+     */
+    struct Statistics {
+        quint64 requests = 0;         // 收到的有效请求
+        quint64 crcErrors = 0;        // CRC错误（丢弃的字节数）
+        quint64 ignored = 0;          // 发给未配置从站的请求
+        SerialLoopback::Statistics line; // 线路统计
+    };
+
+    explicit ModbusRtuSlaveSimulator(const Core::SerialConfig& config, QObject *parent = nullptr);
+    ~ModbusRtuSlaveSimulator() override;
+
+    /**
+     * @brief 创建模拟串口线路
+     * @return 是否成功
+     */
+    bool open();
+
+    /**
+     * @brief 关闭线路
+     */
+    void close();
+
+    /**
+     * @brief 设备一侧打开的端口名
+     */
+    QString portName() const { return m_loopback->portName(); }
+
+    /**
+     * @brief 设置应答的从站ID（为空时应答所有从站）
+     */
+    void setSlaveIds(const QSet<int> &slaveIds);
+
+    /**
+     * @brief 设置应答延迟（收到完整请求到开始发送应答）
+     * @param delayMs 延迟（毫秒）
+     */
+    void setResponseDelayMs(int delayMs);
+
+    /**
+     * @brief 设置寄存器的固定值
+     * @param slaveId 从站ID
+     * @param address 寄存器地址
+     * @param value 值
+     */
+    void setRegister(int slaveId, int address, quint16 value);
+
+    /**
+     * @brief 取出并清零统计
+     */
+    Statistics takeStatistics();
+
+    /**
+     * @brief Modbus RTU CRC16（多项式0xA001，初值0xFFFF）
+     */
+    static quint16 crc16(const char *data, int size);
+
+private slots:
+    void onDataReceived(const QByteArray &data);
+
+private:
+    void respond(quint8 slaveId, const QByteArray &pdu);
+
+    SerialLoopback *m_loopback;
+    ModbusSlaveModel m_model;
+    QSet<int> m_slaveIds;
+    QByteArray m_buffer;              // 未处理完的请求字节
+    int m_responseDelayMs;
+    Statistics m_statistics;
+};
+
+} // namespace Simulation
+
+#endif // MODBUSRTUSLAVESIMULATOR_H
@@ -0,0 +1,93 @@
+#include "ModbusSlaveModel.h"
+#include <QtEndian>
+#include <QtMath>
+
+namespace Simulation {
+
+namespace {
+
+constexpr int MAX_READ_REGISTERS = 125;
+constexpr int MAX_READ_BITS = 2000;
+
+} // namespace
+
+ModbusSlaveModel::ModbusSlaveModel()
+{
+    m_clock.start();
+}
+
+void ModbusSlaveModel::setRegister(int unitId, int address, quint16 value)
+{
+    m_registers[(static_cast<quint32>(unitId & 0xFF) << 16) | (address & 0xFFFF)] = value;
+}
+
+QByteArray ModbusSlaveModel::handlePdu(quint8 unitId, const QByteArray &pdu) const
+{
+    if (pdu.size() < 5) {
+        return exceptionPdu(pdu.isEmpty() ? 0 : static_cast<quint8>(pdu[0]), 0x03);
+    }
+
+    const uchar *data = reinterpret_cast<const uchar *>(pdu.constData());
+    const quint8 functionCode = data[0];
+    const quint16 startAddress = qFromBigEndian<quint16>(data + 1);
+    const quint16 count = qFromBigEndian<quint16>(data + 3);
+
+    QByteArray response;
+    response.append(static_cast<char>(functionCode));
+
+    switch (functionCode) {
+        case 1:
+        case 2: {
+            if (count == 0 || count > MAX_READ_BITS) {
+                return exceptionPdu(functionCode, 0x03);
+            }
+            QByteArray bits((count + 7) / 8, '\0');
+            for (int i = 0; i < count; ++i) {
+                if (registerValue(unitId, startAddress + i) & 0x1) {
+                    bits[i / 8] = static_cast<char>(bits[i / 8] | (1 << (i % 8)));
+                }
+            }
+            response.append(static_cast<char>(bits.size()));
+            response.append(bits);
+            return response;
+        }
+        case 3:
+        case 4: {
+            if (count == 0 || count > MAX_READ_REGISTERS) {
+                return exceptionPdu(functionCode, 0x03);
+            }
+            response.append(static_cast<char>(count * 2));
+            for (int i = 0; i < count; ++i) {
+                const quint16 value = registerValue(unitId, startAddress + i);
+                response.append(static_cast<char>(value >> 8));
+                response.append(static_cast<char>(value & 0xFF));
+            }
+            return response;
+        }
+        default:
+            return exceptionPdu(functionCode, 0x01);
+    }
+}
+
+quint16 ModbusSlaveModel::registerValue(int unitId, int address) const
+{
+    auto it = m_registers.constFind((static_cast<quint32>(unitId & 0xFF) << 16) | (address & 0xFFFF));
+    if (it != m_registers.constEnd()) {
+        return it.value();
+    }
+
+    // 每个寄存器一条相位不同的正弦波，范围0~2000
+    const double t = m_clock.elapsed() / 1000.0;
+    const double phase = address * 0.7 + unitId * 1.3;
+    return static_cast<quint16>(1000.0 + 1000.0 * std::sin(2.0 * M_PI * 0.2 * t + phase));
+}
+
+QByteArray ModbusSlaveModel::exceptionPdu(quint8 functionCode, quint8 exceptionCode)
+{
+    QByteArray pdu;
+    pdu.append(static_cast<char>(functionCode | 0x80));
+    pdu.append(static_cast<char>(exceptionCode));
+    return pdu;
+}
+
+} // namespace Simulation
@@ -0,0 +1,50 @@
+#ifndef MODBUSSLAVEMODEL_H
+#define MODBUSSLAVEMODEL_H
+
+#include <QHash>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+namespace Simulation {
+
+/**
+ * @brief 模拟Modbus从站的寄存器表和请求处理
+ * Modbus TCP服务器模拟和RTU从站模拟共用：按PDU处理功能码1/2/3/4读请求，
+ * 未显式设置的寄存器返回随时间变化的正弦波。
+ */
+class ModbusSlaveModel
+{
+public:
+    ModbusSlaveModel();
+
+    /**
+     * @brief 设置寄存器的固定值
+     * @param unitId 单元号（从站ID）
+     * @param address 寄存器地址
+     * @param value 值
+     */
+    void setRegister(int unitId, int address, quint16 value);
+
+    /**
+     * @brief 处理一个请求PDU
+     * @param unitId 单元号（从站ID）
+     * @param pdu 请求PDU（功能码 + 数据）
+     * @return 应答PDU（正常应答或异常应答）
+     */
+    QByteArray handlePdu(quint8 unitId, const QByteArray &pdu) const;
+
+    /**
+     * @brief 寄存器当前值
+     */
+    quint16 registerValue(int unitId, int address) const;
+
+    static QByteArray exceptionPdu(quint8 functionCode, quint8 exceptionCode);
+
+private:
+    QHash<quint32, quint16> m_registers;         // (单元号 << 16 | 地址) -> 固定值
+    QElapsedTimer m_clock;                       // 波形时间基准
+};
+
+} // namespace Simulation
+
+#endif // MODBUSSLAVEMODEL_H
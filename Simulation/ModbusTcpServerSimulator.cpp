@@ -0,0 +1,139 @@
+#include "ModbusTcpServerSimulator.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtEndian>
+#include <QDebug>
+#include <utility>
+
+namespace Simulation {
+
+namespace {
+
+constexpr int MBAP_HEADER_SIZE = 7;      // 事务号(2) + 协议号(2) + 长度(2) + 单元号(1)
+
+} // namespace
+
+ModbusTcpServerSimulator::ModbusTcpServerSimulator(QObject *parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this))
+    , m_responseDelayMs(0)
+    , m_requestCount(0)
+{
+    connect(m_server, &QTcpServer::newConnection, this, &ModbusTcpServerSimulator::onNewConnection);
+}
+
+ModbusTcpServerSimulator::~ModbusTcpServerSimulator()
+{
+    close();
+}
+
+bool ModbusTcpServerSimulator::listen(const QHostAddress &address, quint16 port)
+{
+    if (!m_server->listen(address, port)) {
+        qDebug() << "Modbus TCP模拟服务器监听失败:" << m_server->errorString();
+        return false;
+    }
+
+    qDebug() << "Modbus TCP模拟服务器已启动，地址:" << m_server->serverAddress().toString()
+             << "端口:" << m_server->serverPort();
+    return true;
+}
+
+void ModbusTcpServerSimulator::close()
+{
+    m_server->close();
+
+    // 没有待发数据时disconnectFromHost会同步发出disconnected，先取出连接表并断开信号，避免遍历时被修改
+    const QHash<QTcpSocket *, QByteArray> buffers = std::exchange(m_buffers, {});
+    for (auto it = buffers.constBegin(); it != buffers.constEnd(); ++it) {
+        QTcpSocket *socket = it.key();
+        disconnect(socket, nullptr, this, nullptr);
+        socket->disconnectFromHost();
+        socket->deleteLater();
+    }
+}
+
+quint16 ModbusTcpServerSimulator::serverPort() const
+{
+    return m_server->serverPort();
+}
+
+void ModbusTcpServerSimulator::setResponseDelayMs(int delayMs)
+{
+    m_responseDelayMs = qMax(0, delayMs);
+}
+
+void ModbusTcpServerSimulator::setRegister(int unitId, int address, quint16 value)
+{
+    m_model.setRegister(unitId, address, value);
+}
+
+void ModbusTcpServerSimulator::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        m_buffers.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this, &ModbusTcpServerSimulator::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void ModbusTcpServerSimulator::onReadyRead()
+{
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    if (!socket || !m_buffers.contains(socket)) {
+        return;
+    }
+
+    QByteArray &buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    // 一次可能收到多个流水线请求，逐个按MBAP长度切分
+    while (buffer.size() >= MBAP_HEADER_SIZE) {
+        const uchar *data = reinterpret_cast<const uchar *>(buffer.constData());
+        const quint16 transactionId = qFromBigEndian<quint16>(data);
+        const quint16 protocolId = qFromBigEndian<quint16>(data + 2);
+        const quint16 length = qFromBigEndian<quint16>(data + 4);
+        const quint8 unitId = data[6];
+
+        if (protocolId != 0 || length < 2) {
+            qDebug() << "Modbus TCP模拟服务器收到无效报文，断开连接";
+            buffer.clear();
+            socket->disconnectFromHost();
+            return;
+        }
+
+        const int frameSize = 6 + length;
+        if (buffer.size() < frameSize) {
+            break;
+        }
+
+        const QByteArray pdu = buffer.mid(MBAP_HEADER_SIZE, length - 1);
+        buffer.remove(0, frameSize);
+        ++m_requestCount;
+
+        const QByteArray responsePdu = m_model.handlePdu(unitId, pdu);
+
+        QByteArray response(MBAP_HEADER_SIZE, '\0');
+        uchar *header = reinterpret_cast<uchar *>(response.data());
+        qToBigEndian<quint16>(transactionId, header);
+        qToBigEndian<quint16>(0, header + 2);
+        qToBigEndian<quint16>(static_cast<quint16>(responsePdu.size() + 1), header + 4);
+        header[6] = unitId;
+        response.append(responsePdu);
+
+        if (m_responseDelayMs > 0) {
+            // 以socket为上下文，连接断开后不会再写入
+            QTimer::singleShot(m_responseDelayMs, socket, [socket, response]() {
+                socket->write(response);
+            });
+        } else {
+            socket->write(response);
+        }
+    }
+}
+
+} // namespace Simulation
@@ -0,0 +1,80 @@
+#ifndef MODBUSTCPSERVERSIMULATOR_H
+#define MODBUSTCPSERVERSIMULATOR_H
+
+#include <QObject>
+#include <QHash>
+#include <QByteArray>
+#include <QHostAddress>
+#include "ModbusSlaveModel.h"
+
+class QTcpServer;
+class QTcpSocket;
+
+namespace Simulation {
+
+/**
+ * @brief 进程内Modbus TCP服务器模拟
+ * 用于在没有PLC或传感器的环境中调试ModbusTcpDevice和运行基准测试：
+ * 在本地端口上监听，按MBAP报文头解析请求，响应任意单元号的功能码1/2/3/4读请求。
+ * 未显式设置的寄存器返回随时间变化的正弦波，可以设置固定的应答延迟模拟慢速设备。
+ */
+class ModbusTcpServerSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ModbusTcpServerSimulator(QObject *parent = nullptr);
+    ~ModbusTcpServerSimulator() override;
+
+    /**
+     * @brief 开始监听
+     * @param address 监听地址
+     * @param port 端口（0表示由系统分配）
+     * @return 是否成功
+     */
+    bool listen(const QHostAddress &address = QHostAddress::LocalHost, quint16 port = 0);
+
+    /**
+     * @brief 停止监听并断开所有连接
+     */
+    void close();
+
+    /**
+     * @brief 实际监听的端口
+     */
+    quint16 serverPort() const;
+
+    /**
+     * @brief 设置应答延迟
+     * @param delayMs 延迟（毫秒）
+     */
+    void setResponseDelayMs(int delayMs);
+
+    /**
+     * @brief 设置寄存器的固定值
+     * @param unitId 单元号（从站ID）
+     * @param address 寄存器地址
+     * @param value 值
+     */
+    void setRegister(int unitId, int address, quint16 value);
+
+    /**
+     * @brief 已处理的请求数
+     */
+    quint64 requestCount() const { return m_requestCount; }
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+private:
+    QTcpServer *m_server;
+    QHash<QTcpSocket *, QByteArray> m_buffers;   // 每个连接未处理完的数据
+    ModbusSlaveModel m_model;                    // 寄存器表和请求处理
+    int m_responseDelayMs;
+    quint64 m_requestCount;
+};
+
+} // namespace Simulation
+
+#endif // MODBUSTCPSERVERSIMULATOR_H
@@ -0,0 +1,229 @@
+#include "SerialLoopback.h"
+#include <QSocketNotifier>
+#include <QTimer>
+#include <QDebug>
+#include <QtMath>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+namespace Simulation {
+
+namespace {
+
+constexpr int READ_CHUNK_SIZE = 4096;
+
+} // namespace
+
+SerialLoopback::SerialLoopback(const Core::SerialConfig& config, QObject *parent)
+    : QObject(parent)
+    , m_characterTimeNs(config.characterTimeUs() * 1000.0)
+    , m_masterFd(-1)
+    , m_slaveFd(-1)
+    , m_notifier(nullptr)
+    , m_txTimer(new QTimer(this))
+    , m_rxTimer(new QTimer(this))
+    , m_txNextByteNs(0)
+    , m_rxLineFreeNs(0)
+    , m_statisticsStartNs(0)
+{
+    m_clock.start();
+
+    m_txTimer->setSingleShot(true);
+    m_txTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_txTimer, &QTimer::timeout, this, &SerialLoopback::transmit);
+
+    m_rxTimer->setSingleShot(true);
+    m_rxTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_rxTimer, &QTimer::timeout, this, &SerialLoopback::deliver);
+}
+
+SerialLoopback::~SerialLoopback()
+{
+    close();
+}
+
+bool SerialLoopback::open()
+{
+    if (isOpen()) {
+        return true;
+    }
+
+#ifdef Q_OS_UNIX
+    const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0) {
+        qDebug() << "[SerialLoopback] 创建伪终端失败:" << std::strerror(errno);
+        if (master >= 0) {
+            ::close(master);
+        }
+        return false;
+    }
+
+    const QString portName = QString::fromLocal8Bit(::ptsname(master));
+    const int slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0) {
+        qDebug() << "[SerialLoopback] 打开伪终端从设备失败:" << portName << std::strerror(errno);
+        ::close(master);
+        return false;
+    }
+
+    // 原始模式：不回显、不转换回车换行，二进制帧原样传输
+    termios options;
+    if (::tcgetattr(slave, &options) == 0) {
+        ::cfmakeraw(&options);
+        ::tcsetattr(slave, TCSANOW, &options);
+    }
+    ::fcntl(master, F_SETFL, ::fcntl(master, F_GETFL) | O_NONBLOCK);
+
+    m_masterFd = master;
+    m_slaveFd = slave;
+    m_portName = portName;
+    m_txQueue.clear();
+    m_rxQueue.clear();
+    m_txNextByteNs = 0;
+    m_rxLineFreeNs = 0;
+    m_statistics = Statistics();
+    m_statisticsStartNs = nowNs();
+
+    m_notifier = new QSocketNotifier(m_masterFd, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &SerialLoopback::onReadable);
+
+    qDebug() << "[SerialLoopback] 模拟串口已创建:" << m_portName
+             << "字符时间:" << characterTimeUs() << "微秒";
+    return true;
+#else
+    qDebug() << "[SerialLoopback] 当前平台不支持模拟串口（需要伪终端），请使用虚拟串口对";
+    return false;
+#endif
+}
+
+void SerialLoopback::close()
+{
+    m_txTimer->stop();
+    m_rxTimer->stop();
+    m_txQueue.clear();
+    m_rxQueue.clear();
+
+    delete m_notifier;
+    m_notifier = nullptr;
+
+#ifdef Q_OS_UNIX
+    if (m_slaveFd >= 0) {
+        ::close(m_slaveFd);
+    }
+    if (m_masterFd >= 0) {
+        ::close(m_masterFd);
+    }
+#endif
+    m_slaveFd = -1;
+    m_masterFd = -1;
+    m_portName.clear();
+}
+
+void SerialLoopback::write(const QByteArray &data)
+{
+    if (!isOpen() || data.isEmpty()) {
+        return;
+    }
+
+    // 线路空闲时从现在开始发送，否则接在上一个字节之后
+    if (m_txQueue.isEmpty()) {
+        m_txNextByteNs = qMax(m_txNextByteNs, nowNs() + static_cast<qint64>(m_characterTimeNs));
+        scheduleTimer(m_txTimer, m_txNextByteNs);
+    }
+    m_txQueue.append(data);
+}
+
+void SerialLoopback::transmit()
+{
+    const qint64 now = nowNs();
+
+    // 送出到目前为止已经传完的字节
+    int count = 0;
+    while (count < m_txQueue.size() && m_txNextByteNs <= now) {
+        ++count;
+        m_txNextByteNs += static_cast<qint64>(m_characterTimeNs);
+    }
+
+    if (count > 0) {
+#ifdef Q_OS_UNIX
+        // 设备没有及时读取时内核缓冲区满，与真实串口的接收溢出一样丢弃
+        const qint64 written = ::write(m_masterFd, m_txQueue.constData(), count);
+        if (written < count) {
+            m_statistics.bytesDropped += static_cast<quint64>(count - qMax<qint64>(0, written));
+        }
+#endif
+        m_statistics.bytesSent += static_cast<quint64>(count);
+        m_txQueue.remove(0, count);
+    }
+
+    if (!m_txQueue.isEmpty()) {
+        scheduleTimer(m_txTimer, m_txNextByteNs);
+    }
+}
+
+void SerialLoopback::onReadable()
+{
+#ifdef Q_OS_UNIX
+    QByteArray data;
+    char chunk[READ_CHUNK_SIZE];
+    qint64 count = 0;
+    while ((count = ::read(m_masterFd, chunk, sizeof(chunk))) > 0) {
+        data.append(chunk, static_cast<int>(count));
+    }
+
+    if (data.isEmpty()) {
+        return;
+    }
+
+    // 设备写入伪终端是瞬时的，按字符时间推算最后一个字节在线路上传完的时刻
+    const qint64 now = nowNs();
+    m_rxLineFreeNs = qMax(now, m_rxLineFreeNs) + static_cast<qint64>(data.size() * m_characterTimeNs);
+    m_rxQueue.enqueue(qMakePair(m_rxLineFreeNs, data));
+    m_statistics.bytesReceived += static_cast<quint64>(data.size());
+
+    if (!m_rxTimer->isActive()) {
+        scheduleTimer(m_rxTimer, m_rxQueue.head().first);
+    }
+#endif
+}
+
+void SerialLoopback::deliver()
+{
+    const qint64 now = nowNs();
+    while (!m_rxQueue.isEmpty() && m_rxQueue.head().first <= now) {
+        emit dataReceived(m_rxQueue.dequeue().second);
+    }
+
+    if (!m_rxQueue.isEmpty()) {
+        scheduleTimer(m_rxTimer, m_rxQueue.head().first);
+    }
+}
+
+void SerialLoopback::scheduleTimer(QTimer *timer, qint64 dueNs)
+{
+    const qint64 delayNs = dueNs - nowNs();
+    timer->start(delayNs > 0 ? static_cast<int>((delayNs + 999999) / 1000000) : 0);
+}
+
+SerialLoopback::Statistics SerialLoopback::takeStatistics()
+{
+    const qint64 now = nowNs();
+    const double elapsedNs = qMax<qint64>(1, now - m_statisticsStartNs);
+
+    Statistics statistics = m_statistics;
+    statistics.txUtilization = qMin(1.0, statistics.bytesSent * m_characterTimeNs / elapsedNs);
+    statistics.rxUtilization = qMin(1.0, statistics.bytesReceived * m_characterTimeNs / elapsedNs);
+
+    m_statistics = Statistics();
+    m_statisticsStartNs = now;
+    return statistics;
+}
+
+} // namespace Simulation
@@ -0,0 +1,116 @@
+#ifndef SERIALLOOPBACK_H
+#define SERIALLOOPBACK_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QQueue>
+#include <QPair>
+#include "../Core/DataTypes.h"
+
+class QSocketNotifier;
+class QTimer;
+
+namespace Simulation {
+
+/**
+ * @brief 进程内模拟串口线路
+ * 用伪终端对（Linux/Unix）代替一对交叉连接的串口：设备一侧照常用QSerialPort或
+ * QModbusRtuSerialClient打开portName()，模拟对端（ECU帧发生器、RTU从站）通过本类收发。
+ * 伪终端本身没有波特率，两个方向都按串口配置的字符时间排队：
+ * write()的数据逐字节按线路速率送出，设备发来的数据在最后一个字节传完的时刻交付。
+ * Windows上没有伪终端，open()失败（可用com0com等虚拟串口对代替）。
+ */
+class SerialLoopback : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 线路统计（自上次取出以来）
+     */
+    struct Statistics {
+        quint64 bytesSent = 0;        // 对端发出的字节数
+        quint64 bytesReceived = 0;    // 对端收到的字节数
+        quint64 bytesDropped = 0;     // 设备未及时读取而丢弃的字节数
+        double txUtilization = 0.0;   // 对端发送方向线路占用率（0~1）
+        double rxUtilization = 0.0;   // 设备发送方向线路占用率（0~1）
+    };
+
+    explicit SerialLoopback(const Core::SerialConfig& config, QObject *parent = nullptr);
+    ~SerialLoopback() override;
+
+    /**
+     * @brief 创建伪终端对
+     * @return 是否成功
+     */
+    bool open();
+
+    /**
+     * @brief 关闭伪终端并丢弃未发送的数据
+     */
+    void close();
+
+    bool isOpen() const { return m_masterFd >= 0; }
+
+    /**
+     * @brief 设备一侧打开的端口名（例如/dev/pts/3）
+     */
+    QString portName() const { return m_portName; }
+
+    /**
+     * @brief 一个字符的传输时间（微秒）
+     */
+    double characterTimeUs() const { return m_characterTimeNs / 1000.0; }
+
+    /**
+     * @brief 对端发送数据，按线路速率排队
+     */
+    void write(const QByteArray &data);
+
+    /**
+     * @brief 尚未送出的字节数
+     */
+    qint64 queuedBytes() const { return m_txQueue.size(); }
+
+    /**
+     * @brief 取出并清零线路统计
+     */
+    Statistics takeStatistics();
+
+signals:
+    /**
+     * @brief 收到设备发来的数据（在最后一个字节按线路速率传完时发出）
+     */
+    void dataReceived(const QByteArray &data);
+
+private slots:
+    void onReadable();
+    void transmit();
+    void deliver();
+
+private:
+    qint64 nowNs() const { return m_clock.nsecsElapsed(); }
+    void scheduleTimer(QTimer *timer, qint64 dueNs);
+
+    double m_characterTimeNs;                   // 字符时间（纳秒）
+    int m_masterFd;                             // 对端使用的伪终端主设备
+    int m_slaveFd;                              // 保持从设备打开：设备关闭端口时主设备不会读到EIO
+    QString m_portName;
+    QSocketNotifier *m_notifier;
+    QTimer *m_txTimer;
+    QTimer *m_rxTimer;
+    QElapsedTimer m_clock;
+
+    QByteArray m_txQueue;                       // 待发送数据
+    qint64 m_txNextByteNs;                      // 下一个字节传完的时刻
+    QQueue<QPair<qint64, QByteArray>> m_rxQueue; // (传完时刻, 数据)
+    qint64 m_rxLineFreeNs;                      // 设备发送方向线路空闲的时刻
+
+    Statistics m_statistics;
+    qint64 m_statisticsStartNs;
+};
+
+} // namespace Simulation
+
+#endif // SERIALLOOPBACK_H
@@ -0,0 +1,200 @@
+/**
+ * @brief 仪表墙基准测试
+ * 在100个仪表的网格上比较两种绘制方式的每帧耗时和paint事件数：
+ *   1. 每个仪表一个控件（Dashboard + ColumnarInstrument，放在QGridLayout中）
+ *   2. 所有仪表绘制在同一个InstrumentWall上
+ * 每帧给所有仪表设置新值后处理事件循环直到绘制完成。
+ * 默认使用offscreen平台，可在无显示器的环境中运行。
+ *
+ * 用法: InstrumentWallBenchmark [仪表数量=100] [帧数=300]
+ */
+#include <QApplication>
+#include <QWidget>
+#include <QGridLayout>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QVector>
+#include <QEvent>
+#include <QTextStream>
+#include <algorithm>
+#include <functional>
+#include "../plot/dashboard.h"
+#include "../plot/columnarinstrument.h"
+#include "../plot/instrumentwall.h"
+
+namespace {
+
+constexpr int COLUMNS = 10;
+constexpr int WINDOW_WIDTH = 1600;
+constexpr int WINDOW_HEIGHT = 1000;
+
+// 统计paint事件数
+class PaintCounter : public QObject
+{
+public:
+    int count = 0;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::Paint) {
+            ++count;
+        }
+        return QObject::eventFilter(watched, event);
+    }
+};
+
+struct Result {
+    double averageMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double paintsPerFrame = 0.0;
+};
+
+// 处理事件循环直到所有待绘制的区域都已绘制
+void flushPaints()
+{
+    QCoreApplication::sendPostedEvents();
+    QCoreApplication::processEvents(QEventLoop::AllEvents);
+}
+
+Result runFrames(int frames, PaintCounter &counter, const std::function<void(int)> &setValues)
+{
+    // 预热：建立静态缓存
+    setValues(-1);
+    flushPaints();
+    counter.count = 0;
+
+    QVector<double> frameMs;
+    frameMs.reserve(frames);
+
+    for (int frame = 0; frame < frames; ++frame) {
+        QElapsedTimer timer;
+        timer.start();
+        setValues(frame);
+        flushPaints();
+        frameMs.append(timer.nsecsElapsed() / 1e6);
+    }
+
+    Result result;
+    std::sort(frameMs.begin(), frameMs.end());
+    double sum = 0.0;
+    for (double ms : frameMs) {
+        sum += ms;
+    }
+    const int count = static_cast<int>(frameMs.size());
+    result.averageMs = sum / count;
+    result.p50Ms = frameMs[count / 2];
+    result.p99Ms = frameMs[qMin(count - 1, static_cast<int>(count * 0.99))];
+    result.paintsPerFrame = static_cast<double>(counter.count) / frames;
+    return result;
+}
+
+void printResult(QTextStream &out, const QString &name, const Result &result)
+{
+    out << qSetFieldWidth(24) << Qt::left << name << qSetFieldWidth(0)
+        << " 平均 " << QString::number(result.averageMs, 'f', 3) << " ms"
+        << "  P50 " << QString::number(result.p50Ms, 'f', 3) << " ms"
+        << "  P99 " << QString::number(result.p99Ms, 'f', 3) << " ms"
+        << "  paint事件/帧 " << QString::number(result.paintsPerFrame, 'f', 1) << Qt::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+
+    const int instrumentCount = argc > 1 ? qMax(1, QString(argv[1]).toInt()) : 100;
+    const int frames = argc > 2 ? qMax(1, QString(argv[2]).toInt()) : 300;
+
+    QTextStream out(stdout);
+    out << "仪表数量: " << instrumentCount << "  帧数: " << frames << Qt::endl;
+
+    // 每帧的目标值（两种方式使用相同的数据）
+    QVector<QVector<double>> values(frames, QVector<double>(instrumentCount));
+    QRandomGenerator random(12345);
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int i = 0; i < instrumentCount; ++i) {
+            values[frame][i] = random.bounded(100.0);
+        }
+    }
+
+    // 偶数行为圆形仪表，奇数行为柱状仪表
+    auto isGauge = [](int index) { return (index / COLUMNS) % 2 == 0; };
+
+    // 1. 每个仪表一个控件
+    PaintCounter widgetCounter;
+    QWidget widgetWindow;
+    QGridLayout *grid = new QGridLayout(&widgetWindow);
+    grid->setContentsMargins(0, 0, 0, 0);
+    grid->setSpacing(0);
+    QVector<Dashboard *> dashboards(instrumentCount, nullptr);
+    QVector<ColumnarInstrument *> bars(instrumentCount, nullptr);
+    for (int i = 0; i < instrumentCount; ++i) {
+        QWidget *widget = nullptr;
+        if (isGauge(i)) {
+            Dashboard *dashboard = new Dashboard();
+            dashboard->configure(QString("仪表%1").arg(i), "kPa", 1, 0, 100);
+            dashboard->setAnimationEnabled(false);
+            dashboard->setInitializationStatus(true);
+            dashboard->setMinimumSize(0, 0);
+            dashboards[i] = dashboard;
+            widget = dashboard;
+        } else {
+            ColumnarInstrument *bar = new ColumnarInstrument();
+            bar->configure(QString("仪表%1").arg(i), "kPa", 1, 0, 100);
+            bar->setMinimumSize(0, 0);
+            bars[i] = bar;
+            widget = bar;
+        }
+        widget->installEventFilter(&widgetCounter);
+        grid->addWidget(widget, i / COLUMNS, i % COLUMNS);
+    }
+    widgetWindow.resize(WINDOW_WIDTH, WINDOW_HEIGHT);
+    widgetWindow.show();
+
+    Result widgetResult = runFrames(frames, widgetCounter, [&](int frame) {
+        for (int i = 0; i < instrumentCount; ++i) {
+            double value = frame < 0 ? 50.0 : values[frame][i];
+            if (dashboards[i]) {
+                dashboards[i]->setValue(value);
+            } else {
+                bars[i]->setValue(value);
+            }
+        }
+    });
+    widgetWindow.hide();
+
+    // 2. 仪表墙
+    PaintCounter wallCounter;
+    InstrumentWall wall;
+    wall.setMinimumColumns(COLUMNS);
+    for (int i = 0; i < instrumentCount; ++i) {
+        wall.addInstrument(i / COLUMNS,
+                           isGauge(i) ? InstrumentWall::Gauge : InstrumentWall::Bar,
+                           QString("仪表%1").arg(i), "kPa", 1, 0, 100);
+    }
+    wall.installEventFilter(&wallCounter);
+    wall.resize(WINDOW_WIDTH, WINDOW_HEIGHT);
+    wall.show();
+
+    Result wallResult = runFrames(frames, wallCounter, [&](int frame) {
+        for (int i = 0; i < instrumentCount; ++i) {
+            wall.setValue(i, frame < 0 ? 50.0 : values[frame][i]);
+        }
+    });
+    wall.hide();
+
+    printResult(out, "每个仪表一个控件", widgetResult);
+    printResult(out, "仪表墙", wallResult);
+    if (wallResult.averageMs > 0.0) {
+        out << "加速比: " << QString::number(widgetResult.averageMs / wallResult.averageMs, 'f', 2) << "x" << Qt::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+/**
+ * @brief 热点内核微基准（Google Benchmark）
+ * 覆盖每样本和每帧执行的处理内核，每个内核按若干通道数和块大小运行，
+ * 用于在优化前后对比同一段代码的耗时：
+ *   - Channel::processRawData              通道数 x 每通道样本数
+ *   - CalibrationParams::apply             块大小
+ *   - SecondaryInstrument公式求值           公式输入通道数（经calculate调用，evaluateFormula为私有）
+ *   - FirFilter::apply（DAQDevice滤波）     通道数 x 每通道样本数
+ *   - SignalGenerator::generate（虚拟设备）  通道数 x 每通道样本数（正弦+谐波+噪声）
+ *   - ECUFrameParser + ECUFrameDecoder     每次读入的帧数（帧解析、帧尾和校验和验证、字段解码）
+ *   - DataStorage写数据行                   通道数（经onSyncFrameReady调用，写入临时目录）
+ *   - SynchronizedDataFrame构造             通道数
+ * 默认屏蔽被测代码的调试输出；设置DAQ_BENCH_VERBOSE=1保留。
+ *
+ * 用法: KernelBenchmark [Google Benchmark参数，例如 --benchmark_filter=Channel]
+ */
+#include <benchmark/benchmark.h>
+#include <QCoreApplication>
+#include <QLoggingCategory>
+#include <QTemporaryDir>
+#include <QStringList>
+#include <QVector>
+#include <QtMath>
+#include <memory>
+#include "../Core/DataTypes.h"
+#include "../Core/Timebase.h"
+#include "../Processing/Channel.h"
+#include "../Processing/SecondaryInstrument.h"
+#include "../Processing/DataStorage.h"
+#include "../Device/FirFilter.h"
+#include "../Device/SignalGenerator.h"
+#include "../Device/ECUFrameParser.h"
+#include "../Device/ECUFrameDecoder.h"
+
+namespace {
+
+constexpr int DEVICE_CHANNELS = 8;    // 合成帧中每个设备的通道数
+
+QString channelId(int index)
+{
+    return QString("ch%1").arg(index);
+}
+
+// 确定性的测试信号
+double sampleValue(int channel, int index)
+{
+    return qSin(index * 0.01 + channel) * 10.0 + channel;
+}
+
+Core::ChannelParams channelParams()
+{
+    return Core::ChannelParams(1.5, 0.25, Core::CalibrationParams(1e-4, -2e-3, 1.01, 0.5), "kPa");
+}
+
+// 参数: 通道数, 每通道样本数
+void BM_ChannelProcessRawData(benchmark::State &state)
+{
+    const int channels = static_cast<int>(state.range(0));
+    const int block = static_cast<int>(state.range(1));
+
+    std::vector<std::unique_ptr<Processing::Channel>> channelObjects;
+    for (int c = 0; c < channels; ++c) {
+        channelObjects.emplace_back(new Processing::Channel(
+            Core::ChannelConfig(channelId(c), channelId(c), "dev0", QString::number(c), channelParams())));
+    }
+
+    qint64 timestamp = 0;
+    for (auto _ : state) {
+        for (int c = 0; c < channels; ++c) {
+            Processing::Channel *channel = channelObjects[c].get();
+            for (int i = 0; i < block; ++i) {
+                benchmark::DoNotOptimize(channel->processRawData(sampleValue(c, i), timestamp + i));
+            }
+        }
+        timestamp += block;
+    }
+    state.SetItemsProcessed(state.iterations() * channels * block);
+}
+BENCHMARK(BM_ChannelProcessRawData)->ArgsProduct({{1, 16, 64}, {1, 64, 1024}});
+
+// 参数: 块大小
+void BM_CalibrationApply(benchmark::State &state)
+{
+    const int block = static_cast<int>(state.range(0));
+    const Core::CalibrationParams calibration(1e-4, -2e-3, 1.01, 0.5);
+
+    QVector<double> input(block);
+    QVector<double> output(block);
+    for (int i = 0; i < block; ++i) {
+        input[i] = sampleValue(0, i);
+    }
+
+    for (auto _ : state) {
+        for (int i = 0; i < block; ++i) {
+            output[i] = calibration.apply(input[i]);
+        }
+        benchmark::DoNotOptimize(output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * block);
+}
+BENCHMARK(BM_CalibrationApply)->Arg(64)->Arg(1024)->Arg(16384);
+
+// 参数: 公式输入通道数
+void BM_SecondaryInstrumentEvaluate(benchmark::State &state)
+{
+    const int inputs = static_cast<int>(state.range(0));
+
+    // (ch0 * 1.5 + ch1 * 1.5 + ...) / inputs
+    QStringList inputChannels;
+    QStringList terms;
+    QMap<QString, double> channelValues;
+    for (int c = 0; c < inputs; ++c) {
+        inputChannels.append(channelId(c));
+        terms.append(channelId(c) + " * 1.5");
+        channelValues.insert(channelId(c), sampleValue(c, 0));
+    }
+    const QString formula = "(" + terms.join(" + ") + ") / " + QString::number(inputs);
+    Processing::SecondaryInstrument instrument(Core::SecondaryInstrumentConfig("derived", formula, inputChannels));
+
+    qint64 timestamp = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(instrument.calculate(channelValues, ++timestamp));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SecondaryInstrumentEvaluate)->Arg(2)->Arg(8)->Arg(32);
+
+// 参数: 通道数, 每通道样本数
+void BM_FirFilterApply(benchmark::State &state)
+{
+    const int channels = static_cast<int>(state.range(0));
+    const int block = static_cast<int>(state.range(1));
+
+    Device::FirFilter filter(Device::FirFilter::DEFAULT_ORDER);
+    filter.design(50.0, 1000.0);
+    filter.setChannelCount(channels);
+
+    QVector<double> input(block);
+    for (int i = 0; i < block; ++i) {
+        input[i] = sampleValue(0, i);
+    }
+
+    for (auto _ : state) {
+        for (int c = 0; c < channels; ++c) {
+            for (int i = 0; i < block; ++i) {
+                benchmark::DoNotOptimize(filter.apply(input[i], c));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * channels * block);
+}
+BENCHMARK(BM_FirFilterApply)->ArgsProduct({{1, 8, 32}, {1, 64, 1024}});
+
+// 参数: 通道数, 每通道样本数
+void BM_SignalGeneratorBlock(benchmark::State &state)
+{
+    const int channels = static_cast<int>(state.range(0));
+    const int block = static_cast<int>(state.range(1));
+
+    Core::VirtualDeviceConfig config;
+    config.signalType = "sine";
+    config.amplitude = 1.0;
+    config.frequency = 50.0;
+    config.sampleRate = 100000.0;
+    config.channelCount = channels;
+    config.noise = 0.01;
+    config.harmonics.append(Core::VirtualHarmonicConfig(3, 0.2, 0.0));
+    Device::SignalGenerator generator(config);
+
+    QVector<double> output(channels * block);
+    for (auto _ : state) {
+        generator.generate(block, output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * channels * block);
+}
+BENCHMARK(BM_SignalGeneratorBlock)->ArgsProduct({{1, 8, 32}, {64, 1024}});
+
+// 参数: 每次读入的帧数（默认协议，9个字段）
+void BM_ECUParseAndDecode(benchmark::State &state)
+{
+    const int framesPerRead = static_cast<int>(state.range(0));
+    const Core::ECUProtocolConfig protocol = Core::ECUProtocolConfig::defaultProtocol();
+
+    QMap<QString, Core::ECUChannelConfig> channels;
+    for (const Core::ECUFieldConfig &field : protocol.fields) {
+        channels.insert(field.name, Core::ECUChannelConfig(field.name, Core::ChannelParams()));
+    }
+
+    // 生成连续的有效帧
+    QByteArray stream;
+    for (int f = 0; f < framesPerRead; ++f) {
+        QByteArray frame(protocol.frameSize, '\0');
+        frame.replace(0, protocol.header.size(), protocol.header);
+        for (int i = protocol.header.size(); i < protocol.checksumOffset; ++i) {
+            frame[i] = static_cast<char>((f * 31 + i * 7) & 0xFF);
+        }
+        quint8 checksum = 0;
+        for (int i = protocol.checksumStart; i <= protocol.checksumEnd; ++i) {
+            checksum += static_cast<quint8>(frame[i]);
+        }
+        frame[protocol.checksumOffset] = static_cast<char>(checksum);
+        frame.replace(protocol.frameSize - protocol.footer.size(), protocol.footer.size(), protocol.footer);
+        stream.append(frame);
+    }
+
+    Device::ECUFrameParser parser;
+    parser.setProtocol(protocol);
+    const Device::ECUFrameDecoder decoder(protocol, channels);
+    QVector<quint8> frame(parser.frameSize());
+    QVector<double> values(decoder.fieldCount());
+
+    qint64 arrivalNs = 0;
+    qint64 decoded = 0;
+    for (auto _ : state) {
+        parser.append(stream.constData(), stream.size(), ++arrivalNs);
+        while (parser.nextFrame(frame.data())) {
+            decoder.decode(frame.constData(), values.data());
+            benchmark::DoNotOptimize(values.data());
+            ++decoded;
+        }
+    }
+    if (decoded != state.iterations() * framesPerRead) {
+        state.SkipWithError("帧解析数量不符");
+    }
+    state.SetItemsProcessed(state.iterations() * framesPerRead);
+    state.SetBytesProcessed(state.iterations() * stream.size());
+}
+BENCHMARK(BM_ECUParseAndDecode)->Arg(1)->Arg(16)->Arg(128);
+
+Core::SynchronizedDataFrame buildFrame(const QStringList &channelIds, qint64 timestamp)
+{
+    Core::SynchronizedDataFrame frame(timestamp);
+    for (int c = 0; c < channelIds.size(); ++c) {
+        Core::ProcessedDataPoint dataPoint;
+        dataPoint.channelId = channelIds[c];
+        dataPoint.value = sampleValue(c, static_cast<int>(timestamp));
+        dataPoint.timestamp = timestamp;
+        dataPoint.status = Core::StatusCode::OK;
+        frame.addChannelData(channelIds[c], dataPoint);
+    }
+    for (int d = 0; d * DEVICE_CHANNELS < channelIds.size(); ++d) {
+        frame.noteAcquisition(QString("dev%1").arg(d), timestamp);
+    }
+    return frame;
+}
+
+// 参数: 通道数
+void BM_DataStorageWriteRow(benchmark::State &state)
+{
+    const int channels = static_cast<int>(state.range(0));
+
+    QTemporaryDir directory;
+    Processing::DataStorage storage;
+    storage.setStorageDirectory(directory.path());
+    if (!storage.startStorage(Core::Timebase::nowNs())) {
+        state.SkipWithError("无法创建存储文件");
+        return;
+    }
+
+    QStringList channelIds;
+    for (int c = 0; c < channels; ++c) {
+        channelIds.append(channelId(c));
+        storage.onProcessedDataPointReady(channelIds.last(), Core::ProcessedDataPoint());
+    }
+    const Core::SynchronizedDataFrame frame = buildFrame(channelIds, Core::Timebase::nowNs());
+
+    for (auto _ : state) {
+        storage.onSyncFrameReady(frame);
+    }
+    storage.stopStorage();
+    state.SetItemsProcessed(state.iterations() * channels);
+}
+BENCHMARK(BM_DataStorageWriteRow)->Arg(8)->Arg(64)->Arg(256);
+
+// 参数: 通道数
+void BM_SynchronizedDataFrameBuild(benchmark::State &state)
+{
+    const int channels = static_cast<int>(state.range(0));
+
+    QStringList channelIds;
+    for (int c = 0; c < channels; ++c) {
+        channelIds.append(channelId(c));
+    }
+
+    qint64 timestamp = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(buildFrame(channelIds, ++timestamp));
+    }
+    state.SetItemsProcessed(state.iterations() * channels);
+}
+BENCHMARK(BM_SynchronizedDataFrameBuild)->Arg(8)->Arg(64)->Arg(256);
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Core::Timebase::initialize();
+
+    // DataStorage使用程序目录作为默认存储目录
+    QCoreApplication app(argc, argv);
+    if (qEnvironmentVariableIntValue("DAQ_BENCH_VERBOSE") == 0) {
+        QLoggingCategory::setFilterRules("default.debug=false\ndaq.*.info=false");
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,464 @@
+/**
+ * @brief 采集流水线无界面基准测试
+ * 不创建任何窗口，按主程序的线程结构运行完整的采集流水线：
+ *   N个合成设备（各自一个线程，每个M个通道，按给定采样率产生样本）
+ *   -> DataProcessor（独立线程，同步时钟、时间对齐、同步帧）
+ *   -> DataStorage（写CSV到临时目录）
+ * 运行固定时长后输出吞吐量、每样本CPU时间、各阶段和端到端延迟分位数以及内存占用，
+ * 可在没有采集硬件的Linux机器上得到可重复的性能基线。
+ * 默认屏蔽流水线自身的调试输出；设置DAQ_BENCH_VERBOSE=1保留。
+ * 线程放置（对比抖动用）：DAQ_BENCH_PROCESSOR_CPUS、DAQ_BENCH_DEVICE_CPUS为逗号分隔的CPU核编号，
+ * DAQ_BENCH_PRIORITY为优先级名称（同时作用于处理器和设备线程，见Core::ThreadPlacement）。
+ * 高速块检查：DAQ_BENCH_VIRTUAL_RATE为每通道采样率（Hz）时额外运行一个成块输出的VirtualDevice，
+ * 统计其通道在对齐帧中的出现率，对齐帧中缺少该设备数据（如对齐历史被高速块覆盖）时返回2。
+ *
+ * 用法: PipelineBenchmark [设备数=4] [每设备通道数=8] [采样率Hz=1000] [时长秒=10] [同步间隔ms=10] [指标文件]
+ */
+#include <QCoreApplication>
+#include <QThread>
+#include <QTimer>
+#include <QTemporaryDir>
+#include <QFileInfo>
+#include <QFile>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <QVector>
+#include <QStringList>
+#include <QAtomicInteger>
+#include <QtMath>
+#include "../Core/Timebase.h"
+#include "../Core/Metrics.h"
+#include "../Core/LatencyTrace.h"
+#include "../Core/Log.h"
+#include "../Core/ThreadPlacement.h"
+#include "../Device/AbstractDevice.h"
+#include "../Device/VirtualDevice.h"
+#include "../Processing/DataProcessor.h"
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+constexpr int DEVICE_TICK_MS = 1;             // 合成设备的出数节拍
+constexpr int PROGRESS_INTERVAL_MS = 1000;    // 进度输出周期
+constexpr int VIRTUAL_CHANNELS = 4;           // 高速块检查设备的通道数
+constexpr double VIRTUAL_MIN_COVERAGE = 0.9;  // 对齐帧中高速块设备数据的最低出现率
+
+/**
+ * @brief 合成设备
+ * 每个节拍按经过的时间补齐应产生的样本，样本时间戳取名义采样时刻，
+ * 因此设备线程偶尔被推迟也不会改变样本数和时间间隔。
+ */
+class SyntheticDevice : public Device::AbstractDevice
+{
+public:
+    SyntheticDevice(const QString &deviceId, int channels, double sampleRate)
+        : m_deviceId(deviceId)
+        , m_sampleRate(sampleRate)
+        , m_timer(nullptr)
+        , m_startNs(0)
+        , m_emitted(0)
+    {
+        for (int i = 0; i < channels; ++i) {
+            m_hardwareChannels.append(QString::number(i));
+        }
+    }
+
+    bool connectDevice() override
+    {
+        setStatus(Core::StatusCode::CONNECTED, "合成设备已连接");
+        return true;
+    }
+
+    bool disconnectDevice() override
+    {
+        stopAcquisition();
+        setStatus(Core::StatusCode::DISCONNECTED, "合成设备已断开连接");
+        return true;
+    }
+
+    // 在设备线程中调用
+    void startAcquisition() override
+    {
+        if (!m_timer) {
+            m_timer = new QTimer(this);
+            m_timer->setTimerType(Qt::PreciseTimer);
+            m_timer->setInterval(DEVICE_TICK_MS);
+            QObject::connect(m_timer, &QTimer::timeout, this, [this]() { generateSamples(); });
+        }
+        m_startNs = Core::Timebase::nowNs();
+        m_emitted = 0;
+        m_timer->start();
+        setStatus(Core::StatusCode::ACQUIRING, "合成设备正在采集数据");
+    }
+
+    // 在设备线程中调用
+    void stopAcquisition() override
+    {
+        if (m_timer) {
+            m_timer->stop();
+        }
+        if (m_status == Core::StatusCode::ACQUIRING) {
+            setStatus(Core::StatusCode::STOPPED, "合成设备已停止采集");
+        }
+    }
+
+    QString getDeviceId() const override { return m_deviceId; }
+    Core::DeviceType getDeviceType() const override { return Core::DeviceType::VIRTUAL; }
+
+    quint64 emittedSamples() const { return m_emitted * m_hardwareChannels.size(); }
+
+private:
+    void generateSamples()
+    {
+        Core::Metrics::ScopedTimer readTimer(Core::Metrics::DeviceRead);
+
+        const qint64 nowNs = Core::Timebase::nowNs();
+        const quint64 due = static_cast<quint64>(Core::Timebase::secondsBetween(m_startNs, nowNs) * m_sampleRate);
+        for (; m_emitted < due; ++m_emitted) {
+            const double t = m_emitted / m_sampleRate;
+            const qint64 timestamp = m_startNs + static_cast<qint64>(t * Core::Timebase::NS_PER_SECOND);
+            for (int i = 0; i < m_hardwareChannels.size(); ++i) {
+                emit rawDataPointReady(m_deviceId, m_hardwareChannels[i], qSin(t * (1.0 + i)) * (i + 1), timestamp);
+            }
+            Core::Metrics::increment(Core::Metrics::RawSamples, m_hardwareChannels.size());
+        }
+    }
+
+    QString m_deviceId;
+    QStringList m_hardwareChannels;
+    double m_sampleRate;
+    QTimer *m_timer;
+    qint64 m_startNs;                 // 采集开始时刻（Timebase纳秒）
+    quint64 m_emitted;                // 已产生的采样时刻数
+};
+
+// 进程CPU时间（所有线程，秒）
+double processCpuSeconds()
+{
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6
+               + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    }
+#endif
+    return -1.0;
+}
+
+// 从/proc/self/status读取内存字段（KB），不可用时返回-1
+qint64 procStatusKb(const char *field)
+{
+    QFile file("/proc/self/status");
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return -1;
+    }
+    const QByteArray prefix = QByteArray(field) + ':';
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.startsWith(prefix)) {
+            return line.mid(prefix.size()).trimmed().split(' ').value(0).toLongLong();
+        }
+    }
+    return -1;
+}
+
+// 从环境变量读取线程放置策略
+Core::ThreadPlacementConfig placementFromEnvironment(const char *cpusVariable)
+{
+    Core::ThreadPlacementConfig placement;
+    const QStringList cpus = qEnvironmentVariable(cpusVariable).split(',', Qt::SkipEmptyParts);
+    for (const QString &cpu : cpus) {
+        bool ok = false;
+        const int index = cpu.trimmed().toInt(&ok);
+        if (ok && index >= 0) {
+            placement.cpus.append(index);
+        }
+    }
+    const QString priority = qEnvironmentVariable("DAQ_BENCH_PRIORITY").trimmed().toLower();
+    if (Core::ThreadPlacement::priorityNames().contains(priority)) {
+        placement.priority = priority;
+    }
+    return placement;
+}
+
+QString formatKb(qint64 kb)
+{
+    return kb < 0 ? QString("不可用") : QString::number(kb / 1024.0, 'f', 1) + " MB";
+}
+
+void printHistogram(QTextStream &out, const QString &name, const Core::Metrics::Histogram &histogram)
+{
+    if (histogram.count == 0) {
+        return;
+    }
+    out << "  " << qSetFieldWidth(16) << Qt::left << name << qSetFieldWidth(0)
+        << " 次数 " << histogram.count
+        << "  P50 " << QString::number(histogram.percentileUs(50.0), 'f', 1) << " us"
+        << "  P90 " << QString::number(histogram.percentileUs(90.0), 'f', 1) << " us"
+        << "  P99 " << QString::number(histogram.percentileUs(99.0), 'f', 1) << " us"
+        << "  P99.9 " << QString::number(histogram.percentileUs(99.9), 'f', 1) << " us"
+        << "  最大 " << QString::number(histogram.maxUs(), 'f', 1) << " us" << Qt::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Core::Timebase::initialize();
+
+    QCoreApplication app(argc, argv);
+
+    const bool verbose = qEnvironmentVariableIntValue("DAQ_BENCH_VERBOSE") != 0;
+    if (!verbose) {
+        QLoggingCategory::setFilterRules("default.debug=false\ndaq.*.info=false");
+    }
+
+    const int deviceCount = argc > 1 ? qMax(1, QString(argv[1]).toInt()) : 4;
+    const int channelsPerDevice = argc > 2 ? qMax(1, QString(argv[2]).toInt()) : 8;
+    const double sampleRate = argc > 3 ? qMax(1.0, QString(argv[3]).toDouble()) : 1000.0;
+    const double durationSec = argc > 4 ? qMax(1.0, QString(argv[4]).toDouble()) : 10.0;
+    const int syncIntervalMs = argc > 5 ? qMax(1, QString(argv[5]).toInt()) : 10;
+    const QString metricsFile = argc > 6 ? QString(argv[6]) : QString();
+
+    QTextStream out(stdout);
+    out << "设备数: " << deviceCount << "  通道/设备: " << channelsPerDevice
+        << "  采样率: " << sampleRate << " Hz  时长: " << durationSec << " 秒"
+        << "  同步间隔: " << syncIntervalMs << " ms" << Qt::endl;
+
+    QTemporaryDir storageDir;
+    if (!storageDir.isValid()) {
+        out << "无法创建临时存储目录" << Qt::endl;
+        return 1;
+    }
+
+    const qint64 rssBeforeKb = procStatusKb("VmRSS");
+
+    // 处理器线程
+    QThread processorThread;
+    Processing::DataProcessor *processor = new Processing::DataProcessor(syncIntervalMs);
+    processor->setAlignmentConfig(Core::AlignmentConfig());
+    processor->setStorageDirectory(storageDir.path());
+    processor->moveToThread(&processorThread);
+    QObject::connect(&processorThread, &QThread::finished, processor, &QObject::deleteLater);
+    Core::ThreadPlacement::applyOnStart(&processorThread, placementFromEnvironment("DAQ_BENCH_PROCESSOR_CPUS"), "processor");
+    processorThread.start();
+
+    QMap<QString, Core::ChannelConfig> channelConfigs;
+    for (int d = 0; d < deviceCount; ++d) {
+        for (int c = 0; c < channelsPerDevice; ++c) {
+            const QString channelId = QString("dev%1_ch%2").arg(d).arg(c);
+            channelConfigs.insert(channelId, Core::ChannelConfig(channelId, channelId, QString("dev%1").arg(d),
+                                                                 QString::number(c), Core::ChannelParams()));
+        }
+    }
+
+    // 高速块检查设备（可选）
+    const double virtualRate = qEnvironmentVariable("DAQ_BENCH_VIRTUAL_RATE").toDouble();
+    Core::VirtualDeviceConfig virtualConfig;
+    virtualConfig.deviceId = "virt";
+    virtualConfig.instanceName = "virt";
+    virtualConfig.signalType = "sine";
+    virtualConfig.amplitude = 1.0;
+    virtualConfig.frequency = 50.0;
+    virtualConfig.sampleRate = virtualRate;
+    virtualConfig.channelCount = VIRTUAL_CHANNELS;
+    if (virtualRate > 0.0) {
+        out << "高速块设备: " << VIRTUAL_CHANNELS << " 通道 @ " << virtualRate << " Hz" << Qt::endl;
+        for (int c = 0; c < VIRTUAL_CHANNELS; ++c) {
+            const QString channelId = QString("virt_ch%1").arg(c);
+            channelConfigs.insert(channelId, Core::ChannelConfig(channelId, channelId, virtualConfig.deviceId,
+                                                                 QString::number(c), Core::ChannelParams()));
+        }
+    }
+
+    bool channelsCreated = false;
+    QMetaObject::invokeMethod(processor, [processor, &channelConfigs, &channelsCreated]() {
+        channelsCreated = processor->createChannels(channelConfigs);
+    }, Qt::BlockingQueuedConnection);
+    if (!channelsCreated) {
+        out << "创建通道失败" << Qt::endl;
+    }
+
+    // 设备线程
+    QVector<QThread*> deviceThreads;
+    QVector<SyntheticDevice*> devices;
+    const Core::ThreadPlacementConfig devicePlacement = placementFromEnvironment("DAQ_BENCH_DEVICE_CPUS");
+    for (int d = 0; d < deviceCount; ++d) {
+        QThread *thread = new QThread();
+        Core::ThreadPlacement::applyOnStart(thread, devicePlacement, QString("dev%1").arg(d));
+        SyntheticDevice *device = new SyntheticDevice(QString("dev%1").arg(d), channelsPerDevice, sampleRate);
+        device->moveToThread(thread);
+        QObject::connect(device, &Device::AbstractDevice::rawDataPointReady,
+                         processor, &Processing::DataProcessor::onRawDataPointReceived, Qt::QueuedConnection);
+        QObject::connect(thread, &QThread::finished, device, &QObject::deleteLater);
+        thread->start();
+        deviceThreads.append(thread);
+        devices.append(device);
+    }
+
+    // 统计对齐帧中高速块设备通道的出现情况（处理器线程中调用）
+    QAtomicInteger<quint64> framesSeen = 0;
+    QAtomicInteger<quint64> framesWithVirtual = 0;
+    QThread *virtualThread = nullptr;
+    Device::VirtualDevice *virtualDevice = nullptr;
+    if (virtualRate > 0.0) {
+        QObject::connect(processor, &Processing::DataProcessor::syncFrameReady, processor,
+                         [&framesSeen, &framesWithVirtual](const Core::SynchronizedDataFrame &frame) {
+            ++framesSeen;
+            bool complete = true;
+            for (int c = 0; c < VIRTUAL_CHANNELS && complete; ++c) {
+                complete = frame.channelData.contains(QString("virt_ch%1").arg(c));
+            }
+            if (complete) {
+                ++framesWithVirtual;
+            }
+        }, Qt::DirectConnection);
+
+        virtualThread = new QThread();
+        Core::ThreadPlacement::applyOnStart(virtualThread, devicePlacement, "virt");
+        virtualDevice = new Device::VirtualDevice(virtualConfig);
+        virtualDevice->moveToThread(virtualThread);
+        QObject::connect(virtualDevice, &Device::AbstractDevice::rawDataBlockReady,
+                         processor, &Processing::DataProcessor::onRawDataBlockReceived, Qt::QueuedConnection);
+        QObject::connect(virtualThread, &QThread::finished, virtualDevice, &QObject::deleteLater);
+        virtualThread->start();
+    }
+
+    QMetaObject::invokeMethod(processor, [processor]() {
+        processor->startProcessing();
+        processor->startDataStorage(Core::Timebase::nowNs());
+    }, Qt::BlockingQueuedConnection);
+
+    Core::LatencyTrace::reset();
+    const Core::Metrics::Snapshot before = Core::Metrics::snapshot();
+    const double cpuBefore = processCpuSeconds();
+    const qint64 startNs = Core::Timebase::nowNs();
+
+    for (SyntheticDevice *device : devices) {
+        QMetaObject::invokeMethod(device, [device]() {
+            device->connectDevice();
+            device->startAcquisition();
+        }, Qt::BlockingQueuedConnection);
+    }
+
+    if (virtualDevice) {
+        QMetaObject::invokeMethod(virtualDevice, [virtualDevice]() {
+            virtualDevice->connectDevice();
+            virtualDevice->startAcquisition();
+        }, Qt::BlockingQueuedConnection);
+    }
+
+    // 主线程只负责计时和输出进度
+    const qint64 endNs = startNs + static_cast<qint64>(durationSec * Core::Timebase::NS_PER_SECOND);
+    Core::Metrics::Snapshot previous = before;
+    while (Core::Timebase::nowNs() < endNs) {
+        QThread::msleep(static_cast<unsigned long>(qMin<qint64>(PROGRESS_INTERVAL_MS, (endNs - Core::Timebase::nowNs()) / Core::Timebase::NS_PER_MS + 1)));
+        const Core::Metrics::Snapshot current = Core::Metrics::snapshot();
+        const Core::Metrics::Snapshot interval = current - previous;
+        const double seconds = qMax(1e-3, Core::Timebase::secondsBetween(previous.timestampNs, current.timestampNs));
+        out << QString("  [%1 s] 处理 %2 样本/秒  同步帧 %3 帧/秒")
+                   .arg(Core::Timebase::secondsBetween(startNs, current.timestampNs), 0, 'f', 1)
+                   .arg(interval.counters[Core::Metrics::IngestedSamples] / seconds, 0, 'f', 0)
+                   .arg(interval.counters[Core::Metrics::Frames] / seconds, 0, 'f', 1)
+            << Qt::endl;
+        previous = current;
+    }
+
+    // 先停设备，再在处理器线程排一个空调用，确保已排队的样本全部处理完
+    quint64 emittedSamples = 0;
+    for (SyntheticDevice *device : devices) {
+        QMetaObject::invokeMethod(device, [device]() { device->stopAcquisition(); }, Qt::BlockingQueuedConnection);
+        emittedSamples += device->emittedSamples();
+    }
+    if (virtualDevice) {
+        QMetaObject::invokeMethod(virtualDevice, [virtualDevice]() { virtualDevice->stopAcquisition(); },
+                                  Qt::BlockingQueuedConnection);
+    }
+    const qint64 stopNs = Core::Timebase::nowNs();
+    QMetaObject::invokeMethod(processor, []() {}, Qt::BlockingQueuedConnection);
+    const qint64 drainedNs = Core::Timebase::nowNs();
+
+    QString storageFile;
+    QMetaObject::invokeMethod(processor, [processor, &storageFile]() {
+        storageFile = processor->getCurrentStorageFilePath();
+        processor->stopDataStorage();
+        processor->stopProcessing();
+    }, Qt::BlockingQueuedConnection);
+
+    const double cpuSeconds = processCpuSeconds() - cpuBefore;
+    const Core::Metrics::Snapshot after = Core::Metrics::snapshot();
+    const Core::Metrics::Snapshot total = after - before;
+    const double wallSeconds = Core::Timebase::secondsBetween(startNs, stopNs);
+    const quint64 ingested = total.counters[Core::Metrics::IngestedSamples];
+
+    out << Qt::endl << "吞吐量" << Qt::endl;
+    out << "  产生样本 " << emittedSamples << "  处理样本 " << ingested
+        << "  (" << QString::number(ingested / wallSeconds, 'f', 0) << " 样本/秒，目标 "
+        << QString::number(deviceCount * channelsPerDevice * sampleRate, 'f', 0) << ")" << Qt::endl;
+    out << "  同步帧 " << total.counters[Core::Metrics::Frames]
+        << " (" << QString::number(total.counters[Core::Metrics::Frames] / wallSeconds, 'f', 1) << " 帧/秒)"
+        << "  存储行 " << total.counters[Core::Metrics::StoredRows]
+        << "  停止后排空积压 " << QString::number((drainedNs - stopNs) / 1e6, 'f', 1) << " ms" << Qt::endl;
+    out << "  存储文件 " << QString::number(QFileInfo(storageFile).size() / 1024.0, 'f', 1) << " KB" << Qt::endl;
+
+    int exitCode = 0;
+    if (virtualDevice) {
+        // 延迟预算内的网格点尚无数据属正常，出现率按全部帧计算并留出余量
+        const quint64 seen = framesSeen.loadRelaxed();
+        const quint64 withVirtual = framesWithVirtual.loadRelaxed();
+        const double coverage = seen > 0 ? static_cast<double>(withVirtual) / seen : 0.0;
+        out << Qt::endl << "高速块对齐检查" << Qt::endl;
+        out << "  对齐帧 " << seen << "  含高速块设备全部通道 " << withVirtual
+            << " (" << QString::number(coverage * 100.0, 'f', 1) << "%)" << Qt::endl;
+        if (withVirtual == 0 || coverage < VIRTUAL_MIN_COVERAGE) {
+            out << "  失败: 高速块设备的数据未进入对齐帧" << Qt::endl;
+            exitCode = 2;
+        }
+    }
+
+    out << Qt::endl << "CPU" << Qt::endl;
+    if (cpuSeconds >= 0.0 && ingested > 0) {
+        out << "  进程CPU " << QString::number(cpuSeconds, 'f', 2) << " 秒"
+            << " (" << QString::number(cpuSeconds / wallSeconds * 100.0, 'f', 1) << "% 单核)"
+            << "  每样本 " << QString::number(cpuSeconds * 1e9 / ingested, 'f', 0) << " ns" << Qt::endl;
+    } else {
+        out << "  不可用" << Qt::endl;
+    }
+
+    out << Qt::endl << "延迟" << Qt::endl;
+    for (int stage = 0; stage < Core::Metrics::STAGE_COUNT; ++stage) {
+        printHistogram(out, Core::Metrics::stageName(static_cast<Core::Metrics::Stage>(stage)), total.stages[stage]);
+    }
+
+    out << Qt::endl << "内存" << Qt::endl;
+    out << "  开始 " << formatKb(rssBeforeKb) << "  结束 " << formatKb(procStatusKb("VmRSS"))
+        << "  峰值 " << formatKb(procStatusKb("VmHWM")) << Qt::endl;
+
+    if (!metricsFile.isEmpty()) {
+        if (Core::Metrics::dumpToFile(metricsFile, total)) {
+            out << Qt::endl << "指标已保存: " << metricsFile << Qt::endl;
+        }
+    }
+
+    if (verbose) {
+        Core::RingLog::instance().flushToQtLog();
+    }
+
+    if (virtualThread) {
+        virtualThread->quit();
+        virtualThread->wait();
+        delete virtualThread;
+    }
+    for (QThread *thread : deviceThreads) {
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+    processorThread.quit();
+    processorThread.wait();
+
+    return exitCode;
+}
@@ -0,0 +1,229 @@
+/**
+ * @brief 曲线绘制基准测试
+ * 在多条曲线、长时间窗口下比较主曲线图几种刷新方式的每帧耗时：
+ *   1. 光栅绘制 + 原始数据（每帧追加新样本，QCustomPlot自适应采样）
+ *   2. 光栅绘制 + PlotDataFeeder最小/最大值包络整体替换
+ *   3. OpenGL绘制 + PlotDataFeeder包络（需要以DAQ_ENABLE_OPENGL_PLOT编译且能创建OpenGL上下文）
+ * 每帧模拟一次显示节拍：追加各通道新样本、滚动X轴、同步重绘。
+ * 默认使用offscreen平台；设置DAQ_SOFTWARE_OPENGL=1使用软件OpenGL光栅器，可在无GPU的环境中运行。
+ *
+ * 用法: PlotRenderBenchmark [曲线数=32] [窗口秒数=600] [采样率Hz=100] [帧数=200]
+ */
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "../plot/qcustomplot.h"
+#include "../plot/plotdatafeeder.h"
+
+namespace {
+
+constexpr int PLOT_WIDTH = 1600;
+constexpr int PLOT_HEIGHT = 900;
+constexpr double FRAME_INTERVAL_SEC = 0.05;   // 显示节拍（20 Hz）
+
+struct Result {
+    bool available = false;
+    double averageMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double pointsPerGraph = 0.0;
+};
+
+// 生成通道在[start, end)内的样本
+void generateSamples(int channel, double start, double end, double sampleRate,
+                     QVector<double> &keys, QVector<double> &values)
+{
+    keys.clear();
+    values.clear();
+    const qint64 first = static_cast<qint64>(std::ceil(start * sampleRate));
+    const qint64 last = static_cast<qint64>(std::ceil(end * sampleRate));
+    for (qint64 i = first; i < last; ++i) {
+        double t = i / sampleRate;
+        keys.append(t);
+        values.append(std::sin(t * (0.5 + channel * 0.1)) * (channel + 1)
+                      + 0.2 * std::sin(t * 37.0 + channel));
+    }
+}
+
+QCustomPlot *createPlot(int traces)
+{
+    QCustomPlot *plot = new QCustomPlot();
+    plot->legend->setVisible(true);
+    plot->setNotAntialiasedElements(QCP::aeAll);
+    plot->setPlottingHints(QCP::phFastPolylines | QCP::phImmediateRefresh);
+    for (int i = 0; i < traces; ++i) {
+        QCPGraph *graph = plot->addGraph();
+        graph->setName(QString("通道%1").arg(i));
+        graph->setPen(QPen(QColor::fromHsv((i * 360 / traces) % 360, 255, 200)));
+    }
+    plot->resize(PLOT_WIDTH, PLOT_HEIGHT);
+    plot->show();
+    QCoreApplication::processEvents();
+    return plot;
+}
+
+// 执行若干帧：prepare(endTime)把数据准备到endTime，随后同步重绘
+Result runFrames(QCustomPlot *plot, int frames, double timeWindow,
+                 const std::function<void(double)> &prepare)
+{
+    double now = timeWindow;
+    prepare(now);
+    plot->xAxis->setRange(now - timeWindow, now);
+    plot->replot(QCustomPlot::rpImmediateRefresh);
+    QCoreApplication::processEvents();
+
+    QVector<double> frameMs;
+    frameMs.reserve(frames);
+    for (int frame = 0; frame < frames; ++frame) {
+        now += FRAME_INTERVAL_SEC;
+
+        QElapsedTimer timer;
+        timer.start();
+        prepare(now);
+        plot->xAxis->setRange(now - timeWindow, now);
+        plot->replot(QCustomPlot::rpImmediateRefresh);
+        QCoreApplication::processEvents();
+        frameMs.append(timer.nsecsElapsed() / 1e6);
+    }
+
+    Result result;
+    result.available = true;
+    std::sort(frameMs.begin(), frameMs.end());
+    double sum = 0.0;
+    for (double ms : frameMs) {
+        sum += ms;
+    }
+    const int count = static_cast<int>(frameMs.size());
+    result.averageMs = sum / count;
+    result.p50Ms = frameMs[count / 2];
+    result.p99Ms = frameMs[qMin(count - 1, static_cast<int>(count * 0.99))];
+
+    double points = 0.0;
+    for (int i = 0; i < plot->graphCount(); ++i) {
+        points += plot->graph(i)->dataCount();
+    }
+    result.pointsPerGraph = plot->graphCount() > 0 ? points / plot->graphCount() : 0.0;
+    return result;
+}
+
+Result runRaw(int traces, int frames, double timeWindow, double sampleRate)
+{
+    QCustomPlot *plot = createPlot(traces);
+    QVector<double> lastTime(traces, 0.0);
+    QVector<double> keys;
+    QVector<double> values;
+
+    Result result = runFrames(plot, frames, timeWindow, [&](double now) {
+        for (int i = 0; i < traces; ++i) {
+            generateSamples(i, lastTime[i], now, sampleRate, keys, values);
+            plot->graph(i)->addData(keys, values, true);
+            plot->graph(i)->data()->removeBefore(now - timeWindow);
+            lastTime[i] = now;
+        }
+    });
+
+    delete plot;
+    return result;
+}
+
+Result runDecimated(int traces, int frames, double timeWindow, double sampleRate, bool openGl, int samples)
+{
+    QCustomPlot *plot = createPlot(traces);
+    if (openGl) {
+        plot->setOpenGl(true, samples);
+        if (!plot->openGl()) {
+            delete plot;
+            return Result();
+        }
+    }
+
+    PlotDataFeeder feeder;
+    for (int i = 0; i < traces; ++i) {
+        feeder.addChannel(QString::number(i));
+        plot->graph(i)->setAdaptiveSampling(false);
+    }
+
+    QVector<double> lastTime(traces, 0.0);
+    QVector<double> keys;
+    QVector<double> values;
+
+    Result result = runFrames(plot, frames, timeWindow, [&](double now) {
+        feeder.setResolution(timeWindow, qMax(1, plot->axisRect()->width()));
+        for (int i = 0; i < traces; ++i) {
+            generateSamples(i, lastTime[i], now, sampleRate, keys, values);
+            feeder.appendSamples(QString::number(i), keys, values);
+            lastTime[i] = now;
+        }
+        feeder.trimBefore(now - timeWindow);
+        for (int i = 0; i < traces; ++i) {
+            feeder.feedGraph(QString::number(i), plot->graph(i));
+        }
+        double lower = 0.0;
+        double upper = 0.0;
+        if (feeder.valueRange(lower, upper)) {
+            plot->yAxis->setRange(lower, upper);
+        }
+    });
+
+    delete plot;
+    return result;
+}
+
+void printResult(QTextStream &out, const QString &name, const Result &result)
+{
+    out << qSetFieldWidth(24) << Qt::left << name << qSetFieldWidth(0);
+    if (!result.available) {
+        out << " 不可用（未启用QCUSTOMPLOT_USE_OPENGL或无法创建OpenGL上下文）" << Qt::endl;
+        return;
+    }
+    out << " 平均 " << QString::number(result.averageMs, 'f', 3) << " ms"
+        << "  P50 " << QString::number(result.p50Ms, 'f', 3) << " ms"
+        << "  P99 " << QString::number(result.p99Ms, 'f', 3) << " ms"
+        << "  点数/曲线 " << QString::number(result.pointsPerGraph, 'f', 0) << Qt::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    if (qEnvironmentVariableIntValue("DAQ_SOFTWARE_OPENGL") != 0) {
+        QCoreApplication::setAttribute(Qt::AA_UseSoftwareOpenGL);
+        qputenv("LIBGL_ALWAYS_SOFTWARE", "1");
+    }
+
+    QApplication app(argc, argv);
+
+    const int traces = argc > 1 ? qMax(1, QString(argv[1]).toInt()) : 32;
+    const double timeWindow = argc > 2 ? qMax(1.0, QString(argv[2]).toDouble()) : 600.0;
+    const double sampleRate = argc > 3 ? qMax(1.0, QString(argv[3]).toDouble()) : 100.0;
+    const int frames = argc > 4 ? qMax(1, QString(argv[4]).toInt()) : 200;
+
+    QTextStream out(stdout);
+    out << "曲线数: " << traces << "  窗口: " << timeWindow << " 秒"
+        << "  采样率: " << sampleRate << " Hz  帧数: " << frames << Qt::endl;
+
+    Result rawResult = runRaw(traces, frames, timeWindow, sampleRate);
+    Result rasterResult = runDecimated(traces, frames, timeWindow, sampleRate, false, 0);
+    Result openGlResult = runDecimated(traces, frames, timeWindow, sampleRate, true, 4);
+
+    printResult(out, "光栅 + 原始数据", rawResult);
+    printResult(out, "光栅 + 包络", rasterResult);
+    printResult(out, "OpenGL + 包络", openGlResult);
+    if (rasterResult.averageMs > 0.0) {
+        out << "包络加速比（相对原始数据）: "
+            << QString::number(rawResult.averageMs / rasterResult.averageMs, 'f', 2) << "x" << Qt::endl;
+    }
+    if (openGlResult.available && openGlResult.averageMs > 0.0) {
+        out << "OpenGL加速比（相对光栅 + 包络）: "
+            << QString::number(rasterResult.averageMs / openGlResult.averageMs, 'f', 2) << "x" << Qt::endl;
+    }
+
+    return 0;
+}
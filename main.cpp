@@ -1,9 +1,45 @@
 #include "mainwindow.h"
+#include "Core/Timebase.h"
 
 #include <QApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+/**
+ * @brief 是否使用软件OpenGL光栅器
+ * 需要在创建QApplication之前决定，因此直接读取程序目录下config.json的display段；
+ * 环境变量DAQ_SOFTWARE_OPENGL优先（用于无GPU的无头环境）
+ * @param programPath 程序路径（argv[0]）
+ * @return 是否使用软件OpenGL
+ */
+static bool useSoftwareOpenGl(const char *programPath)
+{
+    if (qEnvironmentVariableIsSet("DAQ_SOFTWARE_OPENGL")) {
+        return qEnvironmentVariableIntValue("DAQ_SOFTWARE_OPENGL") != 0;
+    }
+
+    QFile file(QFileInfo(QString::fromLocal8Bit(programPath)).absolutePath() + "/config.json");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QJsonObject display = QJsonDocument::fromJson(file.readAll()).object()["display"].toObject();
+    return display["software_opengl"].toBool(false);
+}
 
 int main(int argc, char *argv[])
 {
+    // 尽早固定统一时间基准的起点
+    Core::Timebase::initialize();
+
+    if (useSoftwareOpenGl(argv[0])) {
+        // Windows下加载opengl32sw，Mesa下强制llvmpipe
+        QCoreApplication::setAttribute(Qt::AA_UseSoftwareOpenGL);
+        qputenv("LIBGL_ALWAYS_SOFTWARE", "1");
+    }
+
     QApplication a(argc, argv);
     MainWindow w;
     w.show();
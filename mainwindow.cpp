@@ -1,5 +1,6 @@
 #include "mainwindow.h"
 #include "./ui_mainwindow.h"
+#include "Core/ThreadPlacement.h"
 #include <QDebug>
 #include <QDir>
 #include <QCoreApplication>
@@ -14,6 +15,8 @@
 #include <QRandomGenerator>
 #include <QResizeEvent>
 #include <QSplitterHandle>
+#include <cmath>
+#include <limits>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -28,8 +31,12 @@ MainWindow::MainWindow(QWidget *parent)
     , m_dashboard2(nullptr)
     , m_dashboard3(nullptr)
     , m_dashboard4(nullptr)
+    , m_instrumentWall(nullptr)
     , m_isAcquiring(false)
-    , m_plotUpdateTimer(nullptr)
+    , m_displayScheduler(nullptr)
+    , m_plotReplotPending(false)
+    , m_logFlushTimer(nullptr)
+    , m_diagnosticsPanel(nullptr)
     , m_startTimestamp(0)
     , m_displayPointCount(600)  // 默认显示600个点
     , m_timeWindow(60.0)        // 默认显示60秒的数据
@@ -60,11 +67,11 @@ MainWindow::MainWindow(QWidget *parent)
 
 MainWindow::~MainWindow()
 {
-    // 停止图表更新定时器
-    if (m_plotUpdateTimer) {
-        m_plotUpdateTimer->stop();
-        delete m_plotUpdateTimer;
-        m_plotUpdateTimer = nullptr;
+    // 停止显示调度器
+    if (m_displayScheduler) {
+        m_displayScheduler->stop();
+        delete m_displayScheduler;
+        m_displayScheduler = nullptr;
     }
 
     // 清理数据处理器和线程
@@ -219,6 +226,11 @@ void MainWindow::initializeDevices()
         return;
     }
 
+    // 线程放置：GUI线程在此应用，设备线程在创建时应用
+    const Core::ThreadingConfig threadingConfig = m_configManager->getThreadingConfig();
+    Core::ThreadPlacement::applyToCurrentThread(threadingConfig.gui, "gui");
+    m_deviceManager->setThreadingConfig(threadingConfig);
+
     // 获取虚拟设备配置
     QList<Core::VirtualDeviceConfig> virtualDevices = m_configManager->getVirtualDeviceConfigs();
 
@@ -357,10 +369,17 @@ void MainWindow::initializeProcessing()
 {
     // 创建数据处理器线程
     m_processorThread = new QThread(this);
+    if (m_configManager) {
+        // 同步、时间对齐和数据存储都在处理器线程执行，共用该线程的放置策略
+        Core::ThreadPlacement::applyOnStart(m_processorThread, m_configManager->getThreadingConfig().processor, "processor");
+    }
 
     // 创建数据处理器（不设置父对象，以便可以移动到线程）
     int syncIntervalMs = m_configManager ? m_configManager->getSynchronizationIntervalMs() : Core::DEFAULT_SYNC_INTERVAL_MS;
     m_dataProcessor = new Processing::DataProcessor(syncIntervalMs);
+    if (m_configManager) {
+        m_dataProcessor->setAlignmentConfig(m_configManager->getAlignmentConfig());
+    }
 
     // 将数据处理器移动到线程
     m_dataProcessor->moveToThread(m_processorThread);
@@ -390,6 +409,8 @@ void MainWindow::initializeProcessing()
     if (m_deviceManager) {
         connect(m_deviceManager, &Device::DeviceManager::rawDataPointReady,
                 m_dataProcessor, &Processing::DataProcessor::onRawDataPointReceived, Qt::QueuedConnection);
+        connect(m_deviceManager, &Device::DeviceManager::rawDataBlockReady,
+                m_dataProcessor, &Processing::DataProcessor::onRawDataBlockReceived, Qt::QueuedConnection);
         connect(m_deviceManager, &Device::DeviceManager::deviceStatusChanged,
                 m_dataProcessor, &Processing::DataProcessor::onDeviceStatusChanged, Qt::QueuedConnection);
     }
@@ -473,12 +494,9 @@ void MainWindow::testDataSynchronizer()
 
 void MainWindow::onRawDataPointReady(QString deviceId, QString hardwareChannel, double rawValue, qint64 timestamp)
 {
-    // 将时间戳转换为可读格式
-    QString timeStr = QDateTime::fromMSecsSinceEpoch(timestamp).toString("hh:mm:ss.zzz");
-
-    // 输出原始数据点信息
-     qDebug() << "原始数据点 [" << timeStr << "] 设备:" << deviceId
-             << "通道:" << hardwareChannel << "值:" << rawValue;
+    // 输出原始数据点信息（Release构建中连同时间格式化一起被移除）
+    DAQ_TRACE(lcDisplay) << "原始数据点 [" << Core::Timebase::toDateTime(timestamp).toString("hh:mm:ss.zzz")
+                         << "] 设备:" << deviceId << "通道:" << hardwareChannel << "值:" << rawValue;
 }
 
 void MainWindow::onDeviceStatusChanged(QString deviceId, Core::StatusCode status, QString message)
@@ -497,13 +515,11 @@ void MainWindow::onErrorOccurred(QString deviceId, QString errorMsg)
 
 void MainWindow::onProcessedDataPointReady(QString channelId, Core::ProcessedDataPoint dataPoint)
 {
-    // 将时间戳转换为可读格式
-    QString timeStr = QDateTime::fromMSecsSinceEpoch(dataPoint.timestamp).toString("hh:mm:ss.zzz");
-
-    // 输出处理后数据点信息
-     qDebug() << "处理后数据点 [" << timeStr << "] 通道:" << channelId
-             << "值:" << dataPoint.value << dataPoint.unit
-             << "状态:" << Core::statusCodeToString(dataPoint.status);
+    // 输出处理后数据点信息（Release构建中连同时间格式化一起被移除）
+    DAQ_TRACE(lcDisplay) << "处理后数据点 [" << Core::Timebase::toDateTime(dataPoint.timestamp).toString("hh:mm:ss.zzz")
+                         << "] 通道:" << channelId
+                         << "值:" << dataPoint.value << dataPoint.unit
+                         << "状态:" << Core::statusCodeToString(dataPoint.status);
 }
 
 
@@ -574,6 +590,18 @@ void MainWindow::initializeUI()
     connect(m_startStopButton, &QPushButton::clicked, this, &MainWindow::onStartStopButtonClicked);
     controlLayout->addWidget(m_startStopButton);
 
+    // 创建性能诊断按钮，打开独立的诊断窗口
+    QPushButton* diagnosticsButton = new QPushButton("性能诊断", this);
+    connect(diagnosticsButton, &QPushButton::clicked, this, [this]() {
+        if (!m_diagnosticsPanel) {
+            m_diagnosticsPanel = new DiagnosticsPanel(this);
+        }
+        m_diagnosticsPanel->show();
+        m_diagnosticsPanel->raise();
+        m_diagnosticsPanel->activateWindow();
+    });
+    controlLayout->addWidget(diagnosticsButton);
+
     // 添加弹簧
     controlLayout->addStretch();
 
@@ -612,10 +640,17 @@ void MainWindow::initializeUI()
     // 设置仪表
     setupInstruments();
 
-    // 创建图表更新定时器
-    m_plotUpdateTimer = new QTimer(this);
-    connect(m_plotUpdateTimer, &QTimer::timeout, this, &MainWindow::updatePlot);
-    m_plotUpdateTimer->setInterval(50); // 50ms更新一次图表，提高刷新率
+    // 创建显示调度器，代替独立的图表定时器和仪表盘动画定时器
+    m_displayScheduler = new DisplayScheduler(m_dataProcessor, this);
+    connect(m_displayScheduler, &DisplayScheduler::renderRequested, this, &MainWindow::renderDisplayFrame);
+    connect(m_displayScheduler, &DisplayScheduler::statisticsUpdated, this, &MainWindow::onDisplayStatisticsUpdated);
+
+    // 定期把各线程写入环形日志的诊断信息输出到Qt日志
+    m_logFlushTimer = new QTimer(this);
+    connect(m_logFlushTimer, &QTimer::timeout, this, []() {
+        Core::RingLog::instance().flushToQtLog();
+    });
+    m_logFlushTimer->start(LOG_FLUSH_INTERVAL_MS);
 
     // 输出调试信息
     qDebug() << "UI初始化完成，主分割器大小:" << ui->mainSplitter->sizes()
@@ -648,6 +683,20 @@ void MainWindow::setupPlot()
     m_plot->setNotAntialiasedElements(QCP::aeAll); // 禁用所有元素的抗锯齿
     m_plot->setPlottingHints(QCP::phFastPolylines | QCP::phImmediateRefresh); // 设置绘图提示
 
+    // 按显示配置选择绘制后端和时间窗口
+    Core::DisplayConfig displayConfig = m_configManager ? m_configManager->getDisplayConfig() : Core::DisplayConfig();
+    m_timeWindow = displayConfig.plotTimeWindowSec;
+    m_plot->xAxis->setRange(0, m_timeWindow);
+    if (displayConfig.useOpenGl()) {
+        // OpenGL帧缓冲绘制，创建失败（未编译OpenGL支持或无可用上下文）时QCustomPlot保持光栅绘制
+        m_plot->setOpenGl(true, displayConfig.openGlSamples);
+        if (!m_plot->openGl()) {
+            qDebug() << "OpenGL曲线绘制不可用，回退到光栅绘制";
+        }
+    }
+    qDebug() << "曲线绘制后端:" << (m_plot->openGl() ? "OpenGL" : "光栅")
+             << "，时间窗口:" << m_timeWindow << "秒";
+
     // 设置自动调整大小
     m_plot->plotLayout()->setAutoMargins(QCP::msAll); // 自动调整所有边距
 
@@ -762,15 +811,24 @@ void MainWindow::addChannelToPlot(const QString& channelId, const QString& chann
     graph->setPen(pen);
 
     // 优化性能设置
-    graph->setAdaptiveSampling(true);  // 启用自适应采样
+    // 数据已由m_plotFeeder按像素列抽取，无需再做自适应采样
+    graph->setAdaptiveSampling(false);
     graph->setLineStyle(QCPGraph::lsLine); // 线型
     graph->setScatterStyle(QCPScatterStyle::ssNone); // 不显示散点，提高性能
 
     // 存储图表对象
     m_channelGraphs[channelId] = graph;
 
-    // 重绘图表
-    m_plot->replot(QCustomPlot::rpQueuedReplot);
+    // 注册到曲线数据馈送器
+    m_plotFeeder.addChannel(channelId);
+
+    // 采集中由显示调度器在下一个节拍统一重绘；未采集时调度器不运行，交给QCustomPlot合并到事件循环中重绘
+    if (m_displayScheduler && m_displayScheduler->isActive()) {
+        m_plotReplotPending = true;
+        m_displayScheduler->requestAnimationFrame();
+    } else {
+        m_plot->replot(QCustomPlot::rpQueuedReplot);
+    }
 }
 
 void MainWindow::onStartStopButtonClicked()
@@ -788,7 +846,7 @@ void MainWindow::onStartStopButtonClicked()
         // 停止数据存储
         QMetaObject::invokeMethod(m_dataProcessor, &Processing::DataProcessor::stopDataStorage, Qt::QueuedConnection);
 
-        m_plotUpdateTimer->stop();
+        m_displayScheduler->stop();
 
         m_startStopButton->setText("开始采集");
         m_isAcquiring = false;
@@ -800,12 +858,13 @@ void MainWindow::onStartStopButtonClicked()
         for (auto it = m_channelGraphs.begin(); it != m_channelGraphs.end(); ++it) {
             it.value()->data()->clear();
         }
+        m_plotFeeder.clear();
 
         // 清除处理器中的数据缓冲区
         QMetaObject::invokeMethod(m_dataProcessor, &Processing::DataProcessor::clearAllBuffers, Qt::QueuedConnection);
 
         // 记录开始时间戳
-        m_startTimestamp = QDateTime::currentMSecsSinceEpoch();
+        m_startTimestamp = Core::Timebase::nowNs();
 
         // 启动设备和处理
         m_deviceManager->startAllDevices();
@@ -817,7 +876,7 @@ void MainWindow::onStartStopButtonClicked()
                 m_dataProcessor->startDataStorage(m_startTimestamp);
             }, Qt::QueuedConnection);
 
-        m_plotUpdateTimer->start();
+        m_displayScheduler->start();
 
         m_startStopButton->setText("停止采集");
         m_isAcquiring = true;
@@ -919,6 +978,7 @@ void MainWindow::setupDashboards()
         dashboard->setTextColor(Qt::black);
         dashboard->setForegroundColor(QColor(50, 50, 50));
         dashboard->setAnimationEnabled(true);
+        dashboard->setExternalAnimationClock(true);  // 动画由显示调度器驱动
 
         // 确保仪表盘初始化状态
         dashboard->setInitializationStatus(true);
@@ -976,12 +1036,11 @@ void MainWindow::createColumnarInstruments(const QMap<QString, QList<QString>>&
     ui->instrumentGroupBox->layout()->setContentsMargins(4, 20, 4, 4);
     ui->instrumentGroupBox->layout()->setSpacing(4);
 
-    // 创建仪表布局
-    QVBoxLayout* instrumentLayout = new QVBoxLayout();
-    instrumentLayout->setContentsMargins(4, 4, 4, 4);
-    instrumentLayout->setSpacing(8);
+    // 所有柱状仪表绘制在同一个仪表墙上，一次绘制完成
+    m_instrumentWall = new InstrumentWall();
 
-    // 遍历每种采集类型
+    // 遍历每种采集类型，每种类型占一行
+    int maxColumns = 1;
     for (auto it = channelsByType.constBegin(); it != channelsByType.constEnd(); ++it) {
         QString acquisitionType = it.key();
         QList<QString> channelIds = it.value();
@@ -991,10 +1050,8 @@ void MainWindow::createColumnarInstruments(const QMap<QString, QList<QString>>&
             continue;
         }
 
-        // 创建该采集类型的行布局
-        QHBoxLayout* rowLayout = new QHBoxLayout();
-        rowLayout->setContentsMargins(0, 0, 0, 0);
-        rowLayout->setSpacing(8);
+        int row = m_instrumentWall->addRow();
+        maxColumns = qMax(maxColumns, channelIds.size());
 
         // 遍历该采集类型的所有通道
         for (const QString& channelId : channelIds) {
@@ -1015,27 +1072,28 @@ void MainWindow::createColumnarInstruments(const QMap<QString, QList<QString>>&
                 }
             }
 
-            // 创建柱状仪表
-            ColumnarInstrument* instrument = new ColumnarInstrument();
-            instrument->setMinimumHeight(150); // 确保仪表有足够的高度显示所有元素
+            // 由分辨率计算读数的小数位数
+            int precision = 0;
+            if (displayFormat.resolution > 0.0 && displayFormat.resolution < 1.0) {
+                precision = static_cast<int>(std::ceil(-std::log10(displayFormat.resolution) - 1e-9));
+            }
 
-            // 配置仪表
-            instrument->configure(
+            // 添加柱状仪表
+            int index = m_instrumentWall->addInstrument(
+                row,
+                InstrumentWall::Bar,
                 displayFormat.labelInChinese,
                 displayFormat.unit,
-                displayFormat.resolution,
+                precision,
                 displayFormat.minRange,
                 displayFormat.maxRange
             );
 
             // 设置一个初始值，确保显示正确
-            instrument->setValue((displayFormat.minRange + displayFormat.maxRange) / 2);
-
-            // 将仪表添加到行布局
-            rowLayout->addWidget(instrument);
+            m_instrumentWall->setValue(index, (displayFormat.minRange + displayFormat.maxRange) / 2);
 
-            // 存储仪表
-            m_columnarInstruments[acquisitionType].append(instrument);
+            // 存储仪表索引
+            m_instrumentIndices[channelId] = index;
 
             // 输出调试信息
             qDebug() << "创建柱状仪表:"
@@ -1047,34 +1105,21 @@ void MainWindow::createColumnarInstruments(const QMap<QString, QList<QString>>&
                      << "，最小值:" << displayFormat.minRange
                      << "，最大值:" << displayFormat.maxRange;
         }
-
-        // 添加弹簧，确保仪表均匀分布
-        rowLayout->addStretch();
-
-        // 将行布局添加到主布局
-        instrumentLayout->addLayout(rowLayout);
     }
 
-    // 添加弹簧，确保行布局向上对齐
-    instrumentLayout->addStretch();
+    // 同一列宽排布各行，行内仪表宽度一致
+    m_instrumentWall->setMinimumColumns(maxColumns);
+    // 每行保持原来单个柱状仪表的最小高度
+    m_instrumentWall->setMinimumHeight(qMax(1, m_instrumentWall->rowCount()) * 150);
 
-    // 将主布局添加到instrumentGroupBox
-    QWidget* instrumentWidget = new QWidget();
-    instrumentWidget->setLayout(instrumentLayout);
-    ui->instrumentGroupBox->layout()->addWidget(instrumentWidget);
+    // 将仪表墙添加到instrumentGroupBox
+    ui->instrumentGroupBox->layout()->addWidget(m_instrumentWall);
 }
 
-void MainWindow::updateDashboards()
+void MainWindow::updateDashboards(const Core::SynchronizedDataFrame& frame)
 {
-    if (!m_dataProcessor || !m_isAcquiring) {
-        return;
-    }
-
-    // 获取所有通道的最新数据点
-    QMap<QString, QPair<double, double>> latestPoints;
-    QMetaObject::invokeMethod(m_dataProcessor, [this, &latestPoints]() {
-        latestPoints = m_dataProcessor->getLatestDataPoints();
-    }, Qt::BlockingQueuedConnection);
+    // 使用显示调度器本次刷新的同步帧
+    const QMap<QString, Core::ProcessedDataPoint>& latestPoints = frame.channelData;
 
     // 更新仪表盘
     for (auto it = m_mainChannels.constBegin(); it != m_mainChannels.constEnd(); ++it) {
@@ -1082,7 +1127,7 @@ void MainWindow::updateDashboards()
         QString channelId = it.value();
 
         if (latestPoints.contains(channelId)) {
-            double value = latestPoints[channelId].second;
+            double value = latestPoints[channelId].value;
 
             // 根据采集类型更新对应的仪表盘
             if (acquisitionType == "throttle_position" && m_dashboard1) {
@@ -1101,108 +1146,142 @@ void MainWindow::updateDashboards()
     }
 }
 
-void MainWindow::updateInstruments()
+void MainWindow::updateInstruments(const Core::SynchronizedDataFrame& frame)
 {
-    if (!m_dataProcessor || !m_isAcquiring) {
+    if (!m_instrumentWall) {
         return;
     }
 
-    // 获取所有通道的最新数据点
-    QMap<QString, QPair<double, double>> latestPoints;
-    QMetaObject::invokeMethod(m_dataProcessor, [this, &latestPoints]() {
-        latestPoints = m_dataProcessor->getLatestDataPoints();
-    }, Qt::BlockingQueuedConnection);
-
-    // 按采集类型分类通道
-    QMap<QString, QList<QString>> channelsByType = classifyChannelsByAcquisitionType();
-
-    // 更新柱状仪表
-    for (auto typeIt = channelsByType.constBegin(); typeIt != channelsByType.constEnd(); ++typeIt) {
-        QString acquisitionType = typeIt.key();
-        QList<QString> channelIds = typeIt.value();
-
-        // 跳过主要采集量类型（已经在仪表盘中显示）
-        if (m_mainChannels.contains(acquisitionType)) {
-            continue;
-        }
-
-        // 检查该采集类型是否有仪表
-        if (!m_columnarInstruments.contains(acquisitionType) || m_columnarInstruments[acquisitionType].isEmpty()) {
-            continue;
-        }
-
-        // 获取该采集类型的仪表列表
-        QList<ColumnarInstrument*> instruments = m_columnarInstruments[acquisitionType];
-
-        // 遍历该采集类型的所有通道
-        for (int i = 0; i < channelIds.size() && i < instruments.size(); ++i) {
-            QString channelId = channelIds[i];
-            ColumnarInstrument* instrument = instruments[i];
-
-            if (latestPoints.contains(channelId)) {
-                double value = latestPoints[channelId].second;
-                instrument->setValue(value);
-            }
+    // 更新仪表墙，只有指针位置或读数变化的仪表会被重绘
+    for (auto it = m_instrumentIndices.constBegin(); it != m_instrumentIndices.constEnd(); ++it) {
+        auto pointIt = frame.channelData.constFind(it.key());
+        if (pointIt != frame.channelData.constEnd()) {
+            m_instrumentWall->setValue(it.value(), pointIt.value().value);
         }
     }
 }
 
-void MainWindow::updatePlot()
+void MainWindow::renderDisplayFrame(const Core::SynchronizedDataFrame& frame, bool newFrame, double elapsedMs)
 {
     if (!m_dataProcessor || !m_isAcquiring) {
         return;
     }
 
-    // 获取当前时间
-    double currentTime = (QDateTime::currentMSecsSinceEpoch() - m_startTimestamp) / 1000.0;
+    // 有新帧时在同一次刷新中更新曲线、仪表盘和柱状仪表
+    if (newFrame) {
+        m_plotReplotPending = false;
+        updatePlot(frame);
+        updateDashboards(frame);
+        updateInstruments(frame);
+    } else if (m_plotReplotPending) {
+        // 曲线结构变化（如新增通道）但没有新帧，只重绘图表
+        m_plotReplotPending = false;
+        m_plot->replot(QCustomPlot::rpRefreshHint);
+    }
 
-    // 获取所有通道的最新数据点
-    QMap<QString, QPair<double, double>> latestPoints;
-    QMetaObject::invokeMethod(m_dataProcessor, [this, &latestPoints]() {
-        latestPoints = m_dataProcessor->getLatestDataPoints();
-    }, Qt::BlockingQueuedConnection);
+    // 指针动画跟随同一节拍推进，动画未结束时请求下一节拍继续刷新
+    if (advanceDashboardAnimations(elapsedMs)) {
+        m_displayScheduler->requestAnimationFrame();
+    }
+}
 
-    // 更新每个通道的图表
-    for (auto it = m_channelGraphs.begin(); it != m_channelGraphs.end(); ++it) {
-        QString channelId = it.key();
-        QCPGraph* graph = it.value();
+void MainWindow::onDisplayStatisticsUpdated(const DisplayScheduler::Statistics& statistics)
+{
+    // 在状态栏显示UI刷新耗时和合并的帧数
+    ui->statusbar->showMessage(QString("%1 | 刷新间隔 %2 ms | 刷新 %3 次/秒 | 平均耗时 %4 ms | 最大耗时 %5 ms | 合并帧 %6")
+                               .arg(m_plot && m_plot->openGl() ? "OpenGL" : "光栅")
+                               .arg(statistics.intervalMs)
+                               .arg(statistics.renderedFrames)
+                               .arg(statistics.averageFrameMs, 0, 'f', 2)
+                               .arg(statistics.maxFrameMs, 0, 'f', 2)
+                               .arg(statistics.droppedUpdates));
+}
 
-        if (latestPoints.contains(channelId)) {
-            // 获取最新数据点
-            double timestamp = latestPoints[channelId].first;
-            double value = latestPoints[channelId].second;
+bool MainWindow::advanceDashboardAnimations(double elapsedMs)
+{
+    bool animating = false;
 
-            // 计算相对时间戳（秒）
-            double relativeTime = (timestamp - m_startTimestamp) / 1000.0;
+    for (Dashboard* dashboard : {m_dashboard1, m_dashboard2, m_dashboard3, m_dashboard4}) {
+        if (dashboard && dashboard->advanceAnimation(elapsedMs)) {
+            animating = true;
+        }
+    }
 
-            // 添加数据点（使用addData而不是setData）
-            graph->addData(relativeTime, value);
+    return animating;
+}
 
-            // 限制数据点数量
-            // 如果数据点超过显示限制，移除旧数据点
-            if (graph->data()->size() > m_displayPointCount) {
-                // 计算需要保留的最早键值（时间戳）
-                double key = relativeTime - m_timeWindow;
-                graph->data()->removeBefore(key);
+void MainWindow::updatePlot(const Core::SynchronizedDataFrame& frame)
+{
+    // 获取当前时间
+    double currentTime = Core::Timebase::secondsBetween(m_startTimestamp, Core::Timebase::nowNs());
+
+    // 按绘图区像素宽度设置抽取分辨率
+    m_plotFeeder.setResolution(m_timeWindow, qMax(1, m_plot->axisRect()->width()));
+
+    // 把上次刷新以来的新数据点追加到馈送器
+    QVector<qint64> timestamps;
+    QVector<double> values;
+    QVector<double> keys;
+    for (auto it = m_channelGraphs.constBegin(); it != m_channelGraphs.constEnd(); ++it) {
+        const QString& channelId = it.key();
+        const double lastKey = m_plotFeeder.lastKey(channelId);
+
+        // 一次刷新间隔内处理器可能已发布多帧，从通道队列取走最新绘制点之后的全部数据
+        qint64 afterTimestamp = std::isfinite(lastKey)
+                                    ? m_startTimestamp + static_cast<qint64>(std::floor(lastKey * Core::Timebase::NS_PER_SECOND))
+                                    : std::numeric_limits<qint64>::min();
+        if (m_dataProcessor && m_dataProcessor->getChannelDataSince(channelId, afterTimestamp, timestamps, values)) {
+            keys.clear();
+            keys.reserve(timestamps.size());
+            int count = 0;
+            for (int i = 0; i < timestamps.size(); ++i) {
+                double relativeTime = Core::Timebase::secondsBetween(m_startTimestamp, timestamps[i]);
+                if (relativeTime > lastKey) {
+                    keys.append(relativeTime);
+                    values[count++] = values[i];
+                }
             }
+            values.resize(count);
+            m_plotFeeder.appendSamples(channelId, keys, values);
+            continue;
+        }
+
+        // 没有数据队列的通道只能取当前帧里的点
+        auto pointIt = frame.channelData.constFind(channelId);
+        if (pointIt != frame.channelData.constEnd()) {
+            // 计算相对时间戳（秒）
+            double relativeTime = Core::Timebase::secondsBetween(m_startTimestamp, pointIt.value().timestamp);
 
-            // 自动调整X轴范围以显示最新数据
-            double keyRange = qMin(m_timeWindow, currentTime);
-            m_plot->xAxis->setRange(currentTime - keyRange, currentTime);
+            // 同一帧或同一个原始点可能被多次读到，只追加更新的点
+            if (relativeTime > m_plotFeeder.lastKey(channelId)) {
+                m_plotFeeder.append(channelId, relativeTime, pointIt.value().value);
+            }
         }
     }
 
-    // 自动调整Y轴范围
-    m_plot->rescaleAxes();
+    // 自动调整X轴范围以显示最新数据
+    double keyRange = qMin(m_timeWindow, currentTime);
+    m_plot->xAxis->setRange(currentTime - keyRange, currentTime);
+    m_plotFeeder.trimBefore(currentTime - m_timeWindow);
 
-    // 重绘图表
-    m_plot->replot(QCustomPlot::rpQueuedReplot);
+    // 用包络数据整体替换每条曲线的数据
+    for (auto it = m_channelGraphs.constBegin(); it != m_channelGraphs.constEnd(); ++it) {
+        m_plotFeeder.feedGraph(it.key(), it.value());
+    }
 
-    // 更新仪表盘
-    updateDashboards();
+    // 根据增量维护的值范围调整Y轴，代替对全部曲线的rescaleAxes
+    double lower = 0.0;
+    double upper = 0.0;
+    if (m_plotFeeder.valueRange(lower, upper)) {
+        double margin = (upper - lower) * 0.05;
+        if (margin <= 0.0) {
+            margin = qMax(qAbs(upper) * 0.05, 1.0);
+        }
+        m_plot->yAxis->setRange(lower - margin, upper + margin);
+    }
 
-    // 更新仪表
-    updateInstruments();
+    // 重绘图表（调度器已合并刷新，这里同步重绘以便统计真实的刷新耗时）
+    m_plot->replot(QCustomPlot::rpRefreshHint);
 }
 
 void MainWindow::onSyncFrameReady(Core::SynchronizedDataFrame frame)
@@ -1211,12 +1290,12 @@ void MainWindow::onSyncFrameReady(Core::SynchronizedDataFrame frame)
     QString timeStr = frame.getFormattedTimestamp();
 
     // 计算相对时间（秒）
-    double relativeTime = (frame.timestamp - m_startTimestamp) / 1000.0;
+    double relativeTime = Core::Timebase::secondsBetween(m_startTimestamp, frame.timestamp);
 
     // 输出同步数据帧信息
     // qDebug() << "同步数据帧 [" << timeStr << "] 通道数量:" << frame.channelData.size();
 
-    // 注意：不再在这里更新图表，而是在updatePlot方法中统一更新
+    // 注意：不再在这里更新图表，而是由显示调度器在每个节拍统一更新
     // 这样可以减少UI线程的负担，提高性能
 }
 
@@ -11,6 +11,11 @@
 #include "plot/qcustomplot.h"
 #include "plot/dashboard.h"
 #include "plot/columnarinstrument.h"
+#include "plot/instrumentwall.h"
+#include "plot/plotdatafeeder.h"
+#include "plot/displayscheduler.h"
+#include "plot/diagnosticspanel.h"
+#include "Core/Log.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -54,8 +59,10 @@ public slots:
 private slots:
     // 控制采集的槽
     void onStartStopButtonClicked();
-    // 更新图表的槽
-    void updatePlot();
+    // 显示调度器节拍：在一次刷新中更新曲线、仪表盘和柱状仪表
+    void renderDisplayFrame(const Core::SynchronizedDataFrame& frame, bool newFrame, double elapsedMs);
+    // 显示刷新统计
+    void onDisplayStatisticsUpdated(const DisplayScheduler::Statistics& statistics);
 
 private:
     void initializeConfig();
@@ -81,9 +88,12 @@ private:
     // 创建柱状仪表
     void createColumnarInstruments(const QMap<QString, QList<QString>>& channelsByType);
 
-    // 更新仪表盘和仪表
-    void updateDashboards();
-    void updateInstruments();
+    // 更新图表、仪表盘和仪表
+    void updatePlot(const Core::SynchronizedDataFrame& frame);
+    void updateDashboards(const Core::SynchronizedDataFrame& frame);
+    void updateInstruments(const Core::SynchronizedDataFrame& frame);
+    // 推进仪表盘指针动画，返回是否仍有动画
+    bool advanceDashboardAnimations(double elapsedMs);
 
     // 窗口大小变化事件处理
     void resizeEvent(QResizeEvent *event) override;
@@ -108,18 +118,25 @@ private:
     Dashboard *m_dashboard3;  // 发动机力矩
     Dashboard *m_dashboard4;  // 发动机功率
 
-    // 柱状仪表组件
-    QMap<QString, QList<ColumnarInstrument*>> m_columnarInstruments;  // 采集类型 -> 仪表列表
+    // 柱状仪表组件（全部绘制在同一个仪表墙上）
+    InstrumentWall *m_instrumentWall;                                  // 仪表墙
+    QMap<QString, int> m_instrumentIndices;                            // 通道ID -> 仪表墙中的仪表索引
 
     // 主要采集量通道映射
     QMap<QString, QString> m_mainChannels;  // 采集类型 -> 通道ID
 
     // 数据和状态
     QMap<QString, QCPGraph*> m_channelGraphs;  // 通道ID -> 图表对象
+    PlotDataFeeder m_plotFeeder;               // 曲线数据馈送器（像素列最小/最大值抽取）
     bool m_isAcquiring;                        // 是否正在采集
-    QTimer *m_plotUpdateTimer;                 // 图表更新定时器
-    qint64 m_startTimestamp;                   // 采集开始时间戳
+    DisplayScheduler *m_displayScheduler;      // 显示调度器（唯一的UI刷新节拍）
+    bool m_plotReplotPending;                  // 曲线结构变化，等待下一次调度刷新时重绘
+    QTimer *m_logFlushTimer;                   // 环形日志输出定时器
+    DiagnosticsPanel *m_diagnosticsPanel;      // 性能诊断面板（独立窗口）
+    qint64 m_startTimestamp;                   // 采集开始时间戳（Core::Timebase纳秒）
     int m_displayPointCount;                   // 显示点数
     double m_timeWindow;                       // 时间窗口（秒）
+
+    static constexpr int LOG_FLUSH_INTERVAL_MS = 200;  // 环形日志输出周期
 };
 #endif // MAINWINDOW_H
@@ -130,7 +130,9 @@ void Dashboard::setValue(double value)
             m_animationStep = (m_maxValue - m_minValue) / 100.0; // e.g., 1% of range per step
             m_animationStep = qMax(0.1, m_animationStep); // Ensure minimum step
 
-            m_animationTimer->start();
+            if (!m_externalAnimationClock) {
+                m_animationTimer->start();
+            }
         } else {
             m_currentValue = m_value;
              if (m_animationTimer->isActive()) m_animationTimer->stop();
@@ -269,27 +271,37 @@ void Dashboard::paintEvent(QPaintEvent *event)
 // --- Animation Slot ---
 void Dashboard::updateAnimation()
 {
-    if (!qFuzzyCompare(m_currentValue, m_value)) {
-        double step = m_animationStep;
-        if (m_currentValue < m_value) {
-            m_currentValue += step;
-            if (m_currentValue >= m_value) {
-                m_currentValue = m_value;
-                m_animationTimer->stop();
-            }
-        } else {
-            m_currentValue -= step;
-            if (m_currentValue <= m_value) {
-                m_currentValue = m_value;
-                m_animationTimer->stop();
-            }
-        }
-        update(); // Trigger repaint for pointer movement
-    } else {
+    if (!advanceAnimation(m_animationTimer->interval())) {
         m_animationTimer->stop();
     }
 }
 
+void Dashboard::setExternalAnimationClock(bool external)
+{
+    m_externalAnimationClock = external;
+    if (external && m_animationTimer->isActive()) {
+        m_animationTimer->stop();
+    }
+}
+
+bool Dashboard::advanceAnimation(double elapsedMs)
+{
+    if (qFuzzyCompare(m_currentValue, m_value)) {
+        return false;
+    }
+
+    // 步长按内部定时器的20ms节拍折算，外部调度器间隔变化时指针速度保持不变
+    double step = m_animationStep * qMax(1.0, elapsedMs / 20.0);
+    if (m_currentValue < m_value) {
+        m_currentValue = qMin(m_currentValue + step, m_value);
+    } else {
+        m_currentValue = qMax(m_currentValue - step, m_value);
+    }
+    update(); // Trigger repaint for pointer movement
+
+    return !qFuzzyCompare(m_currentValue, m_value);
+}
+
 // --- Static Cache Update ---
 void Dashboard::updateStaticCache()
 {
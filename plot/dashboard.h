@@ -101,6 +101,11 @@ public:
     // 新增 configure 方法
     Q_INVOKABLE void configure(const QString &label, const QString &unit, int precision, double minRange, double maxRange);
 
+    // 由外部显示调度器驱动动画（不再使用内部20ms定时器）
+    void setExternalAnimationClock(bool external);
+    // 推进一步指针动画，elapsedMs为距上次推进的时间，返回动画是否仍在进行
+    bool advanceAnimation(double elapsedMs);
+
 public slots:
     // 设置用于公式计算的变量值
     // void setVariableValues(const QMap<QString, double> &variables);
@@ -169,6 +174,7 @@ private:
     bool m_animationEnabled = true; // 替换 m_animation
     QTimer *m_animationTimer;    // 替换 m_timer
     double m_animationStep = 1.0; // 固定的步长或基于范围的计算
+    bool m_externalAnimationClock = false; // 是否由外部调度器驱动动画
 
     // 刻度相关
     int m_scaleMinorTicks = 5; // 小刻度数量 (每大格)
@@ -0,0 +1,217 @@
+#include "diagnosticspanel.h"
+#include "../Core/Log.h"
+#include "../Core/LatencyTrace.h"
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFileDialog>
+#include <QCoreApplication>
+#include <QDateTime>
+
+DiagnosticsPanel::DiagnosticsPanel(QWidget *parent)
+    : QWidget(parent, Qt::Window)
+    , m_stageTable(new QTableWidget(Core::Metrics::STAGE_COUNT, 8, this))
+    , m_counterTable(new QTableWidget(Core::Metrics::COUNTER_COUNT + Core::Metrics::GAUGE_COUNT, 3, this))
+    , m_latencyTable(new QTableWidget(0, 7, this))
+    , m_traceButton(new QPushButton(this))
+    , m_enabledCheckBox(new QCheckBox("启用统计", this))
+    , m_summaryLabel(new QLabel(this))
+    , m_timer(new QTimer(this))
+{
+    setWindowTitle("性能诊断");
+    resize(820, 720);
+
+    m_stageTable->setHorizontalHeaderLabels({"阶段", "次数/秒", "平均(us)", "P50(us)", "P90(us)", "P99(us)", "P99.9(us)", "最大(us)"});
+    m_stageTable->verticalHeader()->setVisible(false);
+    m_stageTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_stageTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    for (int stage = 0; stage < Core::Metrics::STAGE_COUNT; ++stage) {
+        setCell(m_stageTable, stage, 0, Core::Metrics::stageName(static_cast<Core::Metrics::Stage>(stage)));
+    }
+
+    m_counterTable->setHorizontalHeaderLabels({"指标", "速率/秒", "累计/当前值"});
+    m_counterTable->verticalHeader()->setVisible(false);
+    m_counterTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_counterTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    for (int i = 0; i < Core::Metrics::COUNTER_COUNT; ++i) {
+        setCell(m_counterTable, i, 0, Core::Metrics::counterName(static_cast<Core::Metrics::Counter>(i)));
+    }
+    for (int i = 0; i < Core::Metrics::GAUGE_COUNT; ++i) {
+        setCell(m_counterTable, Core::Metrics::COUNTER_COUNT + i, 0,
+                Core::Metrics::gaugeName(static_cast<Core::Metrics::Gauge>(i)));
+    }
+
+    m_latencyTable->setHorizontalHeaderLabels({"设备", "路径", "次数", "平均(us)", "P50(us)", "P99(us)", "最大(us)"});
+    m_latencyTable->verticalHeader()->setVisible(false);
+    m_latencyTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_latencyTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+
+    m_enabledCheckBox->setChecked(Core::Metrics::isEnabled());
+    connect(m_enabledCheckBox, &QCheckBox::toggled, this, [](bool checked) {
+        Core::Metrics::setEnabled(checked);
+    });
+
+    QPushButton *saveButton = new QPushButton("保存快照...", this);
+    connect(saveButton, &QPushButton::clicked, this, &DiagnosticsPanel::saveSnapshot);
+
+    m_traceButton->setText(Core::LatencyTrace::isTracing() ? "停止跟踪" : "开始跟踪");
+    connect(m_traceButton, &QPushButton::clicked, this, &DiagnosticsPanel::toggleTrace);
+
+    QPushButton *exportTraceButton = new QPushButton("导出跟踪...", this);
+    connect(exportTraceButton, &QPushButton::clicked, this, &DiagnosticsPanel::exportTrace);
+
+    QPushButton *resetLatencyButton = new QPushButton("重置延迟统计", this);
+    connect(resetLatencyButton, &QPushButton::clicked, this, [this]() {
+        Core::LatencyTrace::reset();
+        refreshLatencyTable();
+    });
+
+    QHBoxLayout *toolLayout = new QHBoxLayout();
+    toolLayout->addWidget(m_enabledCheckBox);
+    toolLayout->addWidget(m_summaryLabel, 1);
+    toolLayout->addWidget(saveButton);
+
+    QHBoxLayout *traceLayout = new QHBoxLayout();
+    traceLayout->addWidget(new QLabel("端到端延迟（自上次重置）", this), 1);
+    traceLayout->addWidget(resetLatencyButton);
+    traceLayout->addWidget(m_traceButton);
+    traceLayout->addWidget(exportTraceButton);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addLayout(toolLayout);
+    layout->addWidget(m_stageTable, 3);
+    layout->addWidget(m_counterTable, 2);
+    layout->addLayout(traceLayout);
+    layout->addWidget(m_latencyTable, 3);
+
+    m_timer->setInterval(REFRESH_INTERVAL_MS);
+    connect(m_timer, &QTimer::timeout, this, &DiagnosticsPanel::refresh);
+}
+
+void DiagnosticsPanel::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+
+    // 从打开面板时开始统计最近一秒
+    m_previous = Core::Metrics::snapshot();
+    m_timer->start();
+}
+
+void DiagnosticsPanel::hideEvent(QHideEvent *event)
+{
+    m_timer->stop();
+    QWidget::hideEvent(event);
+}
+
+void DiagnosticsPanel::refresh()
+{
+    const Core::Metrics::Snapshot current = Core::Metrics::snapshot();
+    const Core::Metrics::Snapshot interval = current - m_previous;
+    const double seconds = qMax(1e-3, Core::Timebase::secondsBetween(m_previous.timestampNs, current.timestampNs));
+    m_previous = current;
+
+    for (int stage = 0; stage < Core::Metrics::STAGE_COUNT; ++stage) {
+        const Core::Metrics::Histogram &histogram = interval.stages[stage];
+        setCell(m_stageTable, stage, 1, QString::number(histogram.count / seconds, 'f', 1));
+        setCell(m_stageTable, stage, 2, QString::number(histogram.meanUs(), 'f', 1));
+        setCell(m_stageTable, stage, 3, QString::number(histogram.percentileUs(50.0), 'f', 1));
+        setCell(m_stageTable, stage, 4, QString::number(histogram.percentileUs(90.0), 'f', 1));
+        setCell(m_stageTable, stage, 5, QString::number(histogram.percentileUs(99.0), 'f', 1));
+        setCell(m_stageTable, stage, 6, QString::number(histogram.percentileUs(99.9), 'f', 1));
+        setCell(m_stageTable, stage, 7, QString::number(histogram.maxUs(), 'f', 1));
+    }
+
+    for (int i = 0; i < Core::Metrics::COUNTER_COUNT; ++i) {
+        setCell(m_counterTable, i, 1, QString::number(interval.counters[i] / seconds, 'f', 1));
+        setCell(m_counterTable, i, 2, QString::number(current.counters[i]));
+    }
+    for (int i = 0; i < Core::Metrics::GAUGE_COUNT; ++i) {
+        setCell(m_counterTable, Core::Metrics::COUNTER_COUNT + i, 1, "-");
+        setCell(m_counterTable, Core::Metrics::COUNTER_COUNT + i, 2, QString::number(current.gauges[i]));
+    }
+
+    refreshLatencyTable();
+
+    m_summaryLabel->setText(QString("统计周期 %1 秒 | 环形日志丢失 %2 条 | 跟踪事件 %3")
+                                .arg(seconds, 0, 'f', 2)
+                                .arg(Core::RingLog::instance().lostCount())
+                                .arg(Core::LatencyTrace::traceEventCount()));
+}
+
+void DiagnosticsPanel::refreshLatencyTable()
+{
+    const QVector<Core::LatencyTrace::DeviceLatency> devices = Core::LatencyTrace::snapshot();
+    m_latencyTable->setRowCount(devices.size() * Core::LatencyTrace::PATH_COUNT);
+
+    int row = 0;
+    for (const Core::LatencyTrace::DeviceLatency &device : devices) {
+        for (int path = 0; path < Core::LatencyTrace::PATH_COUNT; ++path, ++row) {
+            const Core::Metrics::Histogram &histogram = device.paths[path];
+            setCell(m_latencyTable, row, 0, device.deviceId);
+            setCell(m_latencyTable, row, 1, Core::LatencyTrace::pathName(static_cast<Core::LatencyTrace::Path>(path)));
+            setCell(m_latencyTable, row, 2, QString::number(histogram.count));
+            setCell(m_latencyTable, row, 3, QString::number(histogram.meanUs(), 'f', 1));
+            setCell(m_latencyTable, row, 4, QString::number(histogram.percentileUs(50.0), 'f', 1));
+            setCell(m_latencyTable, row, 5, QString::number(histogram.percentileUs(99.0), 'f', 1));
+            setCell(m_latencyTable, row, 6, QString::number(histogram.maxUs(), 'f', 1));
+        }
+    }
+}
+
+void DiagnosticsPanel::toggleTrace()
+{
+    if (Core::LatencyTrace::isTracing()) {
+        Core::LatencyTrace::stopTrace();
+        m_traceButton->setText("开始跟踪");
+    } else {
+        Core::LatencyTrace::startTrace();
+        m_traceButton->setText("停止跟踪");
+    }
+}
+
+void DiagnosticsPanel::exportTrace()
+{
+    const QString defaultPath = QCoreApplication::applicationDirPath() + "/latency_trace_"
+                                + QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + ".json";
+    const QString filePath = QFileDialog::getSaveFileName(this, "导出延迟跟踪", defaultPath, "Chrome跟踪文件 (*.json)");
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    if (Core::LatencyTrace::exportTrace(filePath)) {
+        m_summaryLabel->setText("已导出: " + filePath);
+    } else {
+        m_summaryLabel->setText("导出失败: " + filePath);
+    }
+}
+
+void DiagnosticsPanel::saveSnapshot()
+{
+    const QString defaultPath = QCoreApplication::applicationDirPath() + "/metrics_"
+                                + QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + ".json";
+    const QString filePath = QFileDialog::getSaveFileName(this, "保存性能指标", defaultPath, "JSON文件 (*.json)");
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    if (Core::Metrics::dumpToFile(filePath, Core::Metrics::snapshot())) {
+        m_summaryLabel->setText("已保存: " + filePath);
+    } else {
+        m_summaryLabel->setText("保存失败: " + filePath);
+    }
+}
+
+void DiagnosticsPanel::setCell(QTableWidget *table, int row, int column, const QString &text)
+{
+    QTableWidgetItem *item = table->item(row, column);
+    if (!item) {
+        item = new QTableWidgetItem();
+        item->setTextAlignment(column == 0 ? Qt::AlignLeft | Qt::AlignVCenter : Qt::AlignRight | Qt::AlignVCenter);
+        table->setItem(row, column, item);
+    }
+    item->setText(text);
+}
@@ -0,0 +1,54 @@
+#ifndef DIAGNOSTICSPANEL_H
+#define DIAGNOSTICSPANEL_H
+
+#include <QWidget>
+#include <QTimer>
+#include "../Core/Metrics.h"
+
+class QTableWidget;
+class QCheckBox;
+class QLabel;
+class QPushButton;
+
+/**
+ * @brief 性能诊断面板
+ * 每秒读取一次Core::Metrics快照，显示最近一秒各流水线阶段的次数和耗时分位数、
+ * 计数器速率和测量值；可把自启动以来的累计快照保存为JSON文件。
+ * 另按设备显示采集到处理器/同步帧/存储/屏幕的端到端延迟，可录制并导出Chrome跟踪文件。
+ * 只在面板可见时刷新。
+ */
+class DiagnosticsPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsPanel(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private slots:
+    void refresh();
+    void saveSnapshot();
+    void toggleTrace();
+    void exportTrace();
+
+private:
+    void setCell(QTableWidget *table, int row, int column, const QString &text);
+    void refreshLatencyTable();
+
+    QTableWidget *m_stageTable;      // 阶段耗时
+    QTableWidget *m_counterTable;    // 计数器和测量值
+    QTableWidget *m_latencyTable;    // 按设备的端到端延迟
+    QPushButton *m_traceButton;
+    QCheckBox *m_enabledCheckBox;
+    QLabel *m_summaryLabel;
+    QTimer *m_timer;
+
+    Core::Metrics::Snapshot m_previous;   // 上一次的累计快照
+
+    static constexpr int REFRESH_INTERVAL_MS = 1000;
+};
+
+#endif // DIAGNOSTICSPANEL_H
@@ -0,0 +1,175 @@
+#include "displayscheduler.h"
+#include "../Processing/DataProcessor.h"
+#include "../Core/Metrics.h"
+#include "../Core/LatencyTrace.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <QDebug>
+#include <cmath>
+
+DisplayScheduler::DisplayScheduler(Processing::DataProcessor *processor, QObject *parent)
+    : QObject(parent)
+    , m_processor(processor)
+    , m_timer(new QTimer(this))
+    , m_lastSequence(0)
+    , m_animationPending(false)
+    , m_minIntervalMs(16)
+    , m_maxIntervalMs(200)
+    , m_averageFrameMs(0.0)
+    , m_frameTimeSumMs(0.0)
+{
+    // 最小间隔取屏幕刷新周期，刷新频率不超过显示器
+    if (QScreen *screen = QGuiApplication::primaryScreen()) {
+        if (screen->refreshRate() > 1.0) {
+            m_minIntervalMs = qMax(1, static_cast<int>(std::ceil(1000.0 / screen->refreshRate())));
+        }
+    }
+
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(m_minIntervalMs);
+    connect(m_timer, &QTimer::timeout, this, &DisplayScheduler::onTick);
+}
+
+void DisplayScheduler::setIntervalRange(int minIntervalMs, int maxIntervalMs)
+{
+    if (minIntervalMs <= 0 || maxIntervalMs < minIntervalMs) {
+        return;
+    }
+
+    m_minIntervalMs = minIntervalMs;
+    m_maxIntervalMs = maxIntervalMs;
+    m_timer->setInterval(qBound(m_minIntervalMs, m_timer->interval(), m_maxIntervalMs));
+}
+
+void DisplayScheduler::start()
+{
+    resetFrame();
+    m_animationPending = false;
+    m_averageFrameMs = 0.0;
+    m_statistics = Statistics();
+    m_frameTimeSumMs = 0.0;
+
+    m_timer->setInterval(m_minIntervalMs);
+    m_sinceLastRender.start();
+    m_sinceLastReport.start();
+    m_timer->start();
+}
+
+void DisplayScheduler::stop()
+{
+    m_timer->stop();
+    resetFrame();
+}
+
+bool DisplayScheduler::isActive() const
+{
+    return m_timer->isActive();
+}
+
+int DisplayScheduler::intervalMs() const
+{
+    return m_timer->interval();
+}
+
+void DisplayScheduler::requestAnimationFrame()
+{
+    m_animationPending = true;
+}
+
+void DisplayScheduler::onTick()
+{
+    // 取最新帧，期间到达的其余帧被合并
+    bool newFrame = m_processor && m_processor->readLatestFrame(m_frame);
+    if (newFrame) {
+        if (m_lastSequence > 0 && m_frame.sequence > m_lastSequence + 1) {
+            m_statistics.droppedUpdates += m_frame.sequence - m_lastSequence - 1;
+        }
+        m_lastSequence = m_frame.sequence;
+    }
+
+    if (!newFrame && !m_animationPending) {
+        ++m_statistics.idleTicks;
+        if (m_sinceLastReport.elapsed() >= REPORT_INTERVAL_MS) {
+            reportStatistics();
+        }
+        return;
+    }
+    m_animationPending = false;
+
+    double elapsedMs = m_sinceLastRender.nsecsElapsed() / 1e6;
+    m_sinceLastRender.restart();
+
+    QElapsedTimer renderTimer;
+    renderTimer.start();
+    emit renderRequested(m_frame, newFrame, elapsedMs);
+    const qint64 frameNs = renderTimer.nsecsElapsed();
+    double frameMs = frameNs / 1e6;
+    Core::Metrics::recordLatency(Core::Metrics::UiRefresh, frameNs);
+    Core::Metrics::increment(Core::Metrics::UiRefreshes);
+
+    // 新帧刷新完成后记录采集到屏幕的延迟
+    if (newFrame) {
+        Core::LatencyTrace::recordFrame(Core::LatencyTrace::AcquisitionToScreen, m_frame, Core::Timebase::nowNs());
+    }
+
+    ++m_statistics.renderedFrames;
+    m_frameTimeSumMs += frameMs;
+    m_statistics.maxFrameMs = qMax(m_statistics.maxFrameMs, frameMs);
+
+    adaptInterval(frameMs);
+    Core::Metrics::setGauge(Core::Metrics::UiIntervalMs, m_timer->interval());
+
+    if (m_sinceLastReport.elapsed() >= REPORT_INTERVAL_MS) {
+        reportStatistics();
+    }
+}
+
+void DisplayScheduler::resetFrame()
+{
+    // 取走三缓冲中上一轮发布但尚未显示的帧并丢弃，重新开始后的第一次刷新不会显示旧数据
+    if (m_processor) {
+        m_processor->readLatestFrame(m_frame);
+    }
+    m_frame = Core::SynchronizedDataFrame();
+    m_lastSequence = 0;
+}
+
+void DisplayScheduler::adaptInterval(double frameMs)
+{
+    m_averageFrameMs = m_averageFrameMs <= 0.0
+        ? frameMs
+        : m_averageFrameMs + AVERAGE_WEIGHT * (frameMs - m_averageFrameMs);
+
+    int interval = m_timer->interval();
+    double budgetMs = interval * RENDER_BUDGET;
+
+    // 刷新耗时超过预算时放慢节拍，留给事件处理的时间；耗时很低时逐步恢复
+    if (m_averageFrameMs > budgetMs && interval < m_maxIntervalMs) {
+        interval = qMin(m_maxIntervalMs, static_cast<int>(std::ceil(interval * 1.25)));
+        m_timer->setInterval(interval);
+    } else if (m_averageFrameMs < budgetMs * 0.5 && interval > m_minIntervalMs) {
+        interval = qMax(m_minIntervalMs, static_cast<int>(interval * 0.9));
+        m_timer->setInterval(interval);
+    }
+}
+
+void DisplayScheduler::reportStatistics()
+{
+    m_statistics.intervalMs = m_timer->interval();
+    m_statistics.averageFrameMs = m_statistics.renderedFrames > 0
+        ? m_frameTimeSumMs / m_statistics.renderedFrames
+        : 0.0;
+
+    emit statisticsUpdated(m_statistics);
+
+    qDebug() << "显示刷新统计 - 节拍间隔:" << m_statistics.intervalMs << "毫秒"
+             << "刷新次数:" << m_statistics.renderedFrames
+             << "平均耗时:" << m_statistics.averageFrameMs << "毫秒"
+             << "最大耗时:" << m_statistics.maxFrameMs << "毫秒"
+             << "合并帧数:" << m_statistics.droppedUpdates
+             << "空闲节拍:" << m_statistics.idleTicks;
+
+    m_statistics = Statistics();
+    m_frameTimeSumMs = 0.0;
+    m_sinceLastReport.restart();
+}
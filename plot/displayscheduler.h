@@ -0,0 +1,120 @@
+#ifndef DISPLAYSCHEDULER_H
+#define DISPLAYSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "../Core/DataTypes.h"
+
+namespace Processing {
+class DataProcessor;
+}
+
+/**
+ * @brief 显示调度器
+ * UI线程唯一的刷新节拍：每个节拍从DataProcessor的无锁三缓冲取一次最新帧，
+ * 把上一节拍以来到达的多帧合并为一次刷新，曲线、仪表盘和柱状仪表在同一次刷新中更新。
+ * 没有新帧且没有动画时跳过刷新；根据刷新耗时自适应调整节拍间隔。
+ */
+class DisplayScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief 刷新统计
+     */
+    struct Statistics {
+        int intervalMs = 0;            // 当前节拍间隔（毫秒）
+        quint64 renderedFrames = 0;    // 统计周期内的刷新次数
+        quint64 droppedUpdates = 0;    // 统计周期内被合并（未单独显示）的处理器帧数
+        quint64 idleTicks = 0;         // 统计周期内无事可做而跳过的节拍数
+        double averageFrameMs = 0.0;   // 平均刷新耗时（毫秒）
+        double maxFrameMs = 0.0;       // 最大刷新耗时（毫秒）
+    };
+
+    /**
+     * @brief 构造函数
+     * @param processor 数据处理器（提供无锁最新帧）
+     * @param parent 父对象
+     */
+    explicit DisplayScheduler(Processing::DataProcessor *processor, QObject *parent = nullptr);
+
+    /**
+     * @brief 设置节拍间隔范围
+     * @param minIntervalMs 最小间隔（默认按屏幕刷新率）
+     * @param maxIntervalMs 最大间隔
+     */
+    void setIntervalRange(int minIntervalMs, int maxIntervalMs);
+
+    /**
+     * @brief 开始调度（清空上一轮的帧和统计）
+     */
+    void start();
+
+    /**
+     * @brief 停止调度（丢弃尚未取走的帧）
+     */
+    void stop();
+
+    /**
+     * @brief 是否正在调度
+     */
+    bool isActive() const;
+
+    /**
+     * @brief 当前节拍间隔（毫秒）
+     */
+    int intervalMs() const;
+
+public slots:
+    /**
+     * @brief 请求下一个节拍即使没有新帧也刷新（用于推进动画）
+     */
+    void requestAnimationFrame();
+
+signals:
+    /**
+     * @brief 刷新请求（同线程直接调用，调度器据此测量刷新耗时）
+     * @param frame 最新同步帧
+     * @param newFrame 是否是上次刷新以来的新帧
+     * @param elapsedMs 距上次刷新的时间（毫秒）
+     */
+    void renderRequested(const Core::SynchronizedDataFrame &frame, bool newFrame, double elapsedMs);
+
+    /**
+     * @brief 刷新统计更新（每秒一次）
+     * @param statistics 统计数据
+     */
+    void statisticsUpdated(const DisplayScheduler::Statistics &statistics);
+
+private slots:
+    void onTick();
+
+private:
+    void resetFrame();
+    void adaptInterval(double frameMs);
+    void reportStatistics();
+
+    Processing::DataProcessor *m_processor;
+    QTimer *m_timer;
+    QElapsedTimer m_sinceLastRender;      // 距上次刷新
+    QElapsedTimer m_sinceLastReport;      // 距上次统计输出
+
+    Core::SynchronizedDataFrame m_frame;  // 最新同步帧
+    quint64 m_lastSequence;               // 上次刷新的帧序号
+    bool m_animationPending;              // 是否有动画待推进
+
+    int m_minIntervalMs;
+    int m_maxIntervalMs;
+    double m_averageFrameMs;              // 刷新耗时的指数滑动平均
+
+    Statistics m_statistics;              // 当前统计周期
+    double m_frameTimeSumMs;              // 当前统计周期的刷新耗时和
+
+    static constexpr double RENDER_BUDGET = 0.5;       // 刷新耗时占节拍间隔的上限
+    static constexpr double AVERAGE_WEIGHT = 0.2;      // 滑动平均权重
+    static constexpr int REPORT_INTERVAL_MS = 1000;    // 统计输出周期
+};
+
+#endif // DISPLAYSCHEDULER_H
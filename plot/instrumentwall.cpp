@@ -0,0 +1,453 @@
+#include "instrumentwall.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QResizeEvent>
+#include <QApplication>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr int CELL_MARGIN = 3;          // 单元格内边距
+constexpr int GAUGE_INFO_HEIGHT = 24;   // 圆形仪表底部信息栏高度
+constexpr int BAR_SCALE_WIDTH = 30;     // 柱状仪表刻度区宽度
+constexpr int BAR_MARGIN = 5;           // 柱状仪表上下边距
+constexpr int BAR_TEXT_RATIO = 40;      // 柱状仪表文字区占单元格宽度的百分比
+constexpr int INDICATOR_HEIGHT = 3;     // 指示线粗细
+constexpr int INDICATOR_OVERHANG = 4;   // 指示线超出柱体的长度
+}
+
+InstrumentWall::InstrumentWall(QWidget *parent)
+    : QWidget(parent)
+{
+    m_scaleFont = QApplication::font();
+    m_scaleFont.setPointSize(qMax(6, m_scaleFont.pointSize() - 2));
+
+    m_labelFont = QApplication::font();
+
+    m_valueFont = QApplication::font();
+    m_valueFont.setBold(true);
+
+    // 整个控件由paintEvent完全覆盖，无需Qt预先擦除背景
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(150, 100);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+int InstrumentWall::addRow()
+{
+    m_rows.append(QVector<int>());
+    return m_rows.size() - 1;
+}
+
+int InstrumentWall::addInstrument(int row, InstrumentKind kind, const QString &label, const QString &unit,
+                                  int precision, double minRange, double maxRange)
+{
+    while (row < 0 || row >= m_rows.size()) {
+        row = addRow();
+    }
+
+    Instrument instrument;
+    instrument.kind = kind;
+    instrument.label = label;
+    instrument.unit = unit;
+    instrument.precision = qMax(0, precision);
+    instrument.minValue = minRange < maxRange ? minRange : 0.0;
+    instrument.maxValue = minRange < maxRange ? maxRange : 100.0;
+    instrument.value = instrument.minValue;
+    instrument.row = row;
+    instrument.drawnPosition = -1;
+
+    m_instruments.append(instrument);
+    m_rows[row].append(m_instruments.size() - 1);
+
+    m_atlasDirty = true;
+    layoutInstruments();
+    update();
+
+    return m_instruments.size() - 1;
+}
+
+void InstrumentWall::clear()
+{
+    m_instruments.clear();
+    m_rows.clear();
+    m_atlasDirty = true;
+    update();
+}
+
+int InstrumentWall::instrumentCount() const
+{
+    return m_instruments.size();
+}
+
+int InstrumentWall::rowCount() const
+{
+    return m_rows.size();
+}
+
+void InstrumentWall::setMinimumColumns(int columns)
+{
+    m_minimumColumns = qMax(1, columns);
+    m_atlasDirty = true;
+    layoutInstruments();
+    update();
+}
+
+void InstrumentWall::setValue(int index, double value)
+{
+    if (index < 0 || index >= m_instruments.size()) {
+        return;
+    }
+
+    Instrument &instrument = m_instruments[index];
+    double clampedValue = std::clamp(value, instrument.minValue, instrument.maxValue);
+    if (instrument.value == clampedValue) {
+        return;
+    }
+    instrument.value = clampedValue;
+
+    // 指针移动不到半度/一个像素时不重绘
+    int position = needlePosition(instrument);
+    if (position != instrument.drawnPosition) {
+        QRect newRect = needleBounds(instrument, position);
+        update(instrument.needleRect.united(newRect));
+        instrument.drawnPosition = position;
+        instrument.needleRect = newRect;
+    }
+
+    // 读数文本不变时不重绘
+    QString text = readoutText(instrument);
+    if (text != instrument.drawnText) {
+        update(instrument.readoutRect);
+        instrument.drawnText = text;
+    }
+}
+
+double InstrumentWall::value(int index) const
+{
+    if (index < 0 || index >= m_instruments.size()) {
+        return 0.0;
+    }
+    return m_instruments[index].value;
+}
+
+void InstrumentWall::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_atlasDirty = true;
+    layoutInstruments();
+}
+
+void InstrumentWall::paintEvent(QPaintEvent *event)
+{
+    if (m_atlasDirty || m_atlas.size() != size() * devicePixelRatioF()) {
+        updateAtlas();
+    }
+
+    QPainter painter(this);
+    const QRegion &region = event->region();
+    const qreal dpr = m_atlas.devicePixelRatio();
+
+    // 只从图集拷贝脏区域
+    for (const QRect &rect : region) {
+        QRect source(QPoint(qRound(rect.x() * dpr), qRound(rect.y() * dpr)),
+                     QSize(qRound(rect.width() * dpr), qRound(rect.height() * dpr)));
+        painter.drawPixmap(rect, m_atlas, source);
+    }
+
+    // 只绘制与脏区域相交的仪表的动态部分（painter已按脏区域裁剪）
+    painter.setRenderHint(QPainter::Antialiasing);
+    for (const Instrument &instrument : m_instruments) {
+        if (region.intersects(instrument.cellRect)) {
+            drawDynamic(&painter, instrument);
+        }
+    }
+}
+
+void InstrumentWall::layoutInstruments()
+{
+    if (m_rows.isEmpty()) {
+        return;
+    }
+
+    int rowHeight = height() / m_rows.size();
+
+    for (int row = 0; row < m_rows.size(); ++row) {
+        const QVector<int> &indices = m_rows[row];
+        int columns = qMax(indices.size(), m_minimumColumns);
+        int cellWidth = width() / qMax(1, columns);
+
+        for (int column = 0; column < indices.size(); ++column) {
+            Instrument &instrument = m_instruments[indices[column]];
+            instrument.cellRect = QRect(column * cellWidth, row * rowHeight, cellWidth, rowHeight)
+                                      .adjusted(CELL_MARGIN, CELL_MARGIN, -CELL_MARGIN, -CELL_MARGIN);
+
+            const QRect &cell = instrument.cellRect;
+            if (instrument.kind == Gauge) {
+                int side = qMax(0, qMin(cell.width(), cell.height() - GAUGE_INFO_HEIGHT));
+                instrument.faceRect = QRect(cell.x() + (cell.width() - side) / 2, cell.y(), side, side);
+                // 信息栏左半部分为静态标签，右半部分为读数
+                instrument.readoutRect = QRect(cell.x() + cell.width() / 2, cell.bottom() - GAUGE_INFO_HEIGHT + 1,
+                                               cell.width() - cell.width() / 2, GAUGE_INFO_HEIGHT);
+            } else {
+                int drawingWidth = cell.width() * (100 - BAR_TEXT_RATIO) / 100;
+                instrument.faceRect = QRect(cell.x(), cell.y(), drawingWidth, cell.height());
+                // 文字区上半部分为静态标签，下半部分为读数
+                instrument.readoutRect = QRect(cell.x() + drawingWidth, cell.center().y(),
+                                               cell.width() - drawingWidth, cell.bottom() - cell.center().y());
+            }
+
+            refreshDrawnState(instrument);
+        }
+    }
+}
+
+void InstrumentWall::updateAtlas()
+{
+    layoutInstruments();
+
+    const qreal dpr = devicePixelRatioF();
+    m_atlas = QPixmap(size() * dpr);
+    m_atlas.setDevicePixelRatio(dpr);
+    m_atlas.fill(m_backgroundColor);
+
+    QPainter painter(&m_atlas);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    for (const Instrument &instrument : m_instruments) {
+        if (instrument.cellRect.width() <= 0 || instrument.cellRect.height() <= 0) {
+            continue;
+        }
+
+        if (instrument.kind == Gauge) {
+            drawGaugeFace(&painter, instrument);
+        } else {
+            drawBarFace(&painter, instrument);
+        }
+
+        painter.setPen(QPen(m_outerBorderColor, 1));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRect(instrument.cellRect.adjusted(0, 0, -1, -1));
+    }
+
+    m_atlasDirty = false;
+}
+
+void InstrumentWall::drawGaugeFace(QPainter *painter, const Instrument &instrument) const
+{
+    const QRect &face = instrument.faceRect;
+    int radius = face.width() / 2;
+    if (radius < 10) {
+        return;
+    }
+
+    painter->save();
+    painter->translate(face.center());
+
+    // 背景和外环
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(m_backgroundColor);
+    painter->drawEllipse(QPoint(0, 0), radius - 1, radius - 1);
+    painter->setBrush(Qt::NoBrush);
+    painter->setPen(QPen(m_foregroundColor, 2));
+    painter->drawEllipse(QPoint(0, 0), radius - 2, radius - 2);
+
+    // 大刻度和小刻度
+    const int minorTicks = 5;
+    int tickRadius = radius - 6;
+    for (int i = 0; i <= m_scaleMajorTicks * minorTicks; ++i) {
+        bool major = (i % minorTicks == 0);
+        double angle = m_startAngle - i * (m_totalAngleSpan / (m_scaleMajorTicks * minorTicks));
+        painter->save();
+        painter->rotate(-angle);
+        painter->setPen(QPen(m_scaleColor, major ? 2 : 1));
+        painter->drawLine(tickRadius - (major ? 6 : 3), 0, tickRadius, 0);
+        painter->restore();
+    }
+
+    // 刻度数字（表盘太小时省略）
+    if (radius >= 40) {
+        painter->setFont(m_scaleFont);
+        painter->setPen(m_textColor);
+        QFontMetrics fm = painter->fontMetrics();
+        int labelRadius = tickRadius - 6 - fm.height();
+        double range = instrument.maxValue - instrument.minValue;
+        for (int i = 0; i <= m_scaleMajorTicks; i += 2) {
+            double value = instrument.minValue + i * (range / m_scaleMajorTicks);
+            QString text = QString::number(std::round(value));
+            double angleRad = qDegreesToRadians(m_startAngle - i * (m_totalAngleSpan / m_scaleMajorTicks));
+            int x = static_cast<int>(labelRadius * qCos(angleRad) - fm.horizontalAdvance(text) / 2.0);
+            int y = static_cast<int>(-labelRadius * qSin(angleRad) + fm.ascent() / 2.0);
+            painter->drawText(x, y, text);
+        }
+    }
+
+    painter->restore();
+
+    // 信息栏左侧标签
+    painter->save();
+    QFont boldFont = m_labelFont;
+    boldFont.setBold(true);
+    painter->setFont(boldFont);
+    painter->setPen(m_textColor);
+    const QRect &cell = instrument.cellRect;
+    QRect labelRect(cell.x(), instrument.readoutRect.y(), cell.width() / 2 - 4, GAUGE_INFO_HEIGHT);
+    painter->drawText(labelRect, Qt::AlignRight | Qt::AlignVCenter,
+                      painter->fontMetrics().elidedText(instrument.label, Qt::ElideRight, labelRect.width()));
+    painter->restore();
+}
+
+void InstrumentWall::drawBarFace(QPainter *painter, const Instrument &instrument) const
+{
+    const QRect &face = instrument.faceRect;
+    int availableHeight = face.height() - 2 * BAR_MARGIN;
+    if (availableHeight <= 0) {
+        return;
+    }
+
+    painter->save();
+
+    int barWidth = qMax(4, face.width() / 5);
+    int barX = face.x() + BAR_SCALE_WIDTH + BAR_MARGIN;
+    int topY = face.y() + BAR_MARGIN;
+    int bottomY = topY + availableHeight;
+    int warningLineY = topY + static_cast<int>(availableHeight * (1.0 - m_warningThreshold));
+    int dangerLineY = topY + static_cast<int>(availableHeight * (1.0 - m_dangerThreshold));
+
+    // 危险区、警告区、正常区
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(m_dangerColor);
+    painter->drawRect(barX, topY, barWidth, dangerLineY - topY);
+    painter->setBrush(m_warningColor);
+    painter->drawRect(barX, dangerLineY, barWidth, warningLineY - dangerLineY);
+    painter->setBrush(m_normalColor);
+    painter->drawRect(barX, warningLineY, barWidth, bottomY - warningLineY);
+    painter->setPen(m_scaleColor);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawRect(barX, topY, barWidth, availableHeight);
+
+    // 刻度和刻度数字
+    int scaleLineX = face.x() + BAR_SCALE_WIDTH;
+    painter->setFont(m_scaleFont);
+    QFontMetrics fm = painter->fontMetrics();
+    bool drawLabels = availableHeight / (m_barScaleTicks - 1) >= fm.height() / 2;
+    double range = instrument.maxValue - instrument.minValue;
+    for (int i = 0; i < m_barScaleTicks; ++i) {
+        double ratio = static_cast<double>(i) / (m_barScaleTicks - 1);
+        int y = topY + static_cast<int>(availableHeight * (1.0 - ratio));
+        painter->drawLine(scaleLineX - 5, y, scaleLineX, y);
+        if (drawLabels && i % 2 == 0) {
+            QString text = QString::number(std::round(instrument.minValue + range * ratio));
+            painter->drawText(face.x() + 2, y + fm.ascent() / 2, text);
+        }
+    }
+
+    // 文字区上半部分：标签/单位
+    QString mainText = instrument.label;
+    if (!instrument.unit.isEmpty()) {
+        mainText += "/" + instrument.unit;
+    }
+    const QRect &cell = instrument.cellRect;
+    QRect labelRect(face.right() + 1, cell.y(), cell.right() - face.right(), instrument.readoutRect.y() - cell.y());
+    painter->setFont(m_labelFont);
+    painter->setPen(m_textColor);
+    painter->drawText(labelRect, Qt::AlignLeft | Qt::AlignBottom,
+                      painter->fontMetrics().elidedText(mainText, Qt::ElideRight, labelRect.width()));
+
+    painter->restore();
+}
+
+void InstrumentWall::drawDynamic(QPainter *painter, const Instrument &instrument) const
+{
+    painter->save();
+
+    if (instrument.kind == Gauge) {
+        int radius = instrument.faceRect.width() / 2;
+        if (radius >= 10) {
+            // 指针
+            painter->translate(instrument.faceRect.center());
+            painter->rotate(-instrument.drawnPosition / 2.0);
+            painter->setPen(Qt::NoPen);
+            painter->setBrush(m_pointerColor);
+            int pointerLength = radius - 10;
+            int pointerWidth = qMax(3, radius / 12);
+            QPolygon pointer;
+            pointer << QPoint(0, -pointerWidth / 2) << QPoint(pointerLength, 0) << QPoint(0, pointerWidth / 2);
+            painter->drawPolygon(pointer);
+            painter->resetTransform();
+
+            // 中心圆盘
+            painter->setBrush(m_foregroundColor);
+            painter->drawEllipse(instrument.faceRect.center(), qMax(3, radius / 10), qMax(3, radius / 10));
+        }
+    } else {
+        // 指示线
+        int barWidth = qMax(4, instrument.faceRect.width() / 5);
+        int barX = instrument.faceRect.x() + BAR_SCALE_WIDTH + BAR_MARGIN;
+        painter->setPen(QPen(m_indicatorColor, INDICATOR_HEIGHT));
+        painter->drawLine(barX - INDICATOR_OVERHANG, instrument.drawnPosition,
+                          barX + barWidth + INDICATOR_OVERHANG, instrument.drawnPosition);
+    }
+
+    // 读数
+    painter->setPen(m_textColor);
+    painter->setFont(m_valueFont);
+    Qt::Alignment alignment = instrument.kind == Gauge ? (Qt::AlignLeft | Qt::AlignVCenter)
+                                                       : (Qt::AlignLeft | Qt::AlignTop);
+    painter->drawText(instrument.readoutRect.adjusted(4, 0, 0, 0), alignment, instrument.drawnText);
+
+    painter->restore();
+}
+
+int InstrumentWall::needlePosition(const Instrument &instrument) const
+{
+    double range = instrument.maxValue - instrument.minValue;
+    double ratio = range > 0.0 ? (instrument.value - instrument.minValue) / range : 0.0;
+    ratio = std::clamp(ratio, 0.0, 1.0);
+
+    if (instrument.kind == Gauge) {
+        // 以0.5度为单位
+        return qRound((m_startAngle - ratio * m_totalAngleSpan) * 2.0);
+    }
+
+    // 指示线Y坐标
+    int availableHeight = instrument.faceRect.height() - 2 * BAR_MARGIN;
+    return instrument.faceRect.y() + BAR_MARGIN + static_cast<int>(availableHeight * (1.0 - ratio));
+}
+
+QRect InstrumentWall::needleBounds(const Instrument &instrument, int position) const
+{
+    if (instrument.kind == Gauge) {
+        int radius = instrument.faceRect.width() / 2;
+        QPoint center = instrument.faceRect.center();
+        double angleRad = qDegreesToRadians(position / 2.0);
+        int pointerLength = radius - 10;
+        QPoint tip(center.x() + qRound(pointerLength * qCos(angleRad)),
+                   center.y() - qRound(pointerLength * qSin(angleRad)));
+        int discRadius = qMax(3, radius / 10) + qMax(3, radius / 12);
+        QRect discRect(center.x() - discRadius, center.y() - discRadius, 2 * discRadius, 2 * discRadius);
+        return QRect(tip, center).normalized().adjusted(-3, -3, 3, 3).united(discRect);
+    }
+
+    int barWidth = qMax(4, instrument.faceRect.width() / 5);
+    int barX = instrument.faceRect.x() + BAR_SCALE_WIDTH + BAR_MARGIN;
+    return QRect(barX - INDICATOR_OVERHANG - 1, position - INDICATOR_HEIGHT,
+                 barWidth + 2 * INDICATOR_OVERHANG + 2, 2 * INDICATOR_HEIGHT + 1);
+}
+
+QString InstrumentWall::readoutText(const Instrument &instrument) const
+{
+    QString text = QString::number(instrument.value, 'f', instrument.precision);
+    if (!instrument.unit.isEmpty()) {
+        text += " " + instrument.unit;
+    }
+    return text;
+}
+
+void InstrumentWall::refreshDrawnState(Instrument &instrument)
+{
+    instrument.drawnPosition = needlePosition(instrument);
+    instrument.needleRect = needleBounds(instrument, instrument.drawnPosition);
+    instrument.drawnText = readoutText(instrument);
+}
@@ -0,0 +1,156 @@
+#ifndef INSTRUMENTWALL_H
+#define INSTRUMENTWALL_H
+
+#include <QWidget>
+#include <QString>
+#include <QColor>
+#include <QPixmap>
+#include <QFont>
+#include <QRect>
+#include <QVector>
+
+/**
+ * @class InstrumentWall
+ * @brief 仪表墙控件
+ *
+ * 在一个控件上按行排布多个圆形仪表和柱状仪表，一次paintEvent绘制全部仪表。
+ * 所有仪表的静态部分（表盘、刻度、标签）预先绘制到一张图集中；
+ * 数值变化时只把指针/指示线和读数所在的区域标记为脏区域，
+ * 重绘时先从图集拷贝脏区域，再绘制与之相交的仪表的动态部分。
+ */
+class InstrumentWall : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum InstrumentKind {
+        Gauge = 0,   // 圆形仪表（样式同Dashboard）
+        Bar = 1      // 柱状仪表（样式同ColumnarInstrument）
+    };
+
+    explicit InstrumentWall(QWidget *parent = nullptr);
+
+    /**
+     * @brief 添加一行
+     * @return 行号
+     */
+    int addRow();
+
+    /**
+     * @brief 在指定行末尾添加仪表
+     * @param row 行号（不存在时自动添加行）
+     * @param kind 仪表类型
+     * @param label 标签
+     * @param unit 单位
+     * @param precision 读数精度（小数位数）
+     * @param minRange 量程下限
+     * @param maxRange 量程上限
+     * @return 仪表索引
+     */
+    int addInstrument(int row, InstrumentKind kind, const QString &label, const QString &unit,
+                      int precision, double minRange, double maxRange);
+
+    /**
+     * @brief 清除所有仪表
+     */
+    void clear();
+
+    /**
+     * @brief 仪表数量
+     */
+    int instrumentCount() const;
+
+    /**
+     * @brief 行数
+     */
+    int rowCount() const;
+
+    /**
+     * @brief 设置仪表值，只在指针位置或读数文本变化时标记脏区域
+     * @param index 仪表索引
+     * @param value 值
+     */
+    void setValue(int index, double value);
+
+    /**
+     * @brief 获取仪表值
+     * @param index 仪表索引
+     * @return 值
+     */
+    double value(int index) const;
+
+    /**
+     * @brief 设置一行中最少占用的列数，使行内仪表宽度一致
+     * @param columns 列数
+     */
+    void setMinimumColumns(int columns);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    struct Instrument {
+        InstrumentKind kind;
+        QString label;
+        QString unit;
+        int precision;
+        double minValue;
+        double maxValue;
+        double value;
+        int row;
+
+        // 布局（由layoutInstruments计算）
+        QRect cellRect;       // 单元格
+        QRect faceRect;       // 表盘/柱体区域
+        QRect readoutRect;    // 读数区域
+
+        // 已绘制状态，用于判断是否需要重绘
+        int drawnPosition;    // 指针角度（0.5度为单位）或指示线Y坐标
+        QString drawnText;    // 读数文本
+        QRect needleRect;     // 当前指针/指示线的包围矩形
+    };
+
+    void layoutInstruments();
+    void updateAtlas();
+    void drawGaugeFace(QPainter *painter, const Instrument &instrument) const;
+    void drawBarFace(QPainter *painter, const Instrument &instrument) const;
+    void drawDynamic(QPainter *painter, const Instrument &instrument) const;
+
+    int needlePosition(const Instrument &instrument) const;
+    QRect needleBounds(const Instrument &instrument, int position) const;
+    QString readoutText(const Instrument &instrument) const;
+    void refreshDrawnState(Instrument &instrument);
+
+    QVector<Instrument> m_instruments;
+    QVector<QVector<int>> m_rows;      // 行 -> 仪表索引
+    int m_minimumColumns = 1;
+
+    QPixmap m_atlas;                   // 全部仪表静态部分的图集
+    bool m_atlasDirty = true;
+
+    // 样式（与Dashboard、ColumnarInstrument一致）
+    QColor m_backgroundColor = Qt::white;
+    QColor m_foregroundColor = QColor(50, 50, 50);
+    QColor m_scaleColor = Qt::black;
+    QColor m_textColor = Qt::black;
+    QColor m_pointerColor = QColor(200, 0, 0);
+    QColor m_indicatorColor = Qt::blue;
+    QColor m_warningColor = QColor(218, 165, 32);
+    QColor m_dangerColor = QColor(178, 34, 34);
+    QColor m_normalColor = Qt::white;
+    QColor m_outerBorderColor = QColor(200, 200, 200, 150);
+
+    const double m_startAngle = 225.0;       // 刻度起始角度（度）
+    const double m_totalAngleSpan = 270.0;   // 刻度总范围（度）
+    const int m_scaleMajorTicks = 10;
+    const int m_barScaleTicks = 11;
+    const double m_warningThreshold = 0.70;
+    const double m_dangerThreshold = 0.85;
+
+    QFont m_scaleFont;
+    QFont m_labelFont;
+    QFont m_valueFont;
+};
+
+#endif // INSTRUMENTWALL_H
@@ -0,0 +1,240 @@
+#include "plotdatafeeder.h"
+#include "qcustomplot.h"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+PlotDataFeeder::PlotDataFeeder()
+    : m_timeWindow(60.0)
+    , m_pixelColumns(600)
+    , m_bucketWidth(0.1)
+{
+}
+
+void PlotDataFeeder::addChannel(const QString &channelId)
+{
+    if (m_series.contains(channelId)) {
+        return;
+    }
+
+    Series series;
+    series.lastKey = -std::numeric_limits<double>::infinity();
+    m_series.insert(channelId, series);
+}
+
+void PlotDataFeeder::clear()
+{
+    for (auto it = m_series.begin(); it != m_series.end(); ++it) {
+        Series &series = it.value();
+        series.buckets.clear();
+        series.minQueue.clear();
+        series.maxQueue.clear();
+        series.lastKey = -std::numeric_limits<double>::infinity();
+    }
+}
+
+void PlotDataFeeder::setResolution(double timeWindow, int pixelColumns)
+{
+    if (timeWindow <= 0.0 || pixelColumns <= 0) {
+        return;
+    }
+
+    double bucketWidth = timeWindow / pixelColumns;
+    if (pixelColumns == m_pixelColumns && qFuzzyCompare(bucketWidth, m_bucketWidth)) {
+        return;
+    }
+
+    m_timeWindow = timeWindow;
+    m_pixelColumns = pixelColumns;
+    m_bucketWidth = bucketWidth;
+
+    // 列宽变化，把已有包络重新归并到新列宽
+    rebucket();
+}
+
+void PlotDataFeeder::append(const QString &channelId, double key, double value)
+{
+    auto it = m_series.find(channelId);
+    if (it == m_series.end()) {
+        return;
+    }
+
+    appendToSeries(it.value(), key, value);
+}
+
+void PlotDataFeeder::appendSamples(const QString &channelId, const QVector<double> &keys, const QVector<double> &values)
+{
+    auto it = m_series.find(channelId);
+    if (it == m_series.end()) {
+        return;
+    }
+
+    Series &series = it.value();
+    const int count = qMin(keys.size(), values.size());
+    for (int i = 0; i < count; ++i) {
+        appendToSeries(series, keys[i], values[i]);
+    }
+}
+
+void PlotDataFeeder::trimBefore(double windowStart)
+{
+    qint64 firstIndex = static_cast<qint64>(std::floor(windowStart / m_bucketWidth));
+
+    for (auto it = m_series.begin(); it != m_series.end(); ++it) {
+        evictFront(it.value(), firstIndex);
+    }
+}
+
+int PlotDataFeeder::feedGraph(const QString &channelId, QCPGraph *graph) const
+{
+    if (!graph) {
+        return 0;
+    }
+
+    auto it = m_series.constFind(channelId);
+    if (it == m_series.constEnd()) {
+        return 0;
+    }
+
+    const Series &series = it.value();
+
+    // 每列按时间顺序输出最小值和最大值两个点，保留波形的峰谷
+    QVector<QCPGraphData> points;
+    points.reserve(static_cast<int>(series.buckets.size()) * 2);
+
+    for (const Bucket &bucket : series.buckets) {
+        if (bucket.minKey == bucket.maxKey) {
+            points.append(QCPGraphData(bucket.minKey, bucket.minValue));
+        } else if (bucket.minKey < bucket.maxKey) {
+            points.append(QCPGraphData(bucket.minKey, bucket.minValue));
+            points.append(QCPGraphData(bucket.maxKey, bucket.maxValue));
+        } else {
+            points.append(QCPGraphData(bucket.maxKey, bucket.maxValue));
+            points.append(QCPGraphData(bucket.minKey, bucket.minValue));
+        }
+    }
+
+    // 数据已按时间排序，整体替换避免逐点插入
+    graph->data()->set(points, true);
+
+    return points.size();
+}
+
+double PlotDataFeeder::lastKey(const QString &channelId) const
+{
+    auto it = m_series.constFind(channelId);
+    if (it == m_series.constEnd()) {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    return it.value().lastKey;
+}
+
+bool PlotDataFeeder::valueRange(double &lower, double &upper) const
+{
+    bool found = false;
+
+    for (auto it = m_series.constBegin(); it != m_series.constEnd(); ++it) {
+        const Series &series = it.value();
+        if (series.minQueue.empty() || series.maxQueue.empty()) {
+            continue;
+        }
+
+        // 单调队列的队首即为窗口内的极值
+        double seriesMin = series.minQueue.front().second;
+        double seriesMax = series.maxQueue.front().second;
+
+        if (!found) {
+            lower = seriesMin;
+            upper = seriesMax;
+            found = true;
+        } else {
+            lower = qMin(lower, seriesMin);
+            upper = qMax(upper, seriesMax);
+        }
+    }
+
+    return found;
+}
+
+void PlotDataFeeder::appendToSeries(Series &series, double key, double value)
+{
+    if (!std::isfinite(key) || !std::isfinite(value)) {
+        return;
+    }
+
+    qint64 index = static_cast<qint64>(std::floor(key / m_bucketWidth));
+
+    // 乱序到达的数据并入最新一列，时间钳位到该列起点，保证输出点仍按时间排序
+    if (!series.buckets.empty() && index < series.buckets.back().index) {
+        index = series.buckets.back().index;
+        key = index * m_bucketWidth;
+    }
+
+    if (series.buckets.empty() || index > series.buckets.back().index) {
+        series.buckets.push_back(Bucket{index, key, value, key, value});
+    } else {
+        Bucket &bucket = series.buckets.back();
+        if (value < bucket.minValue) {
+            bucket.minValue = value;
+            bucket.minKey = key;
+        }
+        if (value > bucket.maxValue) {
+            bucket.maxValue = value;
+            bucket.maxKey = key;
+        }
+    }
+
+    const Bucket &bucket = series.buckets.back();
+
+    // 维护单调队列：被最新一列支配的旧极值不可能再成为窗口极值
+    while (!series.minQueue.empty() && series.minQueue.back().second >= bucket.minValue) {
+        series.minQueue.pop_back();
+    }
+    series.minQueue.push_back(qMakePair(bucket.index, bucket.minValue));
+
+    while (!series.maxQueue.empty() && series.maxQueue.back().second <= bucket.maxValue) {
+        series.maxQueue.pop_back();
+    }
+    series.maxQueue.push_back(qMakePair(bucket.index, bucket.maxValue));
+
+    series.lastKey = qMax(series.lastKey, key);
+
+    // 列数不超过一个窗口
+    evictFront(series, bucket.index - m_pixelColumns);
+}
+
+void PlotDataFeeder::evictFront(Series &series, qint64 firstIndex)
+{
+    while (!series.buckets.empty() && series.buckets.front().index < firstIndex) {
+        series.buckets.pop_front();
+    }
+    while (!series.minQueue.empty() && series.minQueue.front().first < firstIndex) {
+        series.minQueue.pop_front();
+    }
+    while (!series.maxQueue.empty() && series.maxQueue.front().first < firstIndex) {
+        series.maxQueue.pop_front();
+    }
+}
+
+void PlotDataFeeder::rebucket()
+{
+    for (auto it = m_series.begin(); it != m_series.end(); ++it) {
+        Series &series = it.value();
+        std::deque<Bucket> oldBuckets;
+        oldBuckets.swap(series.buckets);
+        series.minQueue.clear();
+        series.maxQueue.clear();
+
+        // 旧包络的极值点按时间顺序重新写入
+        for (const Bucket &bucket : oldBuckets) {
+            if (bucket.minKey <= bucket.maxKey) {
+                appendToSeries(series, bucket.minKey, bucket.minValue);
+                appendToSeries(series, bucket.maxKey, bucket.maxValue);
+            } else {
+                appendToSeries(series, bucket.maxKey, bucket.maxValue);
+                appendToSeries(series, bucket.minKey, bucket.minValue);
+            }
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef PLOTDATAFEEDER_H
+#define PLOTDATAFEEDER_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include <QPair>
+#include <deque>
+
+class QCPGraph;
+
+/**
+ * @brief 曲线数据馈送器
+ * 按像素列把每个通道可见窗口内的数据归并为最小/最大值包络后再交给QCPGraph，
+ * 每列最多输出两个点，因此绘制开销只与绘图区宽度有关，与采样率和窗口长度无关。
+ * 同时用单调队列增量维护可见窗口内的Y轴范围，避免每次刷新对所有曲线执行rescaleAxes。
+ */
+class PlotDataFeeder
+{
+public:
+    PlotDataFeeder();
+
+    /**
+     * @brief 注册通道
+     * @param channelId 通道ID
+     */
+    void addChannel(const QString &channelId);
+
+    /**
+     * @brief 清除所有通道的数据（保留通道注册）
+     */
+    void clear();
+
+    /**
+     * @brief 设置可见窗口和分辨率
+     * 列宽 = 窗口长度 / 像素列数，列宽变化时会把已有的包络重新归并到新列宽
+     * @param timeWindow 可见窗口长度（秒）
+     * @param pixelColumns 绘图区像素列数
+     */
+    void setResolution(double timeWindow, int pixelColumns);
+
+    /**
+     * @brief 追加单个数据点
+     * @param channelId 通道ID
+     * @param key 时间（秒）
+     * @param value 值
+     */
+    void append(const QString &channelId, double key, double value);
+
+    /**
+     * @brief 批量追加数据点（全速率数据）
+     * @param channelId 通道ID
+     * @param keys 时间向量（秒，按升序）
+     * @param values 值向量
+     */
+    void appendSamples(const QString &channelId, const QVector<double> &keys, const QVector<double> &values);
+
+    /**
+     * @brief 丢弃可见窗口之前的数据
+     * @param windowStart 可见窗口起始时间（秒）
+     */
+    void trimBefore(double windowStart);
+
+    /**
+     * @brief 把通道的包络数据写入曲线
+     * @param channelId 通道ID
+     * @param graph 目标曲线
+     * @return 写入的点数
+     */
+    int feedGraph(const QString &channelId, QCPGraph *graph) const;
+
+    /**
+     * @brief 获取通道最后一个数据点的时间
+     * @param channelId 通道ID
+     * @return 最后时间（秒），没有数据时返回负无穷
+     */
+    double lastKey(const QString &channelId) const;
+
+    /**
+     * @brief 获取所有通道可见窗口内的值范围
+     * @param lower 最小值（输出）
+     * @param upper 最大值（输出）
+     * @return 是否存在数据
+     */
+    bool valueRange(double &lower, double &upper) const;
+
+private:
+    // 单个像素列的包络
+    struct Bucket {
+        qint64 index;       // 列序号 = floor(key / 列宽)
+        double minKey;      // 最小值所在时间
+        double minValue;    // 最小值
+        double maxKey;      // 最大值所在时间
+        double maxValue;    // 最大值
+    };
+
+    struct Series {
+        std::deque<Bucket> buckets;                    // 按时间排序的列包络
+        std::deque<QPair<qint64, double>> minQueue;    // 单调递增队列（列序号, 最小值）
+        std::deque<QPair<qint64, double>> maxQueue;    // 单调递减队列（列序号, 最大值）
+        double lastKey;                                // 最后一个数据点的时间
+    };
+
+    void appendToSeries(Series &series, double key, double value);
+    void evictFront(Series &series, qint64 firstIndex);
+    void rebucket();
+
+    QMap<QString, Series> m_series;   // 通道ID -> 包络序列
+    double m_timeWindow;              // 可见窗口长度（秒）
+    int m_pixelColumns;               // 像素列数
+    double m_bucketWidth;             // 列宽（秒）
+};
+
+#endif // PLOTDATAFEEDER_H